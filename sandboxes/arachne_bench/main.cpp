@@ -0,0 +1,111 @@
+// Benchmark of the Arachne perimeter generator.
+// Usage: arachne_bench [mesh.obj] [number_of_runs]  (default: tests/data/frog_legs.obj, 20 runs)
+// It generates the perimeters of the kind of shapes tested in tests/libslic3r/test_arachne.cpp (sharp corners,
+// a wedge with all the transitions of the bead count, a gear, a thin ring) and of the islands of the mesh sliced
+// every millimeter, the way PerimeterGenerator::process_arachne() does with WallToolPaths.
+// It prints the time and the number of heap allocations per run of each case. Run it built before and after
+// a change of the Arachne data structures to compare them.
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <libslic3r/Arachne/WallToolPaths.hpp>
+#include <libslic3r/ExPolygon.hpp>
+#include <libslic3r/Format/OBJ.hpp>
+#include <libslic3r/PrintConfig.hpp>
+#include <libslic3r/TriangleMesh.hpp>
+#include <libslic3r/TriangleMeshSlicer.hpp>
+
+#include "BenchCommon.hpp"
+
+using namespace Slic3r;
+
+static constexpr coord_t SPACING     = coord_t(0.45 / SCALING_FACTOR);
+static constexpr coord_t INSET_COUNT = 3;
+
+static Polygon make_circle(double radius, size_t num_points, bool ccw = true)
+{
+    Polygon out;
+    for (size_t i = 0; i < num_points; ++ i) {
+        double angle = 2. * M_PI * double(i) / double(num_points);
+        out.points.emplace_back(scaled<coord_t>(radius * cos(angle)), scaled<coord_t>(radius * sin(angle)));
+    }
+    if (! ccw)
+        out.reverse();
+    return out;
+}
+
+static Polygon make_gear(double radius, double tooth_height, size_t num_teeth)
+{
+    Polygon out;
+    for (size_t i = 0; i < num_teeth * 4; ++ i) {
+        double angle = 2. * M_PI * double(i) / double(num_teeth * 4);
+        double r     = (i % 4) < 2 ? radius : radius - tooth_height;
+        out.points.emplace_back(scaled<coord_t>(r * cos(angle)), scaled<coord_t>(r * sin(angle)));
+    }
+    return out;
+}
+
+// Returns the number of lines generated.
+static size_t generate(const std::vector<Polygons> &islands, const PrintObjectConfig &object_config, const PrintConfig &print_config)
+{
+    size_t num_lines = 0;
+    for (const Polygons &island : islands) {
+        Arachne::WallToolPaths wall_tool_paths(island, SPACING, SPACING, SPACING, SPACING, INSET_COUNT, 0, 0.2, object_config, print_config);
+        wall_tool_paths.generate();
+        for (const Arachne::VariableWidthLines &lines : wall_tool_paths.getToolPaths())
+            num_lines += lines.size();
+    }
+    return num_lines;
+}
+
+static void measure(const char *name, const std::vector<Polygons> &islands, size_t nb_runs)
+{
+    const PrintObjectConfig object_config = PrintObjectConfig::defaults();
+    const PrintConfig       print_config  = PrintConfig::defaults();
+    size_t num_lines = 0;
+    Bench::Measurement measurement = Bench::measure([&]() {
+        for (size_t i = 0; i < nb_runs; ++ i)
+            num_lines = generate(islands, object_config, print_config);
+    });
+    Bench::report(name, measurement, nb_runs, "run", (std::to_string(islands.size()) + " islands, " + std::to_string(num_lines) + " lines").c_str());
+}
+
+int main(int argc, char **argv)
+{
+    std::string path    = std::string(TEST_DATA_DIR) + "/frog_legs.obj";
+    size_t      nb_runs = 20;
+    if (argc > 1)
+        path = argv[1];
+    if (argc > 2)
+        nb_runs = size_t(std::atoll(argv[2]));
+
+    TriangleMesh mesh;
+    if (! load_obj(path.c_str(), &mesh) || mesh.empty() || nb_runs == 0) {
+        std::cerr << "Usage: arachne_bench [mesh.obj] [number_of_runs]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The closed ExtrusionLine case of test_arachne.cpp.
+    measure("corners", { { Polygon{ { -40000000, 10000000 }, { -62480000, 10000000 }, { -62480000, -7410000 }, { -58430000, -7330000 },
+                                    { -58400000, -5420000 }, { -58720000, -4710000 }, { -58940000, -3870000 }, { -59020000, -3000000 } } } }, nb_runs);
+    // From a single thin bead to more beads than the inset count.
+    measure("wedge", { { Polygon{ { 0, 0 }, { scaled<coord_t>(40.), - scaled<coord_t>(3.) }, { scaled<coord_t>(40.), scaled<coord_t>(3.) } } } }, nb_runs);
+    measure("gear", { { make_gear(20., 1.5, 60), make_circle(5., 90, false) } }, nb_runs);
+    measure("ring", { { make_circle(20., 360), make_circle(19.3, 360, false) } }, nb_runs);
+
+    // The islands of the mesh sliced every millimeter.
+    const BoundingBoxf3 bbox = mesh.bounding_box();
+    std::vector<float>  zs;
+    for (double z = bbox.min.z() + 0.5; z < bbox.max.z(); z += 1.)
+        zs.emplace_back(float(z));
+    std::vector<Polygons> islands;
+    for (const ExPolygons &layer : slice_mesh_ex(mesh.its, zs))
+        for (const ExPolygon &expoly : layer)
+            islands.emplace_back(to_polygons(expoly));
+    measure("slices", islands, std::max<size_t>(1, nb_runs / 10));
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,46 @@
+#include "BenchCommon.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+static std::atomic<size_t> s_allocations { 0 };
+
+void* operator new(size_t size)
+{
+    ++ s_allocations;
+    if (void *ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+
+namespace Slic3r {
+namespace Bench {
+
+size_t num_allocations()
+{
+    return s_allocations;
+}
+
+double us_per(const Measurement &measurement, size_t num_units)
+{
+    return double(std::chrono::duration_cast<std::chrono::nanoseconds>(measurement.duration).count()) / (1000. * double(num_units));
+}
+
+void report(const char *name, const Measurement &measurement, size_t num_units, const char *unit, const char *extra)
+{
+    std::cout << std::setw(32) << std::left << name
+              << std::setw(12) << std::right << std::fixed << std::setprecision(3) << us_per(measurement, num_units) << " us/" << unit
+              << std::setw(12) << std::setprecision(1) << double(measurement.allocations) / double(num_units) << " allocations/" << unit;
+    if (extra)
+        std::cout << "   " << extra;
+    std::cout << std::endl;
+}
+
+} // namespace Bench
+} // namespace Slic3r
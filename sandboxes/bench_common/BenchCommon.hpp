@@ -0,0 +1,42 @@
+#ifndef slic3r_BenchCommon_hpp_
+#define slic3r_BenchCommon_hpp_
+
+// Scaffold shared by the benchmarks of the sandboxes: a counter of the heap allocations and a timer.
+// Linking bench_common replaces the global operator new of the benchmark to count its calls.
+
+#include <chrono>
+#include <cstddef>
+
+namespace Slic3r {
+namespace Bench {
+
+// Number of calls to the global operator new since the start of the program, by all the threads.
+size_t num_allocations();
+
+struct Measurement
+{
+    std::chrono::steady_clock::duration duration;
+    size_t                              allocations;
+};
+
+// Time fn() and count the heap allocations it made.
+template<typename Fn>
+Measurement measure(Fn &&fn)
+{
+    size_t allocations = num_allocations();
+    auto   start       = std::chrono::steady_clock::now();
+    fn();
+    return { std::chrono::steady_clock::now() - start, num_allocations() - allocations };
+}
+
+// Time per unit of the measurement in microseconds.
+double us_per(const Measurement &measurement, size_t num_units);
+
+// Print a line with the name of the case, the time and the number of heap allocations per unit of work,
+// for example report("offset_ex", measurement, nb_runs, "op"). Extra is printed at the end of the line.
+void report(const char *name, const Measurement &measurement, size_t num_units, const char *unit, const char *extra = nullptr);
+
+} // namespace Bench
+} // namespace Slic3r
+
+#endif // slic3r_BenchCommon_hpp_
@@ -0,0 +1,89 @@
+// Benchmark of the ClipperUtils wrappers on the kind of inputs of tests/libslic3r/test_clipper_utils.cpp.
+// Usage: clipper_utils_bench [number_of_runs]  (default: 20000 runs)
+// Each case runs the same small boolean operations and offsets many times, as the layer processing does with the
+// islands of a layer, first on one thread and then on all the threads. It prints the time and the number of heap
+// allocations per operation. Run it built before and after a change of ClipperUtils or of the Clipper library.
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <tbb/parallel_for.h>
+
+#include <libslic3r/ClipperUtils.hpp>
+#include <libslic3r/ExPolygon.hpp>
+
+#include "BenchCommon.hpp"
+
+using namespace Slic3r;
+
+static Polygon make_circle(const Point &center, double radius, size_t num_points, bool ccw = true)
+{
+    Polygon out;
+    for (size_t i = 0; i < num_points; ++ i) {
+        double angle = 2. * M_PI * double(i) / double(num_points);
+        out.points.emplace_back(center + Point(scaled<coord_t>(radius * cos(angle)), scaled<coord_t>(radius * sin(angle))));
+    }
+    if (! ccw)
+        out.reverse();
+    return out;
+}
+
+// Returns the number of output polygons, so that the operations are not optimized out.
+using Operation = std::function<size_t(size_t)>;
+
+static void measure(const char *name, const Operation &operation, size_t nb_runs)
+{
+    std::atomic<size_t> num_polygons { 0 };
+    Bench::report((std::string(name) + ", 1 thread").c_str(), Bench::measure([&operation, &num_polygons, nb_runs]() {
+        for (size_t i = 0; i < nb_runs; ++ i)
+            num_polygons += operation(i);
+    }), nb_runs, "op");
+    Bench::report((std::string(name) + ", all threads").c_str(), Bench::measure([&operation, &num_polygons, nb_runs]() {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, nb_runs), [&operation, &num_polygons](const tbb::blocked_range<size_t> &range) {
+            size_t n = 0;
+            for (size_t i = range.begin(); i < range.end(); ++ i)
+                n += operation(i);
+            num_polygons += n;
+        });
+    }), nb_runs, "op");
+    if (num_polygons == 0)
+        std::cerr << name << ": empty result" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    size_t nb_runs = 20000;
+    if (argc > 1)
+        nb_runs = size_t(std::atoll(argv[1]));
+    if (nb_runs == 0) {
+        std::cerr << "Usage: clipper_utils_bench [number_of_runs]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The inputs of the "Various Clipper operations" scenario.
+    const Polygon   square { { 200, 100 }, { 200, 200 }, { 100, 200 }, { 100, 100 } };
+    const Polygon   hole_in_square { { 160, 140 }, { 140, 140 }, { 140, 160 }, { 160, 160 } };
+    const ExPolygon square_with_hole(square, hole_in_square);
+    const Polylines polylines { { { 50, 150 }, { 300, 150 } }, { { 150, 50 }, { 150, 300 } } };
+    // A small island with a hole and the islands overlapping it, as the perimeters and the infill of a layer.
+    const ExPolygon island(make_circle(Point(0, 0), 10., 120), make_circle(Point(0, 0), 3., 60, false));
+    Polygons        islands;
+    for (size_t i = 0; i < 8; ++ i)
+        islands.emplace_back(make_circle(Point(scaled<coord_t>(12. * cos(M_PI * i / 4.)), scaled<coord_t>(12. * sin(M_PI * i / 4.))), 5., 60));
+
+    measure("offset",          [&](size_t) { return offset(square_with_hole, 5.f).size(); }, nb_runs);
+    measure("offset_ex",       [&](size_t) { return offset_ex(square_with_hole, 5.f).size(); }, nb_runs);
+    measure("offset2_ex",      [&](size_t) { return offset2_ex({ square_with_hole }, 5.f, -2.f).size(); }, nb_runs);
+    measure("diff_pl",         [&](size_t) { return diff_pl(polylines, Polygons{ square, hole_in_square }).size(); }, nb_runs);
+    measure("intersection_pl", [&](size_t) { return intersection_pl(polylines, Polygons{ square, hole_in_square }).size(); }, nb_runs);
+    measure("island offset",   [&](size_t i) { return offset_ex(island, - scaled<float>(0.1 + 0.01 * (i % 16))).size(); }, nb_runs);
+    measure("island union_ex", [&](size_t) { return union_ex(islands).size(); }, nb_runs);
+    measure("island diff_ex",  [&](size_t) { return diff_ex(island, islands).size(); }, nb_runs);
+    measure("island opening",  [&](size_t) { return opening_ex(ExPolygons{ island }, scaled<float>(0.2)).size(); }, nb_runs);
+    return EXIT_SUCCESS;
+}
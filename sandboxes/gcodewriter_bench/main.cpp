@@ -0,0 +1,132 @@
+// Micro-benchmark of the GCodeWriter emission path.
+// Usage: gcodewriter_bench [number_of_moves]  (default: 10M)
+// It emits the same sequence of extrusion & travel moves three times:
+//  - with a std::ostringstream per line, the way the writer formatted its lines before,
+//  - with the GCodeWriter methods returning a new std::string per line,
+//  - with the GCodeWriter methods appending to a reused buffer,
+// and prints the time and the number of heap allocations per move for each of them.
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <libslic3r/GCodeWriter.hpp>
+#include <libslic3r/LocalesUtils.hpp>
+#include <libslic3r/PrintConfig.hpp>
+
+#include "BenchCommon.hpp"
+
+using namespace Slic3r;
+
+// Flush the buffer to nowhere once it is that big, as GCode does with each layer.
+static constexpr size_t FLUSH_SIZE = 1 << 16;
+
+static Vec2d move_point(size_t idx)
+{
+    // zig-zag on a 200mm bed, so that no move is skipped as a duplicate point.
+    return Vec2d(10. + double(idx % 1900) * 0.1, 10. + double((idx / 1900) % 1900) * 0.1 + (idx % 2) * 0.05);
+}
+
+static void init_writer(GCodeWriter &writer)
+{
+    PrintConfig print_config;
+    writer.apply_print_config(print_config);
+    writer.set_extruders({ 0 });
+    writer.toolchange(0);
+}
+
+template<typename Fn>
+static double measure(const char *name, size_t nb_moves, Fn fn)
+{
+    size_t             total_size  = 0;
+    Bench::Measurement measurement = Bench::measure([&fn, &total_size]() { total_size = fn(); });
+    Bench::report(name, measurement, nb_moves, "move", ("(" + std::to_string(total_size) + " bytes)").c_str());
+    return Bench::us_per(measurement, nb_moves);
+}
+
+int main(int argc, char **argv)
+{
+    size_t nb_moves = 10000000;
+    if (argc > 1)
+        nb_moves = size_t(std::atoll(argv[1]));
+    if (nb_moves == 0) {
+        std::cerr << "Usage: gcodewriter_bench [number_of_moves]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    CNumericLocalesSetter locales_setter;
+    const std::string comment = "perimeter";
+
+    double us_before = measure("ostringstream per line", nb_moves, [&]() {
+        GCodeWriter writer;
+        init_writer(writer);
+        const int   precision_xyz = writer.config.gcode_precision_xyz.value;
+        const int   precision_e   = writer.config.gcode_precision_e.value;
+        const bool  comments      = writer.config.gcode_comments.value;
+        std::string gcode;
+        size_t      total_size = 0;
+        double      e          = 0;
+        for (size_t i = 0; i < nb_moves; ++i) {
+            Vec2d              pt = move_point(i);
+            std::ostringstream line;
+            line << "G1 X" << to_string_nozero(pt.x(), precision_xyz) << " Y" << to_string_nozero(pt.y(), precision_xyz);
+            if (i % 4 == 0) {
+                line << " F" << std::defaultfloat << std::setprecision(8) << 150. * 60;
+            } else {
+                e += 0.01;
+                line << " E" << to_string_nozero(e, precision_e);
+                if (comments)
+                    line << " ; " << comment;
+            }
+            line << "\n";
+            gcode += line.str();
+            if (gcode.size() > FLUSH_SIZE) {
+                total_size += gcode.size();
+                gcode.clear();
+            }
+        }
+        return total_size + gcode.size();
+    });
+
+    measure("GCodeWriter, string per line", nb_moves, [&]() {
+        GCodeWriter writer;
+        init_writer(writer);
+        std::string gcode;
+        size_t      total_size = 0;
+        for (size_t i = 0; i < nb_moves; ++i) {
+            if (i % 4 == 0)
+                gcode += writer.travel_to_xy(move_point(i), 150.);
+            else
+                gcode += writer.extrude_to_xy(move_point(i), 0.01, comment);
+            if (gcode.size() > FLUSH_SIZE) {
+                total_size += gcode.size();
+                gcode.clear();
+            }
+        }
+        return total_size + gcode.size();
+    });
+
+    double us_after = measure("GCodeWriter, appended", nb_moves, [&]() {
+        GCodeWriter writer;
+        init_writer(writer);
+        std::string gcode;
+        gcode.reserve(FLUSH_SIZE * 2);
+        size_t      total_size = 0;
+        for (size_t i = 0; i < nb_moves; ++i) {
+            if (i % 4 == 0)
+                writer.travel_to_xy(gcode, move_point(i), 150.);
+            else
+                writer.extrude_to_xy(gcode, move_point(i), 0.01, comment);
+            if (gcode.size() > FLUSH_SIZE) {
+                total_size += gcode.size();
+                gcode.clear();
+            }
+        }
+        return total_size + gcode.size();
+    });
+
+    std::cout << "speedup: " << std::setprecision(2) << us_before / us_after << "x" << std::endl;
+    return EXIT_SUCCESS;
+}
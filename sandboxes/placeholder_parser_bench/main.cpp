@@ -0,0 +1,101 @@
+// Micro-benchmark of the PlaceholderParser.
+// Usage: placeholder_parser_bench [number_of_evaluations]  (default: 100k)
+// It fills in a set of custom G-code templates alike the ones of test_placeholder_parser.cpp:
+//  - parsed as a whole by the full grammar for each evaluation, the way they were before they were compiled.
+//    A template containing a string literal is not split, thus an empty {""} macro is appended to each template,
+//  - compiled once into literal text, legacy variables, variable references and macros,
+// and prints the time and the number of heap allocations per evaluation for both.
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <libslic3r/LocalesUtils.hpp>
+#include <libslic3r/PlaceholderParser.hpp>
+#include <libslic3r/PrintConfig.hpp>
+
+#include "BenchCommon.hpp"
+
+using namespace Slic3r;
+
+static const std::vector<std::string> s_templates {
+    // start G-code
+    "M115 U3.1.0 ; tell printer latest fw version\n"
+    "M201 X1000 Y1000 Z200 E5000 ; sets maximum accelerations, mm/sec^2\n"
+    "M203 X200 Y200 Z12 E120 ; sets maximum feedrates, mm/sec\n"
+    "G28 W ; home all without mesh bed level\n"
+    "G80 ; mesh bed leveling\n"
+    "M104 S[first_layer_temperature] ; set extruder temp\n"
+    "M140 S[first_layer_bed_temperature] ; set bed temp\n"
+    "M190 S[first_layer_bed_temperature] ; wait for bed temp\n"
+    "M109 S[first_layer_temperature] ; wait for extruder temp\n"
+    "G1 Y-3.0 F1000.0 ; go outside print area\n"
+    "G92 E0.0\n",
+    // layer change G-code
+    ";AFTER_LAYER_CHANGE\n;{layer_z}\n{if layer_num == 1}M106 S{int(255 * bar / 4)}{else}M106 S255{endif}\n",
+    // tool change G-code
+    "; tool change [previous_extruder] -> [next_extruder]\nM104 S{temperature[next_extruder]} T[next_extruder]\n"
+    "G1 E-{retract_length[previous_extruder]} F{retract_speed[previous_extruder] * 60}\n",
+    // end G-code
+    "{if max_layer_z < 180}G1 Z{max_layer_z + 20} F720 ; Move print head up{endif}\n"
+    "G1 X0 Y200 F3600 ; park\n"
+    "M104 S0 ; turn off temperature\n"
+    "M140 S0 ; turn off heatbed\n"
+    "M107 ; turn off fan\n"
+    "M84 ; disable motors\n"
+};
+
+int main(int argc, char **argv)
+{
+    size_t nb_evaluations = 100000;
+    if (argc > 1)
+        nb_evaluations = size_t(std::atoll(argv[1]));
+    if (nb_evaluations == 0) {
+        std::cerr << "Usage: placeholder_parser_bench [number_of_evaluations]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    CNumericLocalesSetter locales_setter;
+
+    PlaceholderParser parser;
+    auto              config = DynamicPrintConfig::full_print_config();
+    config.set_deserialize_strict({
+        { "nozzle_diameter", "0.6;0.6;0.6;0.6" },
+        { "temperature", "357;359;363;378" },
+        { "retract_length", "0.8;0.8;0.8;0.8" },
+        { "retract_speed", "35;35;35;35" }
+    });
+    parser.apply_config(config);
+    parser.set("bar", 2);
+    parser.set("layer_num", 1);
+    parser.set("layer_z", 0.2);
+    parser.set("max_layer_z", 20.);
+    parser.set("previous_extruder", 0);
+    parser.set("next_extruder", 1);
+
+    std::vector<std::shared_ptr<const PlaceholderParser::CompiledTemplate>> parsed, compiled;
+    for (const std::string &templ : s_templates) {
+        parsed.emplace_back(PlaceholderParser::compile(templ + "{\"\"}"));
+        compiled.emplace_back(PlaceholderParser::compile(templ));
+        if (parser.process(*parsed.back()) != parser.process(*compiled.back())) {
+            std::cerr << "Compiled template produces a different output:" << std::endl << templ << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    auto run = [&parser, nb_evaluations](const std::vector<std::shared_ptr<const PlaceholderParser::CompiledTemplate>> &templates) {
+        size_t total_size = 0;
+        for (size_t i = 0; i < nb_evaluations; ++ i)
+            total_size += parser.process(*templates[i % templates.size()], unsigned(i % 4)).size();
+        return total_size;
+    };
+    Bench::Measurement m_parsed   = Bench::measure([&]() { run(parsed); });
+    Bench::Measurement m_compiled = Bench::measure([&]() { run(compiled); });
+    Bench::report("parsed with each evaluation", m_parsed, nb_evaluations, "evaluation");
+    Bench::report("compiled once", m_compiled, nb_evaluations, "evaluation");
+    std::cout << "speedup: " << std::fixed << std::setprecision(2) << Bench::us_per(m_parsed, nb_evaluations) / Bench::us_per(m_compiled, nb_evaluations) << "x" << std::endl;
+    return EXIT_SUCCESS;
+}
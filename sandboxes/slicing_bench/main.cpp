@@ -0,0 +1,73 @@
+// Benchmark of slicing a large mesh into many layers with slice_mesh().
+// Usage: slicing_bench [mesh.obj] [number_of_facets] [layer_height]  (default: tests/data/frog_legs.obj, 2M facets, 0.05 mm)
+// The mesh is copied on a grid in the XY plane until it has at least the requested number of facets,
+// thus all the copies are sliced by the same layers, then it is sliced a few times and the time and the number of heap allocations
+// per slicing are printed.
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <libslic3r/TriangleMesh.hpp>
+#include <libslic3r/TriangleMeshSlicer.hpp>
+#include <libslic3r/Format/OBJ.hpp>
+
+#include "BenchCommon.hpp"
+
+using namespace Slic3r;
+
+int main(int argc, char **argv)
+{
+    std::string path         = std::string(TEST_DATA_DIR) + "/frog_legs.obj";
+    size_t      nb_facets    = 2000000;
+    float       layer_height = 0.05f;
+    if (argc > 1)
+        path = argv[1];
+    if (argc > 2)
+        nb_facets = size_t(std::atoll(argv[2]));
+    if (argc > 3)
+        layer_height = float(std::atof(argv[3]));
+
+    TriangleMesh mesh;
+    if (! load_obj(path.c_str(), &mesh) || mesh.empty() || layer_height <= 0.f) {
+        std::cerr << "Usage: slicing_bench [mesh.obj] [number_of_facets] [layer_height]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Copy the mesh on a grid until it has the requested number of facets.
+    const indexed_triangle_set &its    = mesh.its;
+    const BoundingBoxf3         bbox   = mesh.bounding_box();
+    const Vec3d                 size   = bbox.size();
+    const size_t                copies = std::max<size_t>(1, (nb_facets + its.indices.size() - 1) / its.indices.size());
+    const size_t                cols   = size_t(std::ceil(std::sqrt(double(copies))));
+    indexed_triangle_set        big;
+    big.indices.reserve(copies * its.indices.size());
+    big.vertices.reserve(copies * its.vertices.size());
+    for (size_t i = 0; i < copies; ++ i) {
+        indexed_triangle_set copy = its;
+        Vec3f offset(float((i % cols) * (size.x() + 1.) - bbox.min.x()), float((i / cols) * (size.y() + 1.) - bbox.min.y()), float(- bbox.min.z()));
+        for (Vec3f &v : copy.vertices)
+            v += offset;
+        its_merge(big, copy);
+    }
+
+    std::vector<float> zs;
+    for (float z = 0.5f * layer_height; z < float(size.z()); z += layer_height)
+        zs.emplace_back(z);
+    std::cout << "Slicing " << big.indices.size() << " facets (" << copies << " copies of " << path << ") into " << zs.size() << " layers" << std::endl;
+
+    const size_t       nb_runs     = 5;
+    size_t             nb_polygons = 0;
+    Bench::Measurement measurement = Bench::measure([&]() {
+        for (size_t i = 0; i < nb_runs; ++ i) {
+            std::vector<Polygons> layers = slice_mesh(big, zs, MeshSlicingParams());
+            nb_polygons = 0;
+            for (const Polygons &layer : layers)
+                nb_polygons += layer.size();
+        }
+    });
+    Bench::report("slice_mesh", measurement, nb_runs, "slicing", (std::to_string(nb_polygons) + " polygons").c_str());
+    return EXIT_SUCCESS;
+}
@@ -19,6 +19,7 @@
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/log/trivial.hpp>
 #include <boost/nowide/args.hpp>
 #include <boost/nowide/cenv.hpp>
 #include <boost/nowide/iostream.hpp>
@@ -30,6 +31,7 @@
 #include "libslic3r/libslic3r.h"
 #include "libslic3r/Config.hpp"
 #include "libslic3r/Geometry.hpp"
+#include "libslic3r/GCode/GCodeCache.hpp"
 #include "libslic3r/GCode/PostProcessor.hpp"
 #include "libslic3r/Model.hpp"
 #include "libslic3r/ModelArrange.hpp"
@@ -531,6 +533,7 @@ int CLI::run(int argc, char **argv)
                 if (printer_technology == ptFFF) {
                     for (auto* mo : model.objects)
                         fff_print.auto_assign_extruders(mo);
+                    fff_print.set_low_memory(m_config.opt_bool("low_memory"));
                 }
                 print->apply(model, m_print_config);
                 std::pair<PrintBase::PrintValidationError, std::string> err = print->validate();
@@ -542,28 +545,42 @@ int CLI::run(int argc, char **argv)
                     boost::nowide::cout << "Nothing to print for " << outfile << " . Either the print is empty or no object is fully inside the print volume." << std::endl;
                 else
                     try {
-                        std::string outfile_final;
-                        print->process();
-                        if (printer_technology == ptFFF) {
-                            // The outfile is processed by a PlaceholderParser.
-                            outfile = fff_print.export_gcode(outfile, nullptr, nullptr);
-                            outfile_final = fff_print.print_statistics().finalize_output_path(outfile);
-                        } else if (printer_technology == ptSLA) {
-                            outfile = sla_print.output_filepath(outfile);
-                            // We need to finalize the filename beforehand because the export function sets the filename inside the zip metadata
-                            outfile_final = sla_print.print_statistics().finalize_output_path(outfile);
-                            sla_archive->export_print(outfile_final, sla_print);
-                        }
-                        if (outfile != outfile_final) {
-                            if (Slic3r::rename_file(outfile, outfile_final)) {
-                                boost::nowide::cerr << "Renaming file " << outfile << " to " << outfile_final << " failed" << std::endl;
-                                return 1;
+                        const std::string gcode_cache_dir = m_config.opt_string("gcode_cache");
+                        const std::string gcode_cache_key = printer_technology == ptFFF && ! gcode_cache_dir.empty() ?
+                            Slic3r::gcode_cache_key(model, fff_print.full_print_config(), outfile) : std::string();
+                        if (std::string outfile_cached = gcode_cache_key.empty() ? std::string() : gcode_cache_load(gcode_cache_dir, gcode_cache_key);
+                            ! outfile_cached.empty()) {
+                            BOOST_LOG_TRIVIAL(info) << "G-code " << outfile_cached << " found in the cache " << gcode_cache_dir;
+                            outfile = outfile_cached;
+                        } else {
+                            std::string outfile_final;
+                            print->process();
+                            if (printer_technology == ptFFF) {
+                                // The outfile is processed by a PlaceholderParser.
+                                outfile = fff_print.export_gcode(outfile, nullptr, nullptr);
+                                outfile_final = fff_print.print_statistics().finalize_output_path(outfile);
+                            } else if (printer_technology == ptSLA) {
+                                outfile = sla_print.output_filepath(outfile);
+                                // We need to finalize the filename beforehand because the export function sets the filename inside the zip metadata
+                                outfile_final = sla_print.print_statistics().finalize_output_path(outfile);
+                                sla_archive->export_print(outfile_final, sla_print);
+                            }
+                            if (outfile != outfile_final) {
+                                if (Slic3r::rename_file(outfile, outfile_final)) {
+                                    boost::nowide::cerr << "Renaming file " << outfile << " to " << outfile_final << " failed" << std::endl;
+                                    return 1;
+                                }
+                                outfile = outfile_final;
                             }
-                            outfile = outfile_final;
+                            // Cache the G-code before it is modified by the post-processing scripts, which run on a cached G-code as well.
+                            if (! gcode_cache_key.empty())
+                                gcode_cache_store(gcode_cache_dir, gcode_cache_key, outfile);
                         }
                         // Run the post-processing scripts if defined.
                         run_post_process_scripts(outfile, fff_print.full_print_config());
                         boost::nowide::cout << "Slicing result exported to " << outfile << std::endl;
+                        if (m_config.opt_bool("low_memory"))
+                            boost::nowide::cout << "Memory usage:" << log_memory_info(true) << std::endl;
                     } catch (const std::exception &ex) {
                         boost::nowide::cerr << ex.what() << std::endl;
                         return 1;
@@ -174,9 +174,21 @@ void PolyTree::RemoveOutermostPolygon()
 // Miscellaneous global functions
 //------------------------------------------------------------------------------
 
-double Area(const Path &poly)
+void FlatPaths::erase_front()
 {
-  int size = (int)poly.size();
+  if (ends.empty())
+    return;
+  uint32_t shift = ends.front();
+  points.erase(points.begin(), points.begin() + shift);
+  ends.erase(ends.begin());
+  for (uint32_t &end : ends)
+    end -= shift;
+}
+//------------------------------------------------------------------------------
+
+double Area(const IntPoint *poly, size_t num_points)
+{
+  int size = (int)num_points;
   if (size < 3) return 0;
 
   double a = 0;
@@ -776,12 +788,12 @@ TEdge* ClipperBase::ProcessBound(TEdge* E, bool NextIsForward)
 }
 //------------------------------------------------------------------------------
 
-bool ClipperBase::AddPath(const Path &pg, PolyType PolyTyp, bool Closed)
+bool ClipperBase::AddPath(const IntPoint *pg, size_t size, PolyType PolyTyp, bool Closed)
 {
   CLIPPERLIB_PROFILE_FUNC();
   // Remove duplicate end point from a closed input path.
   // Remove duplicate points from the end of the input path.
-  int highI = (int)pg.size() -1;
+  int highI = (int)size -1;
   if (Closed) 
     while (highI > 0 && (pg[highI] == pg[0])) 
       --highI;
@@ -790,8 +802,8 @@ bool ClipperBase::AddPath(const Path &pg, PolyType PolyTyp, bool Closed)
   if ((Closed && highI < 2) || (!Closed && highI < 1))
     return false;
 
-  // Allocate a new edge array.
-  std::vector<TEdge> edges(highI + 1);
+  // Allocate a new edge array or recycle one released by Clear().
+  std::vector<TEdge> edges = AllocateEdges(highI + 1);
   // Fill in the edge array.
   bool result = AddPathInternal(pg, highI, PolyTyp, Closed, edges.data());
   if (result)
@@ -800,7 +812,7 @@ bool ClipperBase::AddPath(const Path &pg, PolyType PolyTyp, bool Closed)
   return result;
 }
 
-bool ClipperBase::AddPathInternal(const Path &pg, int highI, PolyType PolyTyp, bool Closed, TEdge* edges)
+bool ClipperBase::AddPathInternal(const IntPoint *pg, int highI, PolyType PolyTyp, bool Closed, TEdge* edges)
 {
   CLIPPERLIB_PROFILE_FUNC();
 #ifdef use_lines
@@ -811,7 +823,7 @@ bool ClipperBase::AddPathInternal(const Path &pg, int highI, PolyType PolyTyp, b
     throw clipperException("AddPath: Open paths have been disabled.");
 #endif
 
-  assert(highI >= 0 && highI < pg.size());
+  assert(highI >= 0);
 
   //1. Basic (first) edge initialization ...
   try
@@ -982,6 +994,8 @@ void ClipperBase::Clear()
 {
   CLIPPERLIB_PROFILE_FUNC();
   m_MinimaList.clear();
+  for (std::vector<TEdge> &edges : m_edges)
+    m_edges_free.emplace_back(std::move(edges));
   m_edges.clear();
 #ifndef CLIPPERLIB_INT32
   m_UseFullRange = false;
@@ -990,6 +1004,38 @@ void ClipperBase::Clear()
 }
 //------------------------------------------------------------------------------
 
+void ClipperBase::ReleaseMemory()
+{
+  Clear();
+  std::vector<std::vector<TEdge>>().swap(m_edges_free);
+  std::vector<LocalMinimum>().swap(m_MinimaList);
+  std::vector<int>().swap(m_num_edges);
+}
+//------------------------------------------------------------------------------
+
+size_t ClipperBase::KeptMemory() const
+{
+  size_t out = m_MinimaList.capacity() * sizeof(LocalMinimum) + m_num_edges.capacity() * sizeof(int);
+  for (const std::vector<TEdge> &edges : m_edges)
+    out += edges.capacity() * sizeof(TEdge);
+  for (const std::vector<TEdge> &edges : m_edges_free)
+    out += edges.capacity() * sizeof(TEdge);
+  return out;
+}
+//------------------------------------------------------------------------------
+
+std::vector<TEdge> ClipperBase::AllocateEdges(size_t num_edges)
+{
+  if (m_edges_free.empty())
+    return std::vector<TEdge>(num_edges);
+  std::vector<TEdge> edges = std::move(m_edges_free.back());
+  m_edges_free.pop_back();
+  edges.clear();
+  edges.resize(num_edges);
+  return edges;
+}
+//------------------------------------------------------------------------------
+
 // Initialize the Local Minima List:
 // Sort the LML entries, initialize the left / right bound edges of each Local Minima.
 void ClipperBase::Reset()
@@ -1066,6 +1112,7 @@ IntRect ClipperBase::GetBounds()
 
 Clipper::Clipper(int initOptions) : 
   ClipperBase(),
+  m_OutPtsChunksUsed(0),
   m_OutPtsFree(nullptr),
   m_OutPtsChunkSize(32),
   m_OutPtsChunkLast(32),
@@ -1086,7 +1133,7 @@ void Clipper::Reset()
 {
   CLIPPERLIB_PROFILE_FUNC();
   ClipperBase::Reset();
-  m_Scanbeam = std::priority_queue<cInt>();
+  m_Scanbeam.clear();
   m_Maxima.clear();
   m_ActiveEdges = 0;
   m_SortedEdges = 0;
@@ -1114,6 +1161,24 @@ bool Clipper::Execute(ClipType clipType, Paths &solution,
 }
 //------------------------------------------------------------------------------
 
+bool Clipper::Execute(ClipType clipType, FlatPaths &solution,
+    PolyFillType subjFillType, PolyFillType clipFillType)
+{
+  CLIPPERLIB_PROFILE_FUNC();
+  if (m_HasOpenPaths)
+    throw clipperException("Error: PolyTree struct is needed for open path clipping.");
+  solution.clear();
+  m_SubjFillType = subjFillType;
+  m_ClipFillType = clipFillType;
+  m_ClipType = clipType;
+  m_UsingPolyTree = false;
+  bool succeeded = ExecuteInternal();
+  if (succeeded) BuildResult(solution);
+  DisposeAllOutRecs();
+  return succeeded;
+}
+//------------------------------------------------------------------------------
+
 bool Clipper::Execute(ClipType clipType, PolyTree& polytree,
     PolyFillType subjFillType, PolyFillType clipFillType)
 {
@@ -1208,26 +1273,56 @@ OutPt* Clipper::AllocateOutPt()
     m_OutPtsFree = pt->Next;
   } else if (m_OutPtsChunkLast < m_OutPtsChunkSize) {
     // Get a point from the last chunk.
-    pt = m_OutPts.back() + (m_OutPtsChunkLast ++);
+    pt = m_OutPts[m_OutPtsChunksUsed - 1] + (m_OutPtsChunkLast ++);
   } else {
-    // The last chunk is full. Allocate a new one.
-    m_OutPts.push_back(new OutPt[m_OutPtsChunkSize]);
+    // The last chunk is full. Take the next chunk kept by DisposeAllOutRecs() or allocate a new one.
+    if (m_OutPtsChunksUsed == m_OutPts.size())
+      m_OutPts.push_back(new OutPt[m_OutPtsChunkSize]);
+    pt = m_OutPts[m_OutPtsChunksUsed ++];
     m_OutPtsChunkLast = 1;
-    pt = m_OutPts.back();
   }
   return pt;
 }
 
+// Release the output polygons and points, keep their memory for the next Execute().
 void Clipper::DisposeAllOutRecs()
 {
+  m_OutRecsFree.insert(m_OutRecsFree.end(), m_PolyOuts.begin(), m_PolyOuts.end());
+  m_PolyOuts.clear();
+  m_OutPtsChunksUsed = 0;
+  m_OutPtsFree = nullptr;
+  m_OutPtsChunkLast = m_OutPtsChunkSize;
+}
+
+void Clipper::ReleaseMemory()
+{
+  Clear();
+  ClipperBase::ReleaseMemory();
+  FreeOutRecs();
+  std::vector<Join>().swap(m_Joins);
+  std::vector<Join>().swap(m_GhostJoins);
+  std::vector<IntersectNode>().swap(m_IntersectList);
+  m_Scanbeam.shrink_to_fit();
+  std::vector<cInt>().swap(m_Maxima);
+}
+
+size_t Clipper::KeptMemory() const
+{
+  return ClipperBase::KeptMemory() +
+    m_OutPts.size() * m_OutPtsChunkSize * sizeof(OutPt) + m_OutRecsFree.size() * sizeof(OutRec) +
+    (m_Joins.capacity() + m_GhostJoins.capacity()) * sizeof(Join) + m_IntersectList.capacity() * sizeof(IntersectNode) +
+    (m_Scanbeam.capacity() + m_Maxima.capacity()) * sizeof(cInt);
+}
+
+void Clipper::FreeOutRecs()
+{
+  assert(m_PolyOuts.empty() && m_OutPtsChunksUsed == 0);
   for (OutPt *pts : m_OutPts)
     delete[] pts;
-  for (OutRec *rec : m_PolyOuts)
+  for (OutRec *rec : m_OutRecsFree)
     delete rec;
   m_OutPts.clear();
-  m_OutPtsFree = nullptr;
-  m_OutPtsChunkLast = m_OutPtsChunkSize;
-  m_PolyOuts.clear();
+  m_OutRecsFree.clear();
 }
 //------------------------------------------------------------------------------
 
@@ -2010,7 +2105,13 @@ void Clipper::AppendPolygon(TEdge *e1, TEdge *e2) const
 
 OutRec* Clipper::CreateOutRec()
 {
-  OutRec* result = new OutRec;
+  OutRec* result;
+  if (m_OutRecsFree.empty())
+    result = new OutRec;
+  else {
+    result = m_OutRecsFree.back();
+    m_OutRecsFree.pop_back();
+  }
   result->IsHole = false;
   result->IsOpen = false;
   result->FirstLeft = 0;
@@ -2819,6 +2920,26 @@ void Clipper::BuildResult(Paths &polys)
 }
 //------------------------------------------------------------------------------
 
+void Clipper::BuildResult(FlatPaths &polys)
+{
+  polys.ends.reserve(m_PolyOuts.size());
+  for (OutRec* outRec : m_PolyOuts)
+  {
+    assert(! outRec->IsOpen);
+    if (!outRec->Pts) continue;
+    OutPt* p = outRec->Pts->Prev;
+    int cnt = PointCount(p);
+    if (cnt < 2) continue;
+    for (int i = 0; i < cnt; ++i)
+    {
+      polys.points.emplace_back(p->Pt);
+      p = p->Prev;
+    }
+    polys.ends.emplace_back(uint32_t(polys.points.size()));
+  }
+}
+//------------------------------------------------------------------------------
+
 void Clipper::BuildResult2(PolyTree& polytree)
 {
     polytree.Clear();
@@ -3381,12 +3502,35 @@ void ClipperOffset::Clear()
     delete m_polyNodes.Childs[i];
   m_polyNodes.Childs.clear();
   m_lowest.x() = -1;
+  // Release the offset polygons held by the clean-up union.
+  m_clipper.Clear();
 }
 //------------------------------------------------------------------------------
 
-void ClipperOffset::AddPath(const Path& path, JoinType joinType, EndType endType)
+void ClipperOffset::ReleaseMemory()
 {
-  int highI = (int)path.size() - 1;
+  Clear();
+  m_clipper.ReleaseMemory();
+  Paths().swap(m_destPolys);
+  Path().swap(m_srcPoly);
+  Path().swap(m_destPoly);
+  std::vector<DoublePoint>().swap(m_normals);
+}
+//------------------------------------------------------------------------------
+
+size_t ClipperOffset::KeptMemory() const
+{
+  size_t out = m_clipper.KeptMemory() + m_destPolys.capacity() * sizeof(Path) +
+    (m_srcPoly.capacity() + m_destPoly.capacity()) * sizeof(IntPoint) + m_normals.capacity() * sizeof(DoublePoint);
+  for (const Path &path : m_destPolys)
+    out += path.capacity() * sizeof(IntPoint);
+  return out;
+}
+//------------------------------------------------------------------------------
+
+void ClipperOffset::AddPath(const IntPoint *path, size_t size, JoinType joinType, EndType endType)
+{
+  int highI = (int)size - 1;
   if (highI < 0) return;
   PolyNode* newNode = new PolyNode();
   newNode->m_jointype = joinType;
@@ -3481,7 +3625,9 @@ void ClipperOffset::Execute(Paths& solution, double delta)
   DoOffset(delta);
   
   //now clean up 'corners' ...
-  Clipper clpr;
+  Clipper &clpr = m_clipper;
+  clpr.Clear();
+  clpr.ReverseSolution(false);
   clpr.AddPaths(m_destPolys, ptSubject, true);
   if (delta > 0)
   {
@@ -3505,6 +3651,38 @@ void ClipperOffset::Execute(Paths& solution, double delta)
 }
 //------------------------------------------------------------------------------
 
+void ClipperOffset::Execute(FlatPaths& solution, double delta)
+{
+  solution.clear();
+  FixOrientations();
+  DoOffset(delta);
+
+  //now clean up 'corners' ...
+  Clipper &clpr = m_clipper;
+  clpr.Clear();
+  clpr.ReverseSolution(false);
+  clpr.AddPaths(m_destPolys, ptSubject, true);
+  if (delta > 0)
+  {
+    clpr.Execute(ctUnion, solution, pftPositive, pftPositive);
+  }
+  else
+  {
+    IntRect r = clpr.GetBounds();
+    Path outer(4);
+    outer[0] = IntPoint2d(r.left - 10, r.bottom + 10);
+    outer[1] = IntPoint2d(r.right + 10, r.bottom + 10);
+    outer[2] = IntPoint2d(r.right + 10, r.top - 10);
+    outer[3] = IntPoint2d(r.left - 10, r.top - 10);
+
+    clpr.AddPath(outer, ptSubject, true);
+    clpr.ReverseSolution(true);
+    clpr.Execute(ctUnion, solution, pftNegative, pftNegative);
+    solution.erase_front();
+  }
+}
+//------------------------------------------------------------------------------
+
 void ClipperOffset::Execute(PolyTree& solution, double delta)
 {
   solution.Clear();
@@ -3512,7 +3690,9 @@ void ClipperOffset::Execute(PolyTree& solution, double delta)
   DoOffset(delta);
 
   //now clean up 'corners' ...
-  Clipper clpr;
+  Clipper &clpr = m_clipper;
+  clpr.Clear();
+  clpr.ReverseSolution(false);
   clpr.AddPaths(m_destPolys, ptSubject, true);
   if (delta > 0)
   {
@@ -113,6 +113,21 @@ using DoublePoint = Eigen::Matrix<double, 2, 1, Eigen::DontAlign>;
 typedef std::vector<IntPoint> Path;
 typedef std::vector<Path> Paths;
 
+// Paths stored flat: the points of all paths in a single buffer and the end offset of each path into the buffer.
+// Filled in by Clipper::Execute() and ClipperOffset::Execute() without allocating a vector per output path.
+struct FlatPaths
+{
+  Path                  points;
+  // One past the last point of each path in points.
+  std::vector<uint32_t> ends;
+
+  size_t size() const { return ends.size(); }
+  bool   empty() const { return ends.empty(); }
+  void   clear() { points.clear(); ends.clear(); }
+  // Remove the first path, used to drop the outer rectangle of a negative offset.
+  void   erase_front();
+};
+
 inline Path& operator <<(Path& poly, const IntPoint& p) {poly.push_back(p); return poly;}
 inline Paths& operator <<(Paths& polys, const Path& p) {polys.push_back(p); return polys;}
 
@@ -188,8 +203,10 @@ private:
     friend class Clipper; //to access AllNodes
 };
 
-double Area(const Path &poly);
+double Area(const IntPoint *poly, size_t size);
+inline double Area(const Path &poly) { return Area(poly.data(), poly.size()); }
 IntPoint Centroid(const Path& poly, double area);
+inline bool Orientation(const IntPoint *poly, size_t size) { return Area(poly, size) >= 0; }
 inline bool Orientation(const Path &poly) { return Area(poly) >= 0; }
 int PointInPolygon(const IntPoint &pt, const Path &path);
 
@@ -299,21 +316,28 @@ public:
 #endif // CLIPPERLIB_INT32
     m_HasOpenPaths(false) {}
   ~ClipperBase() { Clear(); }
-  bool AddPath(const Path &pg, PolyType PolyTyp, bool Closed);
+  // The points are read in place, they may be stored in any contiguous buffer.
+  bool AddPath(const IntPoint *pg, size_t size, PolyType PolyTyp, bool Closed);
+  bool AddPath(const Path &pg, PolyType PolyTyp, bool Closed) { return AddPath(pg.data(), pg.size(), PolyTyp, Closed); }
 
+  // The provider iterates over paths with data(), size() and operator[], for example over Path or over a view
+  // into a flat buffer of points, see ClipperUtils::PolygonSetProvider.
   template<typename PathsProvider>
   bool AddPaths(PathsProvider &&paths_provider, PolyType PolyTyp, bool Closed)
   {
     size_t num_paths = paths_provider.size();
     if (num_paths == 0)
         return false;
-    if (num_paths == 1)
-        return AddPath(*paths_provider.begin(), PolyTyp, Closed);
+    if (num_paths == 1) {
+        const auto &pg = *paths_provider.begin();
+        return AddPath(pg.data(), pg.size(), PolyTyp, Closed);
+    }
 
-    std::vector<int> num_edges(num_paths, 0);
+    std::vector<int> &num_edges = m_num_edges;
+    num_edges.assign(num_paths, 0);
     int num_edges_total = 0;
     size_t i = 0;
-    for (const Path &pg : paths_provider) {
+    for (const auto &pg : paths_provider) {
       // Remove duplicate end point from a closed input path.
       // Remove duplicate points from the end of the input path.
       int highI = (int)pg.size() -1;
@@ -330,15 +354,15 @@ public:
     if (num_edges_total == 0)
       return false;
 
-    // Allocate a new edge array.
-    std::vector<TEdge> edges(num_edges_total);
+    // Allocate a new edge array or recycle one released by Clear().
+    std::vector<TEdge> edges = AllocateEdges(num_edges_total);
     // Fill in the edge array.
     bool result = false;
     TEdge *p_edge = edges.data();
     i = 0;
-    for (const Path &pg : paths_provider) {
+    for (const auto &pg : paths_provider) {
       if (num_edges[i]) {
-        bool res = AddPathInternal(pg, num_edges[i] - 1, PolyTyp, Closed, p_edge);
+        bool res = AddPathInternal(pg.data(), num_edges[i] - 1, PolyTyp, Closed, p_edge);
         if (res) {
           p_edge += num_edges[i];
           result = true;
@@ -352,14 +376,20 @@ public:
     return result;
   }
 
+  // Remove all the paths. The memory of the edges is kept for the paths added next.
   void Clear();
+  // Remove all the paths and free the memory kept by Clear().
+  void ReleaseMemory();
+  // Size of the memory of the edges of the paths and of the memory kept by Clear() for the next paths, in bytes.
+  size_t KeptMemory() const;
   IntRect GetBounds();
   // By default, when three or more vertices are collinear in input polygons (subject or clip), the Clipper object removes the 'inner' vertices before clipping.
   // When enabled the PreserveCollinear property prevents this default behavior to allow these inner vertices to appear in the solution.
   bool PreserveCollinear() const {return m_PreserveCollinear;};
   void PreserveCollinear(bool value) {m_PreserveCollinear = value;};
 protected:
-  bool AddPathInternal(const Path &pg, int highI, PolyType PolyTyp, bool Closed, TEdge* edges);
+  bool AddPathInternal(const IntPoint *pg, int highI, PolyType PolyTyp, bool Closed, TEdge* edges);
+  std::vector<TEdge> AllocateEdges(size_t num_edges);
   TEdge* AddBoundsToLML(TEdge *e, bool IsClosed);
   void Reset();
   TEdge* ProcessBound(TEdge* E, bool IsClockwise);
@@ -379,6 +409,10 @@ protected:
 
   // A vector of edges per each input path.
   std::vector<std::vector<TEdge>> m_edges;
+  // Edge arrays released by Clear(), to be reused by AddPath() and AddPaths().
+  std::vector<std::vector<TEdge>> m_edges_free;
+  // Number of edges per path, temporary storage of AddPaths().
+  std::vector<int>  m_num_edges;
   // Don't remove intermediate vertices of a collinear sequence of points.
   bool             m_PreserveCollinear;
   // Is any of the paths inserted by AddPath() or AddPaths() open?
@@ -390,8 +424,13 @@ class Clipper : public ClipperBase
 {
 public:
   Clipper(int initOptions = 0);
-  ~Clipper() { Clear(); }
+  ~Clipper() { Clear(); FreeOutRecs(); }
+  // Remove all the paths. The memory of the edges and of the output polygons is kept for the next Execute().
   void Clear() { ClipperBase::Clear(); DisposeAllOutRecs(); }
+  // Remove all the paths and free the memory kept by Clear().
+  void ReleaseMemory();
+  // Size of the memory kept by Clear() for the next Execute(), in bytes.
+  size_t KeptMemory() const;
   bool Execute(ClipType clipType,
       Paths &solution,
       PolyFillType fillType = pftEvenOdd) 
@@ -400,6 +439,10 @@ public:
       Paths &solution,
       PolyFillType subjFillType,
       PolyFillType clipFillType);
+  bool Execute(ClipType clipType,
+      FlatPaths &solution,
+      PolyFillType subjFillType,
+      PolyFillType clipFillType);
   bool Execute(ClipType clipType,
       PolyTree &polytree,
       PolyFillType fillType = pftEvenOdd)
@@ -423,8 +466,12 @@ private:
   
   // Output polygons.
   std::vector<OutRec*>  m_PolyOuts;
+  // Output polygons released by DisposeAllOutRecs(), to be reused by CreateOutRec().
+  std::vector<OutRec*>  m_OutRecsFree;
   // Output points, allocated by a continuous sets of m_OutPtsChunkSize.
+  // The chunks are kept by DisposeAllOutRecs(), only the first m_OutPtsChunksUsed chunks are in use.
   std::vector<OutPt*>   m_OutPts;
+  size_t                m_OutPtsChunksUsed;
   // List of free output points, to be used before taking a point from m_OutPts or allocating a new chunk.
   OutPt                *m_OutPtsFree;
   size_t                m_OutPtsChunkSize;
@@ -434,8 +481,13 @@ private:
   std::vector<Join>     m_GhostJoins;
   std::vector<IntersectNode> m_IntersectList;
   ClipType              m_ClipType;
-  // A priority queue (a binary heap) of Y coordinates.
-  std::priority_queue<cInt> m_Scanbeam;
+  // A priority queue (a binary heap) of Y coordinates, which keeps its memory when cleared.
+  struct Scanbeam : public std::priority_queue<cInt> {
+    void   clear() { this->c.clear(); }
+    void   shrink_to_fit() { this->c.shrink_to_fit(); }
+    size_t capacity() const { return this->c.capacity(); }
+  };
+  Scanbeam              m_Scanbeam;
   // Maxima are collected by ProcessEdgesAtTopOfScanbeam(), consumed by ProcessHorizontal().
   std::vector<cInt>     m_Maxima;
   TEdge                *m_ActiveEdges;
@@ -482,10 +534,12 @@ private:
   void DisposeOutPt(OutPt *pt) { pt->Next = m_OutPtsFree; m_OutPtsFree = pt; }
   void DisposeOutPts(OutPt*& pp) { if (pp != nullptr) { pp->Prev->Next = m_OutPtsFree; m_OutPtsFree = pp; } }
   void DisposeAllOutRecs();
+  void FreeOutRecs();
   bool ProcessIntersections(const cInt topY);
   void BuildIntersectList(const cInt topY);
   void ProcessEdgesAtTopOfScanbeam(const cInt topY);
   void BuildResult(Paths& polys);
+  void BuildResult(FlatPaths& polys);
   void BuildResult2(PolyTree& polytree);
   void SetHoleState(TEdge *e, OutRec *outrec) const;
   bool FixupIntersectionOrder();
@@ -511,15 +565,22 @@ public:
   ClipperOffset(double miterLimit = 2.0, double roundPrecision = 0.25, double shortestEdgeLength = 0.) :
     MiterLimit(miterLimit), ArcTolerance(roundPrecision), ShortestEdgeLength(shortestEdgeLength), m_lowest(-1, 0) {}
   ~ClipperOffset() { Clear(); }
-  void AddPath(const Path& path, JoinType joinType, EndType endType);
+  void AddPath(const IntPoint *path, size_t size, JoinType joinType, EndType endType);
+  void AddPath(const Path& path, JoinType joinType, EndType endType) { AddPath(path.data(), path.size(), joinType, endType); }
   template<typename PathsProvider>
   void AddPaths(PathsProvider &&paths, JoinType joinType, EndType endType) {
-    for (const Path &path : paths)
-      AddPath(path, joinType, endType);
+    for (const auto &path : paths)
+      AddPath(path.data(), path.size(), joinType, endType);
   }
   void Execute(Paths& solution, double delta);
+  void Execute(FlatPaths& solution, double delta);
   void Execute(PolyTree& solution, double delta);
+  // Remove all the paths. The memory of the clean-up union is kept for the next Execute().
   void Clear();
+  // Remove all the paths and free the memory kept for the next Execute().
+  void ReleaseMemory();
+  // Size of the memory kept for the next Execute(), in bytes.
+  size_t KeptMemory() const;
   double MiterLimit;
   double ArcTolerance;
   double ShortestEdgeLength;
@@ -535,6 +596,8 @@ private:
   // y: index of the lowest point in the lowest contour
   IntPoint m_lowest;
   PolyNode m_polyNodes;
+  // Cleans up the offsetted contours, reused by each Execute().
+  Clipper m_clipper;
 
   void FixOrientations();
   void DoOffset(double delta);
@@ -17,6 +17,7 @@
 #include "Utils.hpp"
 #include "SVG.hpp"
 #include "Geometry/VoronoiVisualUtils.hpp"
+#include "Geometry/VoronoiCache.hpp"
 #include "Geometry/VoronoiUtilsCgal.hpp"
 #include "../EdgeGrid.hpp"
 
@@ -604,13 +605,21 @@ void SkeletalTrapezoidation::constructFromPolygons(const Polygons& polys)
     }
 #endif
 
-    Geometry::VoronoiDiagram voronoi_diagram;
-    construct_voronoi(segments.begin(), segments.end(), &voronoi_diagram);
+    // The diagram is shared through the cache with the other layers of the same polygons. It is keyed on the segments
+    // as seen by boost::polygon through the segment_traits above: from the next point to the point.
+    // If the input is rotated to fix a degenerated diagram, the rotated diagram is owned here.
+    Lines segment_lines;
+    segment_lines.reserve(segments.size());
+    for (const Segment &segment : segments)
+        segment_lines.emplace_back(segment.to(), segment.from());
+    std::shared_ptr<const Geometry::VoronoiDiagram> shared_voronoi_diagram = Geometry::VoronoiCache::get(segment_lines);
+    Geometry::VoronoiDiagram                        rotated_voronoi_diagram;
+    const Geometry::VoronoiDiagram                 *voronoi_diagram = shared_voronoi_diagram.get();
 
 #ifdef ARACHNE_DEBUG_VORONOI
     {
         static int iRun = 0;
-        dump_voronoi_to_svg(debug_out_path("arachne_voronoi-diagram-%d.svg", iRun++).c_str(), voronoi_diagram, to_points(polys), to_lines(polys));
+        dump_voronoi_to_svg(debug_out_path("arachne_voronoi-diagram-%d.svg", iRun++).c_str(), *voronoi_diagram, to_points(polys), to_lines(polys));
     }
 #endif
 
@@ -618,9 +627,9 @@ void SkeletalTrapezoidation::constructFromPolygons(const Polygons& polys)
     // the Voronoi diagram is not planar.
     // When any Voronoi vertex is missing, or the Voronoi diagram is not
     // planar, rotate the input polygon and try again.
-    const bool   has_missing_voronoi_vertex = detect_missing_voronoi_vertex(voronoi_diagram, segments);
+    const bool   has_missing_voronoi_vertex = detect_missing_voronoi_vertex(*voronoi_diagram, segments);
     // Detection of non-planar Voronoi diagram detects at least GH issues #8474, #8514 and #8446.
-    const bool   is_voronoi_diagram_planar  = Geometry::VoronoiUtilsCgal::is_voronoi_diagram_planar_angle(voronoi_diagram);
+    const bool   is_voronoi_diagram_planar  = Geometry::VoronoiUtilsCgal::is_voronoi_diagram_planar_angle(*voronoi_diagram);
     const double fix_angle                  = PI / 6;
 
     std::unordered_map<Point, Point, PointHash> vertex_mapping;
@@ -632,13 +641,14 @@ void SkeletalTrapezoidation::constructFromPolygons(const Polygons& polys)
         else if (!is_voronoi_diagram_planar)
             BOOST_LOG_TRIVIAL(warning) << "Detected non-planar Voronoi diagram, input polygons will be rotated back and forth.";
 
-        vertex_mapping = try_to_fix_degenerated_voronoi_diagram_by_rotation(voronoi_diagram, polys, polys_copy, segments, fix_angle);
+        vertex_mapping = try_to_fix_degenerated_voronoi_diagram_by_rotation(rotated_voronoi_diagram, polys, polys_copy, segments, fix_angle);
+        voronoi_diagram = &rotated_voronoi_diagram;
 
-        assert(!detect_missing_voronoi_vertex(voronoi_diagram, segments));
-        assert(Geometry::VoronoiUtilsCgal::is_voronoi_diagram_planar_angle(voronoi_diagram));
-        if (detect_missing_voronoi_vertex(voronoi_diagram, segments))
+        assert(!detect_missing_voronoi_vertex(*voronoi_diagram, segments));
+        assert(Geometry::VoronoiUtilsCgal::is_voronoi_diagram_planar_angle(*voronoi_diagram));
+        if (detect_missing_voronoi_vertex(*voronoi_diagram, segments))
             BOOST_LOG_TRIVIAL(error) << "Detected missing Voronoi vertex even after the rotation of input.";
-        else if (!Geometry::VoronoiUtilsCgal::is_voronoi_diagram_planar_angle(voronoi_diagram))
+        else if (!Geometry::VoronoiUtilsCgal::is_voronoi_diagram_planar_angle(*voronoi_diagram))
             BOOST_LOG_TRIVIAL(error) << "Detected non-planar Voronoi diagram even after the rotation of input.";
     }
 
@@ -646,7 +656,10 @@ void SkeletalTrapezoidation::constructFromPolygons(const Polygons& polys)
 
 process_voronoi_diagram:
     assert(this->graph.edges.empty() && this->graph.nodes.empty() && this->vd_edge_to_he_edge.empty() && this->vd_node_to_he_node.empty());
-    for (vd_t::cell_type cell : voronoi_diagram.cells()) {
+    // Each Voronoi edge becomes a half-edge, the ribs add two half-edges and a node per Voronoi vertex and per source point.
+    this->graph.edges.reserve(voronoi_diagram->edges().size() + 2 * (voronoi_diagram->vertices().size() + voronoi_diagram->cells().size()));
+    this->graph.nodes.reserve(voronoi_diagram->vertices().size() + voronoi_diagram->cells().size());
+    for (vd_t::cell_type cell : voronoi_diagram->cells()) {
         if (!cell.incident_edge())
             continue; // There is no spoon
 
@@ -708,13 +721,14 @@ process_voronoi_diagram:
     if (!degenerated_voronoi_diagram && has_missing_twin_edge(this->graph)) {
         BOOST_LOG_TRIVIAL(warning) << "Detected degenerated Voronoi diagram, input polygons will be rotated back and forth.";
         degenerated_voronoi_diagram = true;
-        vertex_mapping = try_to_fix_degenerated_voronoi_diagram_by_rotation(voronoi_diagram, polys, polys_copy, segments, fix_angle);
+        vertex_mapping = try_to_fix_degenerated_voronoi_diagram_by_rotation(rotated_voronoi_diagram, polys, polys_copy, segments, fix_angle);
+        voronoi_diagram = &rotated_voronoi_diagram;
 
-        assert(!detect_missing_voronoi_vertex(voronoi_diagram, segments));
-        if (detect_missing_voronoi_vertex(voronoi_diagram, segments))
+        assert(!detect_missing_voronoi_vertex(*voronoi_diagram, segments));
+        if (detect_missing_voronoi_vertex(*voronoi_diagram, segments))
             BOOST_LOG_TRIVIAL(error) << "Detected missing Voronoi vertex after the rotation of input.";
 
-        assert(Geometry::VoronoiUtilsCgal::is_voronoi_diagram_planar_intersection(voronoi_diagram));
+        assert(Geometry::VoronoiUtilsCgal::is_voronoi_diagram_planar_intersection(*voronoi_diagram));
 
         this->graph.edges.clear();
         this->graph.nodes.clear();
@@ -735,7 +749,14 @@ process_voronoi_diagram:
         rotate_back_skeletal_trapezoidation_graph_after_fix(this->graph, fix_angle, vertex_mapping);
 
 #ifdef ARACHNE_DEBUG
-    assert(Geometry::VoronoiUtilsCgal::is_voronoi_diagram_planar_intersection(voronoi_diagram));
+    // The check colors the edges: the diagram shared through the cache is checked on a private diagram of the same segments.
+    if (voronoi_diagram == &rotated_voronoi_diagram) {
+        assert(Geometry::VoronoiUtilsCgal::is_voronoi_diagram_planar_intersection(rotated_voronoi_diagram));
+    } else {
+        Geometry::VoronoiDiagram private_voronoi_diagram;
+        construct_voronoi(segments.begin(), segments.end(), &private_voronoi_diagram);
+        assert(Geometry::VoronoiUtilsCgal::is_voronoi_diagram_planar_intersection(private_voronoi_diagram));
+    }
 #endif
 
     separatePointyQuadEndNodes();
@@ -5,8 +5,15 @@
 #define UTILS_HALF_EDGE_GRAPH_H
 
 
-#include <list>
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 
 
@@ -15,14 +22,191 @@
 
 namespace Slic3r::Arachne
 {
+/*!
+ * Storage of the nodes or of the edges of a HalfEdgeGraph.
+ *
+ * The elements are allocated from chunks of contiguous memory and the slots of the erased elements are reused, thus
+ * building a graph doesn't allocate memory per element and the elements created one after the other are next to each
+ * other in memory. The elements never move: a pointer to an element is a stable handle until the element is erased.
+ *
+ * The interface is the subset of std::list used by the graph, with the same order of iteration.
+ */
+template<class T>
+class HalfEdgeGraphStorage
+{
+    struct Slot
+    {
+        alignas(T) unsigned char storage[sizeof(T)];
+        Slot* prev;
+        Slot* next;
+
+        T& value() { return *std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+public:
+    template<class Value>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = Value*;
+        using reference         = Value&;
+
+        Iterator() = default;
+        // Conversion of an iterator to a const_iterator, not the other way around.
+        template<class OtherValue, class = std::enable_if_t<std::is_const_v<Value> && ! std::is_const_v<OtherValue>>>
+        Iterator(const Iterator<OtherValue>& other) : slot(other.slot) {}
+
+        reference operator*() const { return slot->value(); }
+        pointer   operator->() const { return &slot->value(); }
+        Iterator& operator++() { slot = slot->next; return *this; }
+        Iterator  operator++(int) { Iterator it = *this; slot = slot->next; return it; }
+        bool      operator==(const Iterator& other) const { return slot == other.slot; }
+        bool      operator!=(const Iterator& other) const { return slot != other.slot; }
+
+    private:
+        explicit Iterator(Slot* slot) : slot(slot) {}
+
+        Slot* slot = nullptr;
+
+        friend class HalfEdgeGraphStorage;
+        template<class> friend class Iterator;
+    };
+
+    using iterator       = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+
+    HalfEdgeGraphStorage() = default;
+    HalfEdgeGraphStorage(const HalfEdgeGraphStorage&) = delete;
+    HalfEdgeGraphStorage& operator=(const HalfEdgeGraphStorage&) = delete;
+    ~HalfEdgeGraphStorage() { clear(); }
+
+    iterator       begin() { return iterator(first); }
+    iterator       end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(first); }
+    const_iterator end() const { return const_iterator(); }
+
+    bool   empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    T& front() { assert(first); return first->value(); }
+    T& back() { assert(last); return last->value(); }
+
+    template<class... Args>
+    T& emplace_front(Args&&... args)
+    {
+        Slot* slot = construct(std::forward<Args>(args)...);
+        slot->prev = nullptr;
+        slot->next = first;
+        (first ? first->prev : last) = slot;
+        first = slot;
+        return slot->value();
+    }
+
+    template<class... Args>
+    T& emplace_back(Args&&... args)
+    {
+        Slot* slot = construct(std::forward<Args>(args)...);
+        slot->prev = last;
+        slot->next = nullptr;
+        (last ? last->next : first) = slot;
+        last = slot;
+        return slot->value();
+    }
+
+    /*!
+     * Destroy the element and keep its slot for the next emplace_front() or emplace_back().
+     *
+     * \return The iterator following the erased element.
+     */
+    iterator erase(iterator it)
+    {
+        Slot* slot = it.slot;
+        assert(slot);
+        Slot* next = slot->next;
+        (slot->prev ? slot->prev->next : first) = next;
+        (next ? next->prev : last) = slot->prev;
+        slot->value().~T();
+        slot->next = free_slots;
+        free_slots = slot;
+        --count;
+        return iterator(next);
+    }
+
+    /*!
+     * Destroy all the elements and release the memory.
+     */
+    void clear()
+    {
+        for (Slot* slot = first; slot; slot = slot->next)
+            slot->value().~T();
+        first = last = free_slots = nullptr;
+        count = 0;
+        chunks.clear();
+        chunk_used = chunk_capacity = 0;
+    }
+
+    /*!
+     * Make room for \p n elements in total in contiguous memory, if the current chunk is not large enough for them.
+     *
+     * The slots of the erased elements are not taken into account.
+     */
+    void reserve(size_t n)
+    {
+        if (n > count && n - count > chunk_capacity - chunk_used)
+            allocateChunk(n - count);
+    }
+
+private:
+    static constexpr size_t min_chunk_size = 256;
+
+    template<class... Args>
+    Slot* construct(Args&&... args)
+    {
+        if (! free_slots && chunk_used == chunk_capacity)
+            // Grow geometrically, the number of chunks stays low.
+            allocateChunk(std::max(min_chunk_size, count));
+        Slot* slot = free_slots ? free_slots : &chunks.back()[chunk_used];
+        ::new (slot->storage) T(std::forward<Args>(args)...);
+        // Take the slot only once the element is constructed, for the case its constructor throws.
+        if (slot == free_slots)
+            free_slots = free_slots->next;
+        else
+            ++chunk_used;
+        ++count;
+        return slot;
+    }
+
+    void allocateChunk(size_t n)
+    {
+        chunks.emplace_back(new Slot[n]);
+        chunk_used     = 0;
+        chunk_capacity = n;
+    }
+
+    Slot*                           first      = nullptr;
+    Slot*                           last       = nullptr;
+    // Slots of the erased elements, chained by Slot::next.
+    Slot*                           free_slots = nullptr;
+    size_t                          count      = 0;
+    std::vector<std::unique_ptr<Slot[]>> chunks;
+    // Number of slots taken from the last chunk, and its size.
+    size_t                          chunk_used     = 0;
+    size_t                          chunk_capacity = 0;
+};
+
 template<class node_data_t, class edge_data_t, class derived_node_t, class derived_edge_t> // types of data contained in nodes and edges
 class HalfEdgeGraph
 {
 public:
     using edge_t = derived_edge_t;
     using node_t = derived_node_t;
-    std::list<edge_t> edges;
-    std::list<node_t> nodes;
+    using edges_t = HalfEdgeGraphStorage<edge_t>;
+    using nodes_t = HalfEdgeGraphStorage<node_t>;
+    edges_t edges;
+    nodes_t nodes;
 };
 
 } // namespace Slic3r::Arachne
@@ -60,6 +60,61 @@ namespace ClipperUtils {
     Points EmptyPathsProvider::s_empty_points;
     Points SinglePathProvider::s_end;
 
+    // Clipper engines allocate their edges, output polygons and scan beam on the heap. Instead of constructing an engine
+    // for each operation, an operation leases a cleared engine of its thread, which keeps the memory of the previous
+    // operations. A nested operation leases another engine. The TBB worker threads never exit, thus an engine returned
+    // with more than max_kept_memory frees it rather than keeping the peak of the largest operation for good.
+    template<class TEngine>
+    class ReusedEngine
+    {
+    public:
+        ReusedEngine() {
+            std::vector<std::unique_ptr<TEngine>> &engines = free_engines();
+            if (engines.empty())
+                m_engine = std::make_unique<TEngine>();
+            else {
+                m_engine = std::move(engines.back());
+                engines.pop_back();
+            }
+        }
+        ~ReusedEngine() {
+            reset(*m_engine);
+            if (m_engine->KeptMemory() > max_kept_memory)
+                m_engine->ReleaseMemory();
+            free_engines().emplace_back(std::move(m_engine));
+        }
+        ReusedEngine(const ReusedEngine &) = delete;
+        ReusedEngine& operator=(const ReusedEngine &) = delete;
+
+        TEngine* operator->() { return m_engine.get(); }
+        TEngine& operator*()  { return *m_engine; }
+
+    private:
+        static constexpr const size_t max_kept_memory = 1024 * 1024;
+
+        static std::vector<std::unique_ptr<TEngine>>& free_engines() {
+            static thread_local std::vector<std::unique_ptr<TEngine>> engines;
+            return engines;
+        }
+        // Clear the paths and restore the default settings.
+        static void reset(ClipperLib::Clipper &clipper) {
+            clipper.Clear();
+            clipper.ReverseSolution(false);
+            clipper.StrictlySimple(false);
+            clipper.PreserveCollinear(false);
+        }
+        static void reset(ClipperLib::ClipperOffset &co) {
+            co.Clear();
+            co.MiterLimit         = 2.;
+            co.ArcTolerance       = 0.25;
+            co.ShortestEdgeLength = 0.;
+        }
+
+        std::unique_ptr<TEngine> m_engine;
+    };
+    using ReusedClipper       = ReusedEngine<ClipperLib::Clipper>;
+    using ReusedClipperOffset = ReusedEngine<ClipperLib::ClipperOffset>;
+
     
     // Clip source polygon to be used as a clipping polygon with a bouding box around the source (to be clipped)
     // polygon. Useful as an optimization for expensive ClipperLib operations, for example when clipping source
@@ -277,23 +332,23 @@ bool has_duplicate_points(const ClipperLib::PolyTree &polytree)
 template<typename PathsProvider, ClipperLib::EndType endType = ClipperLib::etClosedPolygon>
 static ClipperLib::Paths raw_offset(PathsProvider &&paths, double offset, ClipperLib::JoinType joinType, double miterLimit)
 {
-    ClipperLib::ClipperOffset co;
+    ClipperUtils::ReusedClipperOffset co;
     ClipperLib::Paths out;
     out.reserve(paths.size());
     ClipperLib::Paths out_this;
     if (joinType == jtRound)
-        co.ArcTolerance = miterLimit;
+        co->ArcTolerance = miterLimit;
     else
-        co.MiterLimit = miterLimit;
-    co.ShortestEdgeLength = double(std::abs(offset * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
-    for (const ClipperLib::Path &path : paths) {
-        co.Clear();
+        co->MiterLimit = miterLimit;
+    co->ShortestEdgeLength = double(std::abs(offset * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
+    for (const auto &path : paths) {
+        co->Clear();
         // Execute reorients the contours so that the outer most contour has a positive area. Thus the output
         // contours will be CCW oriented even though the input paths are CW oriented.
         // Offset is applied after contour reorientation, thus the signum of the offset value is reversed.
-        co.AddPath(path, joinType, endType);
-        bool ccw = endType == ClipperLib::etClosedPolygon ? ClipperLib::Orientation(path) : true;
-        co.Execute(out_this, ccw ? offset : - offset);
+        co->AddPath(path.data(), path.size(), joinType, endType);
+        bool ccw = endType == ClipperLib::etClosedPolygon ? ClipperLib::Orientation(path.data(), path.size()) : true;
+        co->Execute(out_this, ccw ? offset : - offset);
         if (! ccw) {
             // Reverse the resulting contours.
             for (ClipperLib::Path &path : out_this)
@@ -318,11 +373,11 @@ TResult clipper_do(
     TClip &&                       clip,
     const ClipperLib::PolyFillType fillType)
 {
-    ClipperLib::Clipper clipper;
-    clipper.AddPaths(std::forward<TSubj>(subject), ClipperLib::ptSubject, true);
-    clipper.AddPaths(std::forward<TClip>(clip),    ClipperLib::ptClip,    true);
+    ClipperUtils::ReusedClipper clipper;
+    clipper->AddPaths(std::forward<TSubj>(subject), ClipperLib::ptSubject, true);
+    clipper->AddPaths(std::forward<TClip>(clip),    ClipperLib::ptClip,    true);
     TResult retval;
-    clipper.Execute(clipType, retval, fillType, fillType);
+    clipper->Execute(clipType, retval, fillType, fillType);
     return retval;
 }
 
@@ -347,10 +402,10 @@ TResult clipper_union(
     // fillType pftNonZero and pftPositive "should" produce the same result for "normalized with implicit union" set of polygons
     const ClipperLib::PolyFillType fillType = ClipperLib::pftNonZero)
 {
-    ClipperLib::Clipper clipper;
-    clipper.AddPaths(std::forward<TSubj>(subject), ClipperLib::ptSubject, true);
+    ClipperUtils::ReusedClipper clipper;
+    clipper->AddPaths(std::forward<TSubj>(subject), ClipperLib::ptSubject, true);
     TResult retval;
-    clipper.Execute(ClipperLib::ctUnion, retval, fillType, fillType);
+    clipper->Execute(ClipperLib::ctUnion, retval, fillType, fillType);
     return retval;
 }
 
@@ -381,6 +436,8 @@ template<> void remove_outermost_polygon<ClipperLib::Paths>(ClipperLib::Paths &s
     { if (! solution.empty()) solution.erase(solution.begin()); }
 template<> void remove_outermost_polygon<ClipperLib::PolyTree>(ClipperLib::PolyTree &solution)
     { solution.RemoveOutermostPolygon(); }
+template<> void remove_outermost_polygon<ClipperLib::FlatPaths>(ClipperLib::FlatPaths &solution)
+    { solution.erase_front(); }
 
 template<class TResult, typename PathsProvider>
 static TResult shrink_paths(PathsProvider &&paths, double offset, ClipperLib::JoinType joinType, double miterLimit)
@@ -388,12 +445,12 @@ static TResult shrink_paths(PathsProvider &&paths, double offset, ClipperLib::Jo
     assert(offset > 0);
     TResult out;
     if (auto raw = raw_offset(std::forward<PathsProvider>(paths), - offset, joinType, miterLimit); ! raw.empty()) {
-        ClipperLib::Clipper clipper;
-        clipper.AddPaths(raw, ClipperLib::ptSubject, true);
-        ClipperLib::IntRect r = clipper.GetBounds();
-        clipper.AddPath({ { r.left - 10, r.bottom + 10 }, { r.right + 10, r.bottom + 10 }, { r.right + 10, r.top - 10 }, { r.left - 10, r.top - 10 } }, ClipperLib::ptSubject, true);
-        clipper.ReverseSolution(true);
-        clipper.Execute(ClipperLib::ctUnion, out, ClipperLib::pftNegative, ClipperLib::pftNegative);
+        ClipperUtils::ReusedClipper clipper;
+        clipper->AddPaths(raw, ClipperLib::ptSubject, true);
+        ClipperLib::IntRect r = clipper->GetBounds();
+        clipper->AddPath({ { r.left - 10, r.bottom + 10 }, { r.right + 10, r.bottom + 10 }, { r.right + 10, r.top - 10 }, { r.left - 10, r.top - 10 } }, ClipperLib::ptSubject, true);
+        clipper->ReverseSolution(true);
+        clipper->Execute(ClipperLib::ctUnion, out, ClipperLib::pftNegative, ClipperLib::pftNegative);
         remove_outermost_polygon(out);
     }
     return out;
@@ -413,6 +470,12 @@ Slic3r::Polygons offset(const Slic3r::Polygon &polygon, const double delta, Clip
 
 Slic3r::Polygons offset(const Slic3r::Polygons &polygons, const double delta, ClipperLib::JoinType joinType, double miterLimit)
     { return to_polygons(offset_paths<ClipperLib::Paths>(ClipperUtils::PolygonsProvider(polygons), delta, joinType, miterLimit)); }
+// The Clipper output is moved into the set, it is not copied.
+static inline PolygonSet to_polygon_set(ClipperLib::FlatPaths &&paths)
+    { return PolygonSet(std::move(paths.points), std::move(paths.ends)); }
+
+Slic3r::PolygonSet offset(const Slic3r::PolygonSet &polygons, const double delta, ClipperLib::JoinType joinType, double miterLimit)
+    { return to_polygon_set(offset_paths<ClipperLib::FlatPaths>(ClipperUtils::PolygonSetProvider(polygons), delta, joinType, miterLimit)); }
 Slic3r::ExPolygons offset_ex(const Slic3r::Polygons &polygons, const double delta, ClipperLib::JoinType joinType, double miterLimit)
     { return PolyTreeToExPolygons(offset_paths<ClipperLib::PolyTree>(ClipperUtils::PolygonsProvider(polygons), delta, joinType, miterLimit)); }
 
@@ -427,14 +490,14 @@ static int offset_expolygon_inner(const Slic3r::ExPolygon &expoly, const double
     // 1) Offset the outer contour.
     ClipperLib::Paths contours;
     {
-        ClipperLib::ClipperOffset co;
+        ClipperUtils::ReusedClipperOffset co;
         if (joinType == jtRound)
-            co.ArcTolerance = miterLimit;
+            co->ArcTolerance = miterLimit;
         else
-            co.MiterLimit = miterLimit;
-        co.ShortestEdgeLength = double(std::abs(delta * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
-        co.AddPath(expoly.contour.points, joinType, ClipperLib::etClosedPolygon);
-        co.Execute(contours, delta);
+            co->MiterLimit = miterLimit;
+        co->ShortestEdgeLength = double(std::abs(delta * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
+        co->AddPath(expoly.contour.points, joinType, ClipperLib::etClosedPolygon);
+        co->Execute(contours, delta);
     }
     if (contours.empty())
         // No need to try to offset the holes.
@@ -448,18 +511,18 @@ static int offset_expolygon_inner(const Slic3r::ExPolygon &expoly, const double
         ClipperLib::Paths holes;
         {
             for (const Polygon &hole : expoly.holes) {
-                ClipperLib::ClipperOffset co;
+                ClipperUtils::ReusedClipperOffset co;
                 if (joinType == jtRound)
-                    co.ArcTolerance = miterLimit;
+                    co->ArcTolerance = miterLimit;
                 else
-                    co.MiterLimit = miterLimit;
-                co.ShortestEdgeLength = double(std::abs(delta * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
-                co.AddPath(hole.points, joinType, ClipperLib::etClosedPolygon);
+                    co->MiterLimit = miterLimit;
+                co->ShortestEdgeLength = double(std::abs(delta * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
+                co->AddPath(hole.points, joinType, ClipperLib::etClosedPolygon);
                 ClipperLib::Paths out2;
                 // Execute reorients the contours so that the outer most contour has a positive area. Thus the output
                 // contours will be CCW oriented even though the input paths are CW oriented.
                 // Offset is applied after contour reorientation, thus the signum of the offset value is reversed.
-                co.Execute(out2, - delta);
+                co->Execute(out2, - delta);
                 append(holes, std::move(out2));
             }
         }
@@ -732,6 +795,12 @@ static inline Polygons _clipper(ClipperLib::ClipType clipType, TSubj &&subject,
     return to_polygons(clipper_do<ClipperLib::Paths>(clipType, std::forward<TSubj>(subject), std::forward<TClip>(clip), ClipperLib::pftNonZero, do_safety_offset));
 }
 
+template<class TSubj, class TClip>
+static inline PolygonSet _clipper_set(ClipperLib::ClipType clipType, TSubj &&subject, TClip &&clip, ApplySafetyOffset do_safety_offset)
+{
+    return to_polygon_set(clipper_do<ClipperLib::FlatPaths>(clipType, std::forward<TSubj>(subject), std::forward<TClip>(clip), ClipperLib::pftNonZero, do_safety_offset));
+}
+
 Slic3r::Polygons diff(const Slic3r::Polygon &subject, const Slic3r::Polygon &clip, ApplySafetyOffset do_safety_offset)
     { return _clipper(ClipperLib::ctDifference, ClipperUtils::SinglePathProvider(subject.points), ClipperUtils::SinglePathProvider(clip.points), do_safety_offset); }
 Slic3r::Polygons diff(const Slic3r::Polygons &subject, const Slic3r::Polygons &clip, ApplySafetyOffset do_safety_offset)
@@ -744,6 +813,8 @@ Slic3r::Polygons diff(const Slic3r::ExPolygons &subject, const Slic3r::ExPolygon
     { return _clipper(ClipperLib::ctDifference, ClipperUtils::ExPolygonsProvider(subject), ClipperUtils::ExPolygonsProvider(clip), do_safety_offset); }
 Slic3r::Polygons diff(const Slic3r::Surfaces &subject, const Slic3r::Polygons &clip, ApplySafetyOffset do_safety_offset)
     { return _clipper(ClipperLib::ctDifference, ClipperUtils::SurfacesProvider(subject), ClipperUtils::PolygonsProvider(clip), do_safety_offset); }
+Slic3r::PolygonSet diff(const Slic3r::PolygonSet &subject, const Slic3r::PolygonSet &clip, ApplySafetyOffset do_safety_offset)
+    { return _clipper_set(ClipperLib::ctDifference, ClipperUtils::PolygonSetProvider(subject), ClipperUtils::PolygonSetProvider(clip), do_safety_offset); }
 Slic3r::Polygons intersection(const Slic3r::Polygon &subject, const Slic3r::Polygon &clip, ApplySafetyOffset do_safety_offset)
     { return _clipper(ClipperLib::ctIntersection, ClipperUtils::SinglePathProvider(subject.points), ClipperUtils::SinglePathProvider(clip.points), do_safety_offset); }
 Slic3r::Polygons intersection(const Slic3r::Polygons &subject, const Slic3r::Polygons &clip, ApplySafetyOffset do_safety_offset)
@@ -758,6 +829,8 @@ Slic3r::Polygons intersection(const Slic3r::Surfaces &subject, const Slic3r::Pol
     { return _clipper(ClipperLib::ctIntersection, ClipperUtils::SurfacesProvider(subject), ClipperUtils::PolygonsProvider(clip), do_safety_offset); }
 Slic3r::Polygons intersection(const Slic3r::Surfaces &subject, const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset)
     { return _clipper(ClipperLib::ctIntersection, ClipperUtils::SurfacesProvider(subject), ClipperUtils::ExPolygonsProvider(clip), do_safety_offset); }
+Slic3r::PolygonSet intersection(const Slic3r::PolygonSet &subject, const Slic3r::PolygonSet &clip, ApplySafetyOffset do_safety_offset)
+    { return _clipper_set(ClipperLib::ctIntersection, ClipperUtils::PolygonSetProvider(subject), ClipperUtils::PolygonSetProvider(clip), do_safety_offset); }
 Slic3r::Polygons union_(const Slic3r::Polygons &subject)
     { return _clipper(ClipperLib::ctUnion, ClipperUtils::PolygonsProvider(subject), ClipperUtils::EmptyPathsProvider(), ApplySafetyOffset::No); }
 Slic3r::Polygons union_(const Slic3r::Polygons &subject, const ClipperLib::PolyFillType fillType)
@@ -766,6 +839,10 @@ Slic3r::Polygons union_(const Slic3r::ExPolygons &subject)
     { return _clipper(ClipperLib::ctUnion, ClipperUtils::ExPolygonsProvider(subject), ClipperUtils::EmptyPathsProvider(), ApplySafetyOffset::No); }
 Slic3r::Polygons union_(const Slic3r::Polygons &subject, const Slic3r::Polygons &subject2)
     { return _clipper(ClipperLib::ctUnion, ClipperUtils::PolygonsProvider(subject), ClipperUtils::PolygonsProvider(subject2), ApplySafetyOffset::No); }
+Slic3r::PolygonSet union_(const Slic3r::PolygonSet &subject)
+    { return _clipper_set(ClipperLib::ctUnion, ClipperUtils::PolygonSetProvider(subject), ClipperUtils::EmptyPathsProvider(), ApplySafetyOffset::No); }
+Slic3r::PolygonSet union_(const Slic3r::PolygonSet &subject, const Slic3r::PolygonSet &subject2)
+    { return _clipper_set(ClipperLib::ctUnion, ClipperUtils::PolygonSetProvider(subject), ClipperUtils::PolygonSetProvider(subject2), ApplySafetyOffset::No); }
 
 template <typename TSubject, typename TClip>
 static ExPolygons _clipper_ex(ClipperLib::ClipType clipType, TSubject &&subject,  TClip &&clip, ApplySafetyOffset do_safety_offset, ClipperLib::PolyFillType fill_type = ClipperLib::pftNonZero)
@@ -795,6 +872,10 @@ Slic3r::ExPolygons diff_ex(const Slic3r::Surfaces &subject, const Slic3r::Surfac
     { return _clipper_ex(ClipperLib::ctDifference, ClipperUtils::SurfacesProvider(subject), ClipperUtils::SurfacesProvider(clip), do_safety_offset); }
 Slic3r::ExPolygons diff_ex(const Slic3r::SurfacesPtr &subject, const Slic3r::Polygons &clip, ApplySafetyOffset do_safety_offset)
     { return _clipper_ex(ClipperLib::ctDifference, ClipperUtils::SurfacesPtrProvider(subject), ClipperUtils::PolygonsProvider(clip), do_safety_offset); }
+Slic3r::ExPolygons diff_ex(const Slic3r::ExPolygons &subject, const Slic3r::PolygonSet &clip, ApplySafetyOffset do_safety_offset)
+    { return _clipper_ex(ClipperLib::ctDifference, ClipperUtils::ExPolygonsProvider(subject), ClipperUtils::PolygonSetProvider(clip), do_safety_offset); }
+Slic3r::ExPolygons diff_ex(const Slic3r::PolygonSet &subject, const Slic3r::PolygonSet &clip, ApplySafetyOffset do_safety_offset)
+    { return _clipper_ex(ClipperLib::ctDifference, ClipperUtils::PolygonSetProvider(subject), ClipperUtils::PolygonSetProvider(clip), do_safety_offset); }
 
 Slic3r::ExPolygons intersection_ex(const Slic3r::Polygons &subject, const Slic3r::Polygons &clip, ApplySafetyOffset do_safety_offset)
     { return _clipper_ex(ClipperLib::ctIntersection, ClipperUtils::PolygonsProvider(subject), ClipperUtils::PolygonsProvider(clip), do_safety_offset); }
@@ -814,6 +895,10 @@ Slic3r::ExPolygons intersection_ex(const Slic3r::Surfaces &subject, const Slic3r
     { return _clipper_ex(ClipperLib::ctIntersection, ClipperUtils::SurfacesProvider(subject), ClipperUtils::SurfacesProvider(clip), do_safety_offset); }
 Slic3r::ExPolygons intersection_ex(const Slic3r::SurfacesPtr &subject, const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset)
     { return _clipper_ex(ClipperLib::ctIntersection, ClipperUtils::SurfacesPtrProvider(subject), ClipperUtils::ExPolygonsProvider(clip), do_safety_offset); }
+Slic3r::ExPolygons intersection_ex(const Slic3r::PolygonSet &subject, const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset)
+    { return _clipper_ex(ClipperLib::ctIntersection, ClipperUtils::PolygonSetProvider(subject), ClipperUtils::ExPolygonsProvider(clip), do_safety_offset); }
+Slic3r::ExPolygons intersection_ex(const Slic3r::ExPolygons &subject, const Slic3r::PolygonSet &clip, ApplySafetyOffset do_safety_offset)
+    { return _clipper_ex(ClipperLib::ctIntersection, ClipperUtils::ExPolygonsProvider(subject), ClipperUtils::PolygonSetProvider(clip), do_safety_offset); }
 // May be used to "heal" unusual models (3DLabPrints etc.) by providing fill_type (pftEvenOdd, pftNonZero, pftPositive, pftNegative).
 Slic3r::ExPolygons union_ex(const Slic3r::Polygons &subject, ClipperLib::PolyFillType fill_type)
     { return _clipper_ex(ClipperLib::ctUnion, ClipperUtils::PolygonsProvider(subject), ClipperUtils::EmptyPathsProvider(), ApplySafetyOffset::No, fill_type); }
@@ -821,6 +906,8 @@ Slic3r::ExPolygons union_ex(const Slic3r::ExPolygons &subject)
     { return PolyTreeToExPolygons(clipper_do_polytree(ClipperLib::ctUnion, ClipperUtils::ExPolygonsProvider(subject), ClipperUtils::EmptyPathsProvider(), ClipperLib::pftNonZero)); }
 Slic3r::ExPolygons union_ex(const Slic3r::Surfaces &subject)
     { return PolyTreeToExPolygons(clipper_do_polytree(ClipperLib::ctUnion, ClipperUtils::SurfacesProvider(subject), ClipperUtils::EmptyPathsProvider(), ClipperLib::pftNonZero)); }
+Slic3r::ExPolygons union_ex(const Slic3r::PolygonSet &subject)
+    { return PolyTreeToExPolygons(clipper_do_polytree(ClipperLib::ctUnion, ClipperUtils::PolygonSetProvider(subject), ClipperUtils::EmptyPathsProvider(), ClipperLib::pftNonZero)); }
 Slic3r::ExPolygons union_ex(const Slic3r::ExPolygons & expolygons1, const Slic3r::ExPolygons & expolygons2, ApplySafetyOffset do_safety_offset)
 {
     ExPolygons poly_union = expolygons1;
@@ -884,16 +971,15 @@ Polylines _clipper_pl_open(ClipperLib::ClipType clipType, PathsProvider1 &&subje
     }
 
     // init Clipper
-    ClipperLib::Clipper clipper;
-    clipper.Clear();
+    ClipperUtils::ReusedClipper clipper;
 
     // add polygons
-    clipper.AddPaths(input_subject, ClipperLib::ptSubject, false);
-    clipper.AddPaths(input_clip, ClipperLib::ptClip, true);
+    clipper->AddPaths(input_subject, ClipperLib::ptSubject, false);
+    clipper->AddPaths(input_clip, ClipperLib::ptClip, true);
 
     // perform operation
     ClipperLib::PolyTree retval;
-    clipper.Execute(clipType, retval, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+    clipper->Execute(clipType, retval, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
 
     //restore good y
     std::vector<ClipperLib::PolyNode*> to_check;
@@ -1276,11 +1362,11 @@ Polygons simplify_polygons(const Polygons &subject, bool preserve_collinear)
 {
     ClipperLib::Paths output;
     if (preserve_collinear) {
-        ClipperLib::Clipper c;
-        c.PreserveCollinear(true);
-        c.StrictlySimple(true);
-        c.AddPaths(ClipperUtils::PolygonsProvider(subject), ClipperLib::ptSubject, true);
-        c.Execute(ClipperLib::ctUnion, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+        ClipperUtils::ReusedClipper c;
+        c->PreserveCollinear(true);
+        c->StrictlySimple(true);
+        c->AddPaths(ClipperUtils::PolygonsProvider(subject), ClipperLib::ptSubject, true);
+        c->Execute(ClipperLib::ctUnion, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
     } else {
         output = ClipperLib::SimplifyPolygons(ClipperUtils::PolygonsProvider(subject), ClipperLib::pftNonZero);
     }
@@ -1295,11 +1381,11 @@ ExPolygons simplify_polygons_ex(const Polygons &subject, bool preserve_collinear
         return union_ex(simplify_polygons(subject, false));
 
     ClipperLib::PolyTree polytree;    
-    ClipperLib::Clipper c;
-    c.PreserveCollinear(true);
-    c.StrictlySimple(true);
-    c.AddPaths(ClipperUtils::PolygonsProvider(subject), ClipperLib::ptSubject, true);
-    c.Execute(ClipperLib::ctUnion, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+    ClipperUtils::ReusedClipper c;
+    c->PreserveCollinear(true);
+    c->StrictlySimple(true);
+    c->AddPaths(ClipperUtils::PolygonsProvider(subject), ClipperLib::ptSubject, true);
+    c->Execute(ClipperLib::ctUnion, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
     
     // convert into ExPolygons
     return PolyTreeToExPolygons(std::move(polytree));
@@ -1308,12 +1394,11 @@ ExPolygons simplify_polygons_ex(const Polygons &subject, bool preserve_collinear
 Polygons top_level_islands(const Slic3r::Polygons &polygons)
 {
     // init Clipper
-    ClipperLib::Clipper clipper;
-    clipper.Clear();
+    ClipperUtils::ReusedClipper clipper;
     // perform union
-    clipper.AddPaths(ClipperUtils::PolygonsProvider(polygons), ClipperLib::ptSubject, true);
+    clipper->AddPaths(ClipperUtils::PolygonsProvider(polygons), ClipperLib::ptSubject, true);
     ClipperLib::PolyTree polytree;
-    clipper.Execute(ClipperLib::ctUnion, polytree, ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd); 
+    clipper->Execute(ClipperLib::ctUnion, polytree, ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd); 
     // Convert only the top level islands to the output.
     Polygons out;
     out.reserve(polytree.ChildCount());
@@ -1332,10 +1417,10 @@ ClipperLib::Paths fix_after_outer_offset(
 {
   	ClipperLib::Paths solution;
   	if (! input.empty()) {
-		ClipperLib::Clipper clipper;
-	  	clipper.AddPath(input, ClipperLib::ptSubject, true);
-		clipper.ReverseSolution(reverse_result);
-		clipper.Execute(ClipperLib::ctUnion, solution, filltype, filltype);
+		ClipperUtils::ReusedClipper clipper;
+	  	clipper->AddPath(input, ClipperLib::ptSubject, true);
+		clipper->ReverseSolution(reverse_result);
+		clipper->Execute(ClipperLib::ctUnion, solution, filltype, filltype);
 	}
     return solution;
 }
@@ -1350,16 +1435,16 @@ ClipperLib::Paths fix_after_inner_offset(
 {
   	ClipperLib::Paths solution;
   	if (! input.empty()) {
-		ClipperLib::Clipper clipper;
-		clipper.AddPath(input, ClipperLib::ptSubject, true);
-		ClipperLib::IntRect r = clipper.GetBounds();
+		ClipperUtils::ReusedClipper clipper;
+		clipper->AddPath(input, ClipperLib::ptSubject, true);
+		ClipperLib::IntRect r = clipper->GetBounds();
 		r.left -= 10; r.top -= 10; r.right += 10; r.bottom += 10;
 		if (filltype == ClipperLib::pftPositive)
-			clipper.AddPath({ ClipperLib::IntPoint(r.left, r.bottom), ClipperLib::IntPoint(r.left, r.top), ClipperLib::IntPoint(r.right, r.top), ClipperLib::IntPoint(r.right, r.bottom) }, ClipperLib::ptSubject, true);
+			clipper->AddPath({ ClipperLib::IntPoint(r.left, r.bottom), ClipperLib::IntPoint(r.left, r.top), ClipperLib::IntPoint(r.right, r.top), ClipperLib::IntPoint(r.right, r.bottom) }, ClipperLib::ptSubject, true);
 		else
-			clipper.AddPath({ ClipperLib::IntPoint(r.left, r.bottom), ClipperLib::IntPoint(r.right, r.bottom), ClipperLib::IntPoint(r.right, r.top), ClipperLib::IntPoint(r.left, r.top) }, ClipperLib::ptSubject, true);
-		clipper.ReverseSolution(reverse_result);
-		clipper.Execute(ClipperLib::ctUnion, solution, filltype, filltype);
+			clipper->AddPath({ ClipperLib::IntPoint(r.left, r.bottom), ClipperLib::IntPoint(r.right, r.bottom), ClipperLib::IntPoint(r.right, r.top), ClipperLib::IntPoint(r.left, r.top) }, ClipperLib::ptSubject, true);
+		clipper->ReverseSolution(reverse_result);
+		clipper->Execute(ClipperLib::ctUnion, solution, filltype, filltype);
 		if (! solution.empty())
 			solution.erase(solution.begin());
 	}
@@ -1538,11 +1623,10 @@ Polygons variable_offset_inner(const ExPolygon &expoly, const std::vector<std::v
 	if (holes.empty())
 		output = std::move(contours);
 	else {
-		ClipperLib::Clipper clipper;
-		clipper.Clear();
-		clipper.AddPaths(contours, ClipperLib::ptSubject, true);
-		clipper.AddPaths(holes, ClipperLib::ptClip, true);
-		clipper.Execute(ClipperLib::ctDifference, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+		ClipperUtils::ReusedClipper clipper;
+		clipper->AddPaths(contours, ClipperLib::ptSubject, true);
+		clipper->AddPaths(holes, ClipperLib::ptClip, true);
+		clipper->Execute(ClipperLib::ctDifference, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
 	}
 
 	return to_polygons(std::move(output));
@@ -1580,11 +1664,10 @@ for (const std::vector<float>& ds : deltas)
 	if (holes.empty())
 		output = std::move(contours);
 	else {
-		ClipperLib::Clipper clipper;
-		clipper.Clear();
-		clipper.AddPaths(contours, ClipperLib::ptSubject, true);
-		clipper.AddPaths(holes, ClipperLib::ptClip, true);
-		clipper.Execute(ClipperLib::ctDifference, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+		ClipperUtils::ReusedClipper clipper;
+		clipper->AddPaths(contours, ClipperLib::ptSubject, true);
+		clipper->AddPaths(holes, ClipperLib::ptClip, true);
+		clipper->Execute(ClipperLib::ctDifference, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
 	}
 
 	return to_polygons(std::move(output));
@@ -1624,11 +1707,11 @@ for (const std::vector<float>& ds : deltas)
 		for (ClipperLib::Path &path : contours) 
 			output.emplace_back(std::move(path));
 	} else {
-		ClipperLib::Clipper clipper;
-		clipper.AddPaths(contours, ClipperLib::ptSubject, true);
-		clipper.AddPaths(holes, ClipperLib::ptClip, true);
+		ClipperUtils::ReusedClipper clipper;
+		clipper->AddPaths(contours, ClipperLib::ptSubject, true);
+		clipper->AddPaths(holes, ClipperLib::ptClip, true);
 	    ClipperLib::PolyTree polytree;
-		clipper.Execute(ClipperLib::ctDifference, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+		clipper->Execute(ClipperLib::ctDifference, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
 	    output = PolyTreeToExPolygons(std::move(polytree));
 	}
 
@@ -1676,11 +1759,11 @@ ExPolygons variable_offset_inner_ex(const ExPolygon &expoly, const std::vector<s
 		for (ClipperLib::Path &path : contours) 
 			output.emplace_back(std::move(path));
 	} else {
-		ClipperLib::Clipper clipper;
-		clipper.AddPaths(contours, ClipperLib::ptSubject, true);
-		clipper.AddPaths(holes, ClipperLib::ptClip, true);
+		ClipperUtils::ReusedClipper clipper;
+		clipper->AddPaths(contours, ClipperLib::ptSubject, true);
+		clipper->AddPaths(holes, ClipperLib::ptClip, true);
 	    ClipperLib::PolyTree polytree;
-		clipper.Execute(ClipperLib::ctDifference, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+		clipper->Execute(ClipperLib::ctDifference, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
 	    output = PolyTreeToExPolygons(std::move(polytree));
 	}
 
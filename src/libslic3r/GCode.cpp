@@ -14,6 +14,7 @@
 #include "ClipperUtils.hpp"
 #include "libslic3r.h"
 #include "LocalesUtils.hpp"
+#include "Thread.hpp"
 #include "libslic3r/format.hpp"
 
 #include <algorithm>
@@ -39,6 +40,7 @@
 
 #include "SVG.hpp"
 
+#include <tbb/concurrent_queue.h>
 #include <tbb/parallel_for.h>
 #include <tbb/task_scheduler_observer.h>
 #include <tbb/enumerable_thread_specific.h>
@@ -987,10 +989,17 @@ void GCode::do_export(Print* print, const char* path, GCodeProcessorResult* resu
     if(print->config().remaining_times)
         check_remaning_times(print->config().gcode_flavor, print->config().remaining_times_type, monitor);
 
+    // Don't write the G-code into the temp file if it can stay in memory: the post-process (to add the remaining times)
+    // writes it only once, instead of reading it back from the disk and writing it again.
+    file.keep_in_memory(size_t(print->config().gcode_memory_max_size.value) << 20);
+
     try {
         m_placeholder_parser.reset();
         m_placeholder_parser_failed_templates.clear();
         this->_do_export(*print, file, thumbnail_cb);
+        // The user needs the file to inspect the errors.
+        if (! m_placeholder_parser_failed_templates.empty())
+            file.spill_to_file();
         file.flush();
         if (file.is_error()) {
             file.close();
@@ -999,7 +1008,8 @@ void GCode::do_export(Print* print, const char* path, GCodeProcessorResult* resu
         }
     } catch (std::exception & /* ex */) {
         // Rethrow on any exception. std::runtime_exception and CanceledException are expected to be thrown.
-        // Close and remove the file.
+        // Close and remove the file. The G-code kept in memory is dropped without being written: the temp file is
+        // removed anyway, the partial output of a failed export is not kept for inspection in either mode.
         file.close();
         boost::nowide::remove(path_tmp.c_str());
         throw;
@@ -1023,7 +1033,11 @@ void GCode::do_export(Print* print, const char* path, GCodeProcessorResult* resu
 
     BOOST_LOG_TRIVIAL(debug) << "Start processing gcode, " << log_memory_info();
     // Post-process the G-code to update time stamps.
-    m_processor.finalize(true);
+    if (file.is_in_memory()) {
+        std::vector<std::string> gcode_in_memory = file.extract_memory();
+        m_processor.finalize(true, &gcode_in_memory);
+    } else
+        m_processor.finalize(true);
 //    DoExport::update_print_estimated_times_stats(m_processor, print->m_print_statistics);
     DoExport::update_print_estimated_stats(m_processor, m_writer.extruders(), print->config(), monitor.stats());
     if (result != nullptr) {
@@ -1413,6 +1427,7 @@ void GCode::_do_export(Print& print_mod, GCodeOutputStream &file, ThumbnailsGene
         file.set_find_replace(m_find_replace.get(), false);
     }
     file.set_only_ascii(print.config().gcode_ascii.value);
+    file.set_async(print.config().gcode_async_output.value);
 
     // resets analyzer's tracking data
     m_last_height  = 0.f;
@@ -2249,6 +2264,23 @@ private:
     tbb::enumerable_thread_specific<bool, tbb::cache_aligned_allocator<bool>, tbb::ets_key_usage_type::ets_key_per_instance> m_is_locales_sets{false};
 };
 
+// Release the layers below the layers just exported, the G-code export does not access them anymore, see Print::low_memory().
+// The object layers point to the layers below them, the support layers exported last are kept in last_support_layers.
+static void release_exported_layers(const std::vector<GCode::LayerToPrint> &layers, std::vector<const SupportLayer*> &last_support_layers)
+{
+    assert(layers.size() == last_support_layers.size());
+    for (size_t object_idx = 0; object_idx < layers.size(); ++ object_idx) {
+        const GCode::LayerToPrint &ltp = layers[object_idx];
+        if (ltp.object_layer != nullptr && ltp.object_layer->lower_layer != nullptr)
+            ltp.object_layer->lower_layer->release_exported_data();
+        if (ltp.support_layer != nullptr) {
+            if (last_support_layers[object_idx] != nullptr)
+                const_cast<SupportLayer*>(last_support_layers[object_idx])->release_exported_data();
+            last_support_layers[object_idx] = ltp.support_layer;
+        }
+    }
+}
+
 // Process all layers of all objects (non-sequential mode) with a parallel pipeline:
 // Generate G-code, run the filters (vase mode, cooling buffer), run the G-code analyser
 // and export G-code into file.
@@ -2263,31 +2295,50 @@ void GCode::process_layers(
 {
     // The pipeline is variable: The vase mode filter is optional.
     size_t layer_to_print_idx = 0;
-    const auto generator = tbb::make_filter<void, LayerResult>(slic3r_tbb_filtermode::serial_in_order,
-        [this, &print, &status_monitor, &tool_ordering, &print_object_instances_ordering, &layers_to_print, &layer_to_print_idx, &preamble](tbb::flow_control& fc) -> LayerResult {
-            CNumericLocalesSetter locales_setter;
-            if (layer_to_print_idx >= layers_to_print.size()) {
-                if ((!m_pressure_equalizer && layer_to_print_idx == layers_to_print.size()) || (m_pressure_equalizer && layer_to_print_idx == (layers_to_print.size() + 1))) {
-                    fc.stop();
-                    return LayerResult{};
-                } else {
-                    // Pressure equalizer need insert empty input. Because it returns one layer back.
-                    // Insert NOP (no operation) layer;
-                    ++layer_to_print_idx;
-                    LayerResult result = LayerResult::make_nop_layer_result();
-                    result.gcode = preamble;
-                    preamble.clear();
-                    return result;
+    const auto generator = tbb::make_filter<void, LayerToProcess>(slic3r_tbb_filtermode::serial_in_order,
+        [this, &layers_to_print, &layer_to_print_idx](tbb::flow_control& fc) -> LayerToProcess {
+            // Pressure equalizer need insert empty input. Because it returns one layer back.
+            if (layer_to_print_idx == layers_to_print.size() + (m_pressure_equalizer ? 1 : 0)) {
+                fc.stop();
+                return {};
+            }
+            return { layer_to_print_idx ++, nullptr };
+        });
+    // Group the extrusions of the next layers in parallel, while process_layer() is busy with the current one.
+    const auto prepare = tbb::make_filter<LayerToProcess, LayerToProcess>(slic3r_tbb_filtermode::parallel,
+        [this, &print, &tool_ordering, &layers_to_print](LayerToProcess in) -> LayerToProcess {
+            if (in.idx < layers_to_print.size()) {
+                const LayerTools &layer_tools = tool_ordering.tools_for_layer(layers_to_print[in.idx].first);
+                // Resolving the wiping overrides modifies the LayerTools, leave it to the serial stage.
+                if (! layer_tools.wiping_extrusions().is_anything_overridden()) {
+                    this->m_throw_if_canceled();
+                    in.by_extruder = std::make_shared<ObjectsByExtruder>(group_extrusions_by_extruder(print, layers_to_print[in.idx].second, layer_tools));
                 }
+            }
+            return in;
+        });
+    // In low memory mode, the layers are released as soon as the layers above them are exported.
+    std::vector<const SupportLayer*> last_support_layers(print.objects().size(), nullptr);
+    const auto process = tbb::make_filter<LayerToProcess, LayerResult>(slic3r_tbb_filtermode::serial_in_order,
+        [this, &print, &status_monitor, &tool_ordering, &print_object_instances_ordering, &layers_to_print, &preamble, &last_support_layers](LayerToProcess in) -> LayerResult {
+            CNumericLocalesSetter locales_setter;
+            if (in.idx >= layers_to_print.size()) {
+                // Insert NOP (no operation) layer;
+                LayerResult result = LayerResult::make_nop_layer_result();
+                result.gcode = preamble;
+                preamble.clear();
+                return result;
             } else {
-                const std::pair<coordf_t, std::vector<LayerToPrint>>& layer = layers_to_print[layer_to_print_idx++];
+                const std::pair<coordf_t, std::vector<LayerToPrint>>& layer = layers_to_print[in.idx];
                 const LayerTools& layer_tools = tool_ordering.tools_for_layer(layer.first);
                 if (m_wipe_tower && layer_tools.has_wipe_tower)
                     m_wipe_tower->next_layer();
                  this->m_throw_if_canceled();
                 LayerResult result = this->process_layer(print, status_monitor, layer.second, layer_tools,
                                                          &layer == &layers_to_print.back(),
-                                                         &print_object_instances_ordering, size_t(-1));
+                                                         &print_object_instances_ordering, size_t(-1), in.by_extruder.get());
+                if (print.low_memory())
+                    release_exported_layers(layer.second, last_support_layers);
                 result.gcode = preamble + result.gcode;
                 preamble.clear();
                 return result;
@@ -2355,7 +2406,7 @@ void GCode::process_layers(
 
     // The pipeline elements are joined using const references, thus no copying is performed.
     output_stream.find_replace_supress();
-    tbb::filter<void, LayerResult> pipeline_to_layerresult = generator;
+    tbb::filter<void, LayerResult> pipeline_to_layerresult = generator & prepare & process;
     if (m_spiral_vase)
         pipeline_to_layerresult = pipeline_to_layerresult & spiral_vase;
     if (m_pressure_equalizer)
@@ -2382,28 +2433,44 @@ void GCode::process_layers(
 {
     // The pipeline is variable: The vase mode filter is optional.
     size_t layer_to_print_idx = 0;
-    const auto generator = tbb::make_filter<void, LayerResult>(slic3r_tbb_filtermode::serial_in_order,
-        [this, &print, &status_monitor, &tool_ordering, &layers_to_print, &layer_to_print_idx, single_object_idx, &preamble](tbb::flow_control& fc) -> LayerResult {
-            if (layer_to_print_idx >= layers_to_print.size()) {
-                if ((!m_pressure_equalizer && layer_to_print_idx == layers_to_print.size()) || (m_pressure_equalizer && layer_to_print_idx == (layers_to_print.size() + 1))) {
+    const auto generator = tbb::make_filter<void, LayerToProcess>(slic3r_tbb_filtermode::serial_in_order,
+        [this, &layers_to_print, &layer_to_print_idx](tbb::flow_control& fc) -> LayerToProcess {
+            // Pressure equalizer need insert empty input. Because it returns one layer back.
+            if (layer_to_print_idx == layers_to_print.size() + (m_pressure_equalizer ? 1 : 0)) {
                 fc.stop();
                 return {};
-            } else {
-                    // Pressure equalizer need insert empty input. Because it returns one layer back.
-                    // Insert NOP (no operation) layer;
-                    ++layer_to_print_idx;
-                    LayerResult result = LayerResult::make_nop_layer_result();
-                    result.gcode = preamble;
-                    preamble.clear();
-                    return result;
+            }
+            return { layer_to_print_idx ++, nullptr };
+        });
+    // Group the extrusions of the next layers in parallel, while process_layer() is busy with the current one.
+    const auto prepare = tbb::make_filter<LayerToProcess, LayerToProcess>(slic3r_tbb_filtermode::parallel,
+        [this, &print, &tool_ordering, &layers_to_print](LayerToProcess in) -> LayerToProcess {
+            if (in.idx < layers_to_print.size()) {
+                const LayerToPrint &layer      = layers_to_print[in.idx];
+                const LayerTools   &layer_tools = tool_ordering.tools_for_layer(layer.print_z());
+                // Resolving the wiping overrides modifies the LayerTools, leave it to the serial stage.
+                if (! layer_tools.wiping_extrusions().is_anything_overridden()) {
+                    this->m_throw_if_canceled();
+                    in.by_extruder = std::make_shared<ObjectsByExtruder>(group_extrusions_by_extruder(print, { layer }, layer_tools));
                 }
+            }
+            return in;
+        });
+    const auto process = tbb::make_filter<LayerToProcess, LayerResult>(slic3r_tbb_filtermode::serial_in_order,
+        [this, &print, &status_monitor, &tool_ordering, &layers_to_print, single_object_idx, &preamble](LayerToProcess in) -> LayerResult {
+            if (in.idx >= layers_to_print.size()) {
+                // Insert NOP (no operation) layer;
+                LayerResult result = LayerResult::make_nop_layer_result();
+                result.gcode = preamble;
+                preamble.clear();
+                return result;
             } else {
-                LayerToPrint &layer = layers_to_print[layer_to_print_idx ++];
+                const LayerToPrint &layer = layers_to_print[in.idx];
                  this->m_throw_if_canceled();
-                LayerResult result = this->process_layer(print, status_monitor, {std::move(layer)},
+                LayerResult result = this->process_layer(print, status_monitor, { layer },
                                                          tool_ordering.tools_for_layer(layer.print_z()),
                                                          &layer == &layers_to_print.back(), nullptr,
-                                                         single_object_idx);
+                                                         single_object_idx, in.by_extruder.get());
                 result.gcode = preamble + result.gcode;
                 preamble.clear();
                 return result;
@@ -2466,7 +2533,7 @@ void GCode::process_layers(
 
     // The pipeline elements are joined using const references, thus no copying is performed.
     output_stream.find_replace_supress();
-    tbb::filter<void, LayerResult> pipeline_to_layerresult = generator;
+    tbb::filter<void, LayerResult> pipeline_to_layerresult = generator & prepare & process;
     if (m_spiral_vase)
         pipeline_to_layerresult = pipeline_to_layerresult & spiral_vase;
     if (m_pressure_equalizer)
@@ -2988,6 +3055,181 @@ namespace Skirt {
 
 } // namespace Skirt
 
+// Group extrusions by an extruder, then by an object, an island and a region.
+// The result depends only on the layers and on the tool ordering, not on the state of the G-code generator,
+// thus process_layers() may compute it for several layers ahead in parallel.
+GCode::ObjectsByExtruder GCode::group_extrusions_by_extruder(
+    const Print                             &print,
+    // Set of object & print layers of the same PrintObject and with the same print_z.
+    const std::vector<LayerToPrint>         &layers,
+    const LayerTools                        &layer_tools)
+{
+    ObjectsByExtruder by_extruder;
+    if (layer_tools.extruders.empty())
+        // Nothing to extrude.
+        return by_extruder;
+    uint16_t first_extruder_id = layer_tools.extruders.front();
+    bool is_anything_overridden = layer_tools.wiping_extrusions().is_anything_overridden();
+    for (const LayerToPrint &layer_to_print : layers) {
+        if (layer_to_print.support_layer != nullptr) {
+            const SupportLayer &support_layer = *layer_to_print.support_layer;
+            const PrintObject  &object = *support_layer.object();
+            if (! support_layer.support_fills.entities().empty()) {
+                ExtrusionRole   role               = support_layer.support_fills.role();
+                bool            has_support        = role == erMixed || role == erSupportMaterial;
+                bool            has_interface      = role == erMixed || role == erSupportMaterialInterface;
+                // Extruder ID of the support base. -1 if "don't care".
+                uint16_t    support_extruder   = object.config().support_material_extruder.value - 1;
+                // Shall the support be printed with the active extruder, preferably with non-soluble, to avoid tool changes?
+                bool            support_dontcare   = object.config().support_material_extruder.value == 0;
+                // Extruder ID of the support interface. -1 if "don't care".
+                uint16_t    interface_extruder = object.config().support_material_interface_extruder.value - 1;
+                // Shall the support interface be printed with the active extruder, preferably with non-soluble, to avoid tool changes?
+                bool            interface_dontcare = object.config().support_material_interface_extruder.value == 0;
+                if (support_dontcare || interface_dontcare) {
+                    // Some support will be printed with "don't care" material, preferably non-soluble.
+                    // Is the current extruder assigned a soluble filament?
+                    uint16_t dontcare_extruder = first_extruder_id;
+                    if (print.config().filament_soluble.get_at(dontcare_extruder)) {
+                        // The last extruder printed on the previous layer extrudes soluble filament.
+                        // Try to find a non-soluble extruder on the same layer.
+                        for (uint16_t extruder_id : layer_tools.extruders)
+                            if (! print.config().filament_soluble.get_at(extruder_id)) {
+                                dontcare_extruder = extruder_id;
+                                break;
+                            }
+                    }
+                    if (support_dontcare)
+                        support_extruder = dontcare_extruder;
+                    if (interface_dontcare)
+                        interface_extruder = dontcare_extruder;
+                }
+                // Both the support and the support interface are printed with the same extruder, therefore
+                // the interface may be interleaved with the support base.
+                bool single_extruder = ! has_support || support_extruder == interface_extruder;
+                // Assign an extruder to the base.
+                ObjectByExtruder &obj = object_by_extruder(by_extruder, has_support ? support_extruder : interface_extruder, &layer_to_print - layers.data(), layers.size());
+                obj.support = &support_layer.support_fills;
+                obj.support_extrusion_role = single_extruder ? erMixed : erSupportMaterial;
+                if (! single_extruder && has_interface) {
+                    ObjectByExtruder &obj_interface = object_by_extruder(by_extruder, interface_extruder, &layer_to_print - layers.data(), layers.size());
+                    obj_interface.support = &support_layer.support_fills;
+                    obj_interface.support_extrusion_role = erSupportMaterialInterface;
+                }
+            }
+        }
+        if (layer_to_print.object_layer != nullptr) {
+            const Layer &layer = *layer_to_print.object_layer;
+            // We now define a strategy for building perimeters and fills. The separation
+            // between regions doesn't matter in terms of printing order, as we follow
+            // another logic instead:
+            // - we group all extrusions by extruder so that we minimize toolchanges
+            // - we start from the last used extruder
+            // - for each extruder, we group extrusions by island
+            // - for each island, we extrude perimeters first, unless user set the infill_first
+            //   option
+            // (Still, we have to keep track of regions because we need to apply their config)
+            size_t n_slices = layer.lslices.size();
+            const std::vector<BoundingBox> &layer_surface_bboxes = layer.lslices_bboxes;
+            // Traverse the slices in an increasing order of bounding box size, so that the islands inside another islands are tested first,
+            // so we can just test a point inside ExPolygon::contour and we may skip testing the holes.
+            std::vector<size_t> slices_test_order;
+            slices_test_order.reserve(n_slices);
+            for (size_t i = 0; i < n_slices; ++ i)
+                slices_test_order.emplace_back(i);
+            std::sort(slices_test_order.begin(), slices_test_order.end(), [&layer_surface_bboxes](size_t i, size_t j) {
+                const Vec2d s1 = layer_surface_bboxes[i].size().cast<double>();
+                const Vec2d s2 = layer_surface_bboxes[j].size().cast<double>();
+                return s1.x() * s1.y() < s2.x() * s2.y();
+            });
+            auto point_inside_surface = [&layer, &layer_surface_bboxes](const size_t i, const Point &point) {
+                const BoundingBox &bbox = layer_surface_bboxes[i];
+                return point(0) >= bbox.min(0) && point(0) < bbox.max(0) &&
+                       point(1) >= bbox.min(1) && point(1) < bbox.max(1) &&
+                       layer.lslices[i].contour.contains(point);
+            };
+
+            for (size_t region_id = 0; region_id < layer.regions().size(); ++ region_id) {
+                const LayerRegion *layerm = layer.regions()[region_id];
+                if (layerm == nullptr)
+                    continue;
+                // PrintObjects own the PrintRegions, thus the pointer to PrintRegion would be unique to a PrintObject, they would not
+                // identify the content of PrintRegion accross the whole print uniquely. Translate to a Print specific PrintRegion.
+                const PrintRegion &region = print.get_print_region(layerm->region().print_region_id());
+
+                // Now we must process perimeters and infills and create islands of extrusions in by_region std::map.
+                // It is also necessary to save which extrusions are part of MM wiping and which are not.
+                // The process is almost the same for perimeters and infills - we will do it in a cycle that repeats twice:
+                std::vector<uint16_t> printing_extruders;
+                auto process_entities = [&](ObjectByExtruder::Island::Region::Type entity_type, const ExtrusionEntitiesPtr& entities) {
+                    for (const ExtrusionEntity* ee : entities) {
+                        // extrusions represents infill or perimeter extrusions of a single island.
+                        assert(dynamic_cast<const ExtrusionEntityCollection*>(ee) != nullptr);
+                        const auto* extrusions = static_cast<const ExtrusionEntityCollection*>(ee);
+                        if (extrusions->entities().empty()) // This shouldn't happen but first_point() would fail.
+                            continue;
+
+                        // This extrusion is part of certain Region, which tells us which extruder should be used for it:
+                        int correct_extruder_id = layer_tools.extruder(*extrusions, region);
+
+                        // Let's recover vector of extruder overrides:
+                        const WipingExtrusions::ExtruderPerCopy* entity_overrides = nullptr;
+                        if (!layer_tools.has_extruder(correct_extruder_id)) {
+                            // this entity is not overridden, but its extruder is not in layer_tools - we'll print it
+                            // by last extruder on this layer (could happen e.g. when a wiping object is taller than others - dontcare extruders are eradicated from layer_tools)
+                            correct_extruder_id = layer_tools.extruders.back();
+                        }
+                        printing_extruders.clear();
+                        if (is_anything_overridden) {
+                            entity_overrides = const_cast<LayerTools&>(layer_tools).wiping_extrusions().get_extruder_overrides(extrusions, correct_extruder_id, layer_to_print.object()->instances().size());
+                            if (entity_overrides == nullptr) {
+                                printing_extruders.emplace_back(correct_extruder_id);
+                            } else {
+                                printing_extruders.reserve(entity_overrides->size());
+                                for (int extruder : *entity_overrides)
+                                    printing_extruders.emplace_back(extruder >= 0 ?
+                                        // at least one copy is overridden to use this extruder
+                                        extruder :
+                                        // at least one copy would normally be printed with this extruder (see get_extruder_overrides function for explanation)
+                                        static_cast<uint16_t>(-extruder - 1));
+                                Slic3r::sort_remove_duplicates(printing_extruders);
+                            }
+                        } else
+                            printing_extruders.emplace_back(correct_extruder_id);
+
+                        // Now we must add this extrusion into the by_extruder map, once for each extruder that will print it:
+                        for (uint16_t extruder : printing_extruders)
+                        {
+                            std::vector<ObjectByExtruder::Island>& islands = object_islands_by_extruder(
+                                by_extruder,
+                                extruder,
+                                &layer_to_print - layers.data(),
+                                layers.size(), n_slices + 1);
+                            for (size_t i = 0; i <= n_slices; ++i) {
+                                bool   last = i == n_slices;
+                                size_t island_idx = last ? n_slices : slices_test_order[i];
+                                if (// extrusions->first_point does not fit inside any slice
+                                    last ||
+                                    // extrusions->first_point fits inside ith slice
+                                    point_inside_surface(island_idx, extrusions->first_point())) {
+                                    if (islands[island_idx].by_region.empty())
+                                        islands[island_idx].by_region.assign(print.num_print_regions(), ObjectByExtruder::Island::Region());
+                                    islands[island_idx].by_region[region.print_region_id()].append(entity_type, extrusions, entity_overrides);
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                };
+                process_entities(ObjectByExtruder::Island::Region::INFILL, layerm->fills.entities());
+                process_entities(ObjectByExtruder::Island::Region::PERIMETERS, layerm->perimeters.entities());
+                process_entities(ObjectByExtruder::Island::Region::IRONING, layerm->ironings.entities());
+            } // for regions
+        }
+    } // for objects
+    return by_extruder;
+}
+
 // Matches "G92 E0" with various forms of writing the zero and with an optional comment.
 std::regex regex_g92e0_gcode{ "^[ \\t]*[gG]92[ \\t]*[eE](0(\\.0*)?|\\.0+)[ \\t]*(;.*)?$" };
 
@@ -3007,7 +3249,9 @@ LayerResult GCode::process_layer(
     const std::vector<const PrintInstance*> *ordering,
     // If set to size_t(-1), then print all copies of all objects.
     // Otherwise print a single copy of a single object.
-    const size_t                     		 single_object_instance_idx)
+    const size_t                     		 single_object_instance_idx,
+    // Extrusions grouped by group_extrusions_by_extruder() ahead of time, or null to group them here.
+    ObjectsByExtruder                       *by_extruder_prepared)
 {
     assert(!layers.empty());
     // Either printing all copies of all objects, or just a single copy of a single object.
@@ -3180,165 +3424,14 @@ LayerResult GCode::process_layer(
         Skirt::make_skirt_loops_per_extruder_other_layers(print, layer_tools, m_skirt_done);
 
     // Group extrusions by an extruder, then by an object, an island and a region.
-    std::map<uint16_t, std::vector<ObjectByExtruder>> by_extruder;
-    bool is_anything_overridden = const_cast<LayerTools&>(layer_tools).wiping_extrusions().is_anything_overridden();
-    for (const LayerToPrint &layer_to_print : layers) {
-        if (layer_to_print.support_layer != nullptr) {
-            const SupportLayer &support_layer = *layer_to_print.support_layer;
-            const PrintObject  &object = *support_layer.object();
-            if (! support_layer.support_fills.entities().empty()) {
-                ExtrusionRole   role               = support_layer.support_fills.role();
-                bool            has_support        = role == erMixed || role == erSupportMaterial;
-                bool            has_interface      = role == erMixed || role == erSupportMaterialInterface;
-                // Extruder ID of the support base. -1 if "don't care".
-                uint16_t    support_extruder   = object.config().support_material_extruder.value - 1;
-                // Shall the support be printed with the active extruder, preferably with non-soluble, to avoid tool changes?
-                bool            support_dontcare   = object.config().support_material_extruder.value == 0;
-                // Extruder ID of the support interface. -1 if "don't care".
-                uint16_t    interface_extruder = object.config().support_material_interface_extruder.value - 1;
-                // Shall the support interface be printed with the active extruder, preferably with non-soluble, to avoid tool changes?
-                bool            interface_dontcare = object.config().support_material_interface_extruder.value == 0;
-                if (support_dontcare || interface_dontcare) {
-                    // Some support will be printed with "don't care" material, preferably non-soluble.
-                    // Is the current extruder assigned a soluble filament?
-                    uint16_t dontcare_extruder = first_extruder_id;
-                    if (print.config().filament_soluble.get_at(dontcare_extruder)) {
-                        // The last extruder printed on the previous layer extrudes soluble filament.
-                        // Try to find a non-soluble extruder on the same layer.
-                        for (uint16_t extruder_id : layer_tools.extruders)
-                            if (! print.config().filament_soluble.get_at(extruder_id)) {
-                                dontcare_extruder = extruder_id;
-                                break;
-                            }
-                    }
-                    if (support_dontcare)
-                        support_extruder = dontcare_extruder;
-                    if (interface_dontcare)
-                        interface_extruder = dontcare_extruder;
-                }
-                // Both the support and the support interface are printed with the same extruder, therefore
-                // the interface may be interleaved with the support base.
-                bool single_extruder = ! has_support || support_extruder == interface_extruder;
-                // Assign an extruder to the base.
-                ObjectByExtruder &obj = object_by_extruder(by_extruder, has_support ? support_extruder : interface_extruder, &layer_to_print - layers.data(), layers.size());
-                obj.support = &support_layer.support_fills;
-                obj.support_extrusion_role = single_extruder ? erMixed : erSupportMaterial;
-                if (! single_extruder && has_interface) {
-                    ObjectByExtruder &obj_interface = object_by_extruder(by_extruder, interface_extruder, &layer_to_print - layers.data(), layers.size());
-                    obj_interface.support = &support_layer.support_fills;
-                    obj_interface.support_extrusion_role = erSupportMaterialInterface;
-                }
-            }
-        }
-        if (layer_to_print.object_layer != nullptr) {
-            const Layer &layer = *layer_to_print.object_layer;
-            // We now define a strategy for building perimeters and fills. The separation
-            // between regions doesn't matter in terms of printing order, as we follow
-            // another logic instead:
-            // - we group all extrusions by extruder so that we minimize toolchanges
-            // - we start from the last used extruder
-            // - for each extruder, we group extrusions by island
-            // - for each island, we extrude perimeters first, unless user set the infill_first
-            //   option
-            // (Still, we have to keep track of regions because we need to apply their config)
-            size_t n_slices = layer.lslices.size();
-            const std::vector<BoundingBox> &layer_surface_bboxes = layer.lslices_bboxes;
-            // Traverse the slices in an increasing order of bounding box size, so that the islands inside another islands are tested first,
-            // so we can just test a point inside ExPolygon::contour and we may skip testing the holes.
-            std::vector<size_t> slices_test_order;
-            slices_test_order.reserve(n_slices);
-            for (size_t i = 0; i < n_slices; ++ i)
-                slices_test_order.emplace_back(i);
-            std::sort(slices_test_order.begin(), slices_test_order.end(), [&layer_surface_bboxes](size_t i, size_t j) {
-                const Vec2d s1 = layer_surface_bboxes[i].size().cast<double>();
-                const Vec2d s2 = layer_surface_bboxes[j].size().cast<double>();
-                return s1.x() * s1.y() < s2.x() * s2.y();
-            });
-            auto point_inside_surface = [&layer, &layer_surface_bboxes](const size_t i, const Point &point) {
-                const BoundingBox &bbox = layer_surface_bboxes[i];
-                return point(0) >= bbox.min(0) && point(0) < bbox.max(0) &&
-                       point(1) >= bbox.min(1) && point(1) < bbox.max(1) &&
-                       layer.lslices[i].contour.contains(point);
-            };
-
-            for (size_t region_id = 0; region_id < layer.regions().size(); ++ region_id) {
-                const LayerRegion *layerm = layer.regions()[region_id];
-                if (layerm == nullptr)
-                    continue;
-                // PrintObjects own the PrintRegions, thus the pointer to PrintRegion would be unique to a PrintObject, they would not
-                // identify the content of PrintRegion accross the whole print uniquely. Translate to a Print specific PrintRegion.
-                const PrintRegion &region = print.get_print_region(layerm->region().print_region_id());
-
-                // Now we must process perimeters and infills and create islands of extrusions in by_region std::map.
-                // It is also necessary to save which extrusions are part of MM wiping and which are not.
-                // The process is almost the same for perimeters and infills - we will do it in a cycle that repeats twice:
-                std::vector<uint16_t> printing_extruders;
-                auto process_entities = [&](ObjectByExtruder::Island::Region::Type entity_type, const ExtrusionEntitiesPtr& entities) {
-                    for (const ExtrusionEntity* ee : entities) {
-                        // extrusions represents infill or perimeter extrusions of a single island.
-                        assert(dynamic_cast<const ExtrusionEntityCollection*>(ee) != nullptr);
-                        const auto* extrusions = static_cast<const ExtrusionEntityCollection*>(ee);
-                        if (extrusions->entities().empty()) // This shouldn't happen but first_point() would fail.
-                            continue;
-
-                        // This extrusion is part of certain Region, which tells us which extruder should be used for it:
-                        int correct_extruder_id = layer_tools.extruder(*extrusions, region);
-
-                        // Let's recover vector of extruder overrides:
-                        const WipingExtrusions::ExtruderPerCopy* entity_overrides = nullptr;
-                        if (!layer_tools.has_extruder(correct_extruder_id)) {
-                            // this entity is not overridden, but its extruder is not in layer_tools - we'll print it
-                            // by last extruder on this layer (could happen e.g. when a wiping object is taller than others - dontcare extruders are eradicated from layer_tools)
-                            correct_extruder_id = layer_tools.extruders.back();
-                        }
-                        printing_extruders.clear();
-                        if (is_anything_overridden) {
-                            entity_overrides = const_cast<LayerTools&>(layer_tools).wiping_extrusions().get_extruder_overrides(extrusions, correct_extruder_id, layer_to_print.object()->instances().size());
-                            if (entity_overrides == nullptr) {
-                                printing_extruders.emplace_back(correct_extruder_id);
-                            } else {
-                                printing_extruders.reserve(entity_overrides->size());
-                                for (int extruder : *entity_overrides)
-                                    printing_extruders.emplace_back(extruder >= 0 ?
-                                        // at least one copy is overridden to use this extruder
-                                        extruder :
-                                        // at least one copy would normally be printed with this extruder (see get_extruder_overrides function for explanation)
-                                        static_cast<uint16_t>(-extruder - 1));
-                                Slic3r::sort_remove_duplicates(printing_extruders);
-                            }
-                        } else
-                            printing_extruders.emplace_back(correct_extruder_id);
-
-                        // Now we must add this extrusion into the by_extruder map, once for each extruder that will print it:
-                        for (uint16_t extruder : printing_extruders)
-                        {
-                            std::vector<ObjectByExtruder::Island>& islands = object_islands_by_extruder(
-                                by_extruder,
-                                extruder,
-                                &layer_to_print - layers.data(),
-                                layers.size(), n_slices + 1);
-                            for (size_t i = 0; i <= n_slices; ++i) {
-                                bool   last = i == n_slices;
-                                size_t island_idx = last ? n_slices : slices_test_order[i];
-                                if (// extrusions->first_point does not fit inside any slice
-                                    last ||
-                                    // extrusions->first_point fits inside ith slice
-                                    point_inside_surface(island_idx, extrusions->first_point())) {
-                                    if (islands[island_idx].by_region.empty())
-                                        islands[island_idx].by_region.assign(print.num_print_regions(), ObjectByExtruder::Island::Region());
-                                    islands[island_idx].by_region[region.print_region_id()].append(entity_type, extrusions, entity_overrides);
-                                    break;
-                                }
-                            }
-                        }
-                    }
-                };
-                process_entities(ObjectByExtruder::Island::Region::INFILL, layerm->fills.entities());
-                process_entities(ObjectByExtruder::Island::Region::PERIMETERS, layerm->perimeters.entities());
-                process_entities(ObjectByExtruder::Island::Region::IRONING, layerm->ironings.entities());
-            } // for regions
-        }
-    } // for objects
+    // The grouping may already have been computed by the parallel stage of process_layers().
+    ObjectsByExtruder by_extruder_local;
+    if (by_extruder_prepared == nullptr) {
+        by_extruder_local = group_extrusions_by_extruder(print, layers, layer_tools);
+        by_extruder_prepared = &by_extruder_local;
+    }
+    ObjectsByExtruder &by_extruder = *by_extruder_prepared;
+    bool is_anything_overridden = layer_tools.wiping_extrusions().is_anything_overridden();
 
     // Extrude the skirt, brim, support, perimeters, infill ordered by the extruders.
     for (uint16_t extruder_id : layer_tools.extruders)
@@ -3974,7 +4067,7 @@ std::string GCode::extrude_loop_vase(const ExtrusionLoop &original_loop, const s
             if (path == paths.begin() && step == Step::INCR){
                 if (paths.back().role() == erExternalPerimeter && m_layer != NULL && m_config.perimeters.value > 1 && paths.front().size() >= 2 && paths.back().polyline.size() >= 3) {
                     paths[0].polyline.clip_first_point();
-                    gcode += m_writer.extrude_to_xy(this->point_to_gcode(paths[0].polyline.front()), 0);
+                    m_writer.extrude_to_xy(gcode, this->point_to_gcode(paths[0].polyline.front()), 0);
                 }
             }
 
@@ -3999,11 +4092,11 @@ std::string GCode::extrude_loop_vase(const ExtrusionLoop &original_loop, const s
                     coordf_t current_height_internal = current_height + height_increment / 2;
                     //ensure you go to the good xyz
                     if( (last_point - previous).norm() > EPSILON)
-                        gcode += m_writer.extrude_to_xyz(last_point, 0, description);
+                        m_writer.extrude_to_xyz(gcode, last_point, 0, description);
                     //extrusions
                     for (int i = 0; i < nb_sections - 1; i++) {
                         Vec3d new_point = last_point + pos_increment;
-                        gcode += m_writer.extrude_to_xyz(new_point,
+                        m_writer.extrude_to_xyz(gcode, new_point,
                             e_per_mm_per_height * (line_length / nb_sections) * current_height_internal,
                             description);
                         current_height_internal += height_increment;
@@ -4013,7 +4106,7 @@ std::string GCode::extrude_loop_vase(const ExtrusionLoop &original_loop, const s
                     last_point.x() = this->point_to_gcode(line.b).x();
                     last_point.y() = this->point_to_gcode(line.b).y();
                     last_point.z() = current_z + z_per_length * line_length;
-                    gcode += m_writer.extrude_to_xyz(
+                    m_writer.extrude_to_xyz(gcode,
                         last_point,
                         e_per_mm_per_height * (line_length / nb_sections) * current_height_internal,
                         comment);
@@ -4089,7 +4182,7 @@ std::string GCode::extrude_loop_vase(const ExtrusionLoop &original_loop, const s
         inward_point.rotate(angle, paths.front().polyline.front());
         
         // generate the travel move
-        gcode += m_writer.travel_to_xy(this->point_to_gcode(inward_point), 0.0, "move inwards before travel");
+        m_writer.travel_to_xy(gcode, this->point_to_gcode(inward_point), 0.0, "move inwards before travel");
     }
 
     return gcode;
@@ -4824,7 +4917,7 @@ std::string GCode::extrude_loop(const ExtrusionLoop &original_loop, const std::s
                         gcode += start_wipe;
                         start_wipe = "";
                     }
-                    gcode += m_writer.travel_to_xy(this->point_to_gcode(pt), 0.0, config().gcode_comments ? "; extra wipe" : "");
+                    m_writer.travel_to_xy(gcode, this->point_to_gcode(pt), 0.0, config().gcode_comments ? "; extra wipe" : "");
                     this->set_last_pos(pt);
                 }
             }
@@ -4878,7 +4971,7 @@ std::string GCode::extrude_loop(const ExtrusionLoop &original_loop, const std::s
                     start_wipe = "";
                 }
                 // generate the travel move
-                gcode += m_writer.travel_to_xy(this->point_to_gcode(pt_inside), 0.0, "move inwards before travel");
+                m_writer.travel_to_xy(gcode, this->point_to_gcode(pt_inside), 0.0, "move inwards before travel");
                 this->set_last_pos(pt_inside);
             } else {
                 // also shift the wipe on retract if wipe_inside_end
@@ -5055,7 +5148,7 @@ std::string GCode::extrude_loop(const ExtrusionLoop &original_loop, const std::s
                     start_wipe = "";
                 }
                 // generate the travel move
-                gcode += m_writer.travel_to_xy(this->point_to_gcode(start_point), 0.0, "move inwards before wipe");
+                m_writer.travel_to_xy(gcode, this->point_to_gcode(start_point), 0.0, "move inwards before wipe");
                 this->set_last_pos(start_point);
             }
 
@@ -5147,7 +5240,7 @@ std::string GCode::extrude_multi_path3D(const ExtrusionMultiPath3D &multipath3D,
                 Line line(path.polyline.get_points()[i], path.polyline.get_points()[i + 1]);
                 const double line_length = line.length() * SCALING_FACTOR;
                 path_length += line_length;
-                gcode += m_writer.extrude_to_xyz(
+                m_writer.extrude_to_xyz(gcode,
                     this->point_to_gcode(line.b, path.z_offsets.size()>i+1 ? path.z_offsets[i+1] : 0),
                     e_per_mm * line_length,
                     comment);
@@ -5269,7 +5362,7 @@ std::string GCode::extrude_path_3D(const ExtrusionPath3D &path, const std::strin
             Line line(path.polyline.get_points()[i], path.polyline.get_points()[i + 1]);
             const double line_length = line.length() * SCALING_FACTOR;
             path_length += line_length;
-            gcode += m_writer.extrude_to_xyz(
+            m_writer.extrude_to_xyz(gcode,
                 this->point_to_gcode(line.b, path.z_offsets.size()>i ? path.z_offsets[i] : 0),
                 e_per_mm * line_length,
                 comment);
@@ -5399,6 +5492,114 @@ std::string GCode::extrude_support(const ExtrusionEntitiesPtr &support_fills)
 
 
 
+// Threads of GCodeOutputStream::set_async(). Each buffer is queued to both of them.
+struct GCode::GCodeOutputStream::AsyncStages
+{
+    struct Stage
+    {
+        tbb::concurrent_bounded_queue<std::shared_ptr<const std::string>> queue;
+        boost::thread      thread;
+        // Set if the stage failed, the following buffers are then dropped.
+        std::exception_ptr exception;
+    };
+    // Size of the buffers handed over to the threads.
+    static constexpr size_t buffer_size    = 1024 * 1024;
+    // Maximum number of buffers waiting in a queue.
+    static constexpr size_t queue_capacity = 16;
+
+    Stage             writer;
+    Stage             processor;
+    bool              running { false };
+    std::atomic<bool> discard { false };
+};
+
+GCode::GCodeOutputStream::GCodeOutputStream(FILE* f, GCodeProcessor& processor, GCode& gcodegen) : f(f), m_processor(processor), m_gcodegen(gcodegen) {}
+
+GCode::GCodeOutputStream::~GCodeOutputStream()
+{
+    this->close();
+}
+
+void GCode::GCodeOutputStream::set_async(bool async)
+{
+    if (async == bool(m_async))
+        return;
+    if (async) {
+        m_async = std::make_unique<AsyncStages>();
+        m_async->writer.queue.set_capacity(AsyncStages::queue_capacity);
+        m_async->processor.queue.set_capacity(AsyncStages::queue_capacity);
+    } else {
+        this->wait_async(false);
+        m_async.reset();
+    }
+}
+
+void GCode::GCodeOutputStream::hand_over_async_buffer()
+{
+    assert(m_async);
+    if (m_async_buffer.empty())
+        return;
+    if (! m_async->running) {
+        auto start = [this](AsyncStages::Stage &stage, const char *thread_name, std::function<void(const std::string&)> process) {
+            stage.exception = nullptr;
+            stage.thread = create_thread([this, &stage, thread_name, process]() {
+                set_current_thread_name(thread_name);
+                // for the sprintfs & the G-code parsing. Scoped, as a thread is started for each export: the locale is freed
+                // when the thread ends.
+                CNumericLocalesSetter locales_setter;
+                for (;;) {
+                    std::shared_ptr<const std::string> buffer;
+                    stage.queue.pop(buffer);
+                    if (! buffer)
+                        break;
+                    if (stage.exception || m_async->discard)
+                        // Keep emptying the queue, to not block write().
+                        continue;
+                    try {
+                        process(*buffer);
+                    } catch (...) {
+                        stage.exception = std::current_exception();
+                    }
+                }
+            });
+        };
+        m_async->discard = false;
+        start(m_async->writer, "slic3r_gcode_writer", [this](const std::string &gcode) { this->write_to_file(gcode); });
+        start(m_async->processor, "slic3r_gcode_processor", [this](const std::string &gcode) { m_processor.process_buffer(gcode); });
+        m_async->running = true;
+    }
+    auto buffer = std::make_shared<const std::string>(std::move(m_async_buffer));
+    m_async_buffer = std::string();
+    // Blocks while a queue is full.
+    m_async->writer.queue.push(buffer);
+    m_async->processor.queue.push(std::move(buffer));
+}
+
+void GCode::GCodeOutputStream::wait_async(bool discard)
+{
+    if (! m_async)
+        return;
+    if (discard) {
+        m_async_buffer.clear();
+        m_async->discard = true;
+    } else
+        this->hand_over_async_buffer();
+    if (m_async->running) {
+        // An empty buffer stops the thread.
+        m_async->writer.queue.push(nullptr);
+        m_async->processor.queue.push(nullptr);
+        m_async->writer.thread.join();
+        m_async->processor.thread.join();
+        m_async->running = false;
+        for (AsyncStages::Stage *stage : { &m_async->writer, &m_async->processor })
+            if (std::exception_ptr ex = stage->exception; ex) {
+                stage->exception = nullptr;
+                if (! discard)
+                    std::rethrow_exception(ex);
+            }
+    }
+}
+
 bool GCode::GCodeOutputStream::is_error() const 
 {
     return ::ferror(this->f);
@@ -5406,6 +5607,7 @@ bool GCode::GCodeOutputStream::is_error() const
 
 void GCode::GCodeOutputStream::flush()
 {
+    this->wait_async(false);
     // allow preproc to flush if they retain strings.
     //std::string str_preproc;
     //m_gcodegen._post_process(str_preproc, true);
@@ -5422,6 +5624,8 @@ void GCode::GCodeOutputStream::flush()
 
 void GCode::GCodeOutputStream::close()
 { 
+    // flush() was already called if the export succeeded, anything left is from a failed / canceled export.
+    this->wait_async(true);
     if (this->f) {
         ::fclose(this->f);
         this->f = nullptr;
@@ -5436,12 +5640,55 @@ void GCode::GCodeOutputStream::write(const char *what)
         if (m_only_ascii) {
             remove_not_ascii(gcode);
         }
+        if (m_async) {
+            if (m_async_buffer.empty())
+                m_async_buffer = std::move(gcode);
+            else
+                m_async_buffer += gcode;
+            if (m_async_buffer.size() >= AsyncStages::buffer_size)
+                this->hand_over_async_buffer();
+        } else {
+            this->write_to_file(gcode);
+            m_processor.process_buffer(gcode);
+        }
+    }
+}
+
+void GCode::GCodeOutputStream::write_to_file(const std::string &gcode)
+{
+    if (this->is_in_memory()) {
+        // Big chunks, to avoid both a reallocation of the whole G-code and a lot of small allocations.
+        static constexpr size_t chunk_size = 4 * 1024 * 1024;
+        if (m_memory_chunks.empty() || m_memory_chunks.back().size() + gcode.size() > chunk_size) {
+            m_memory_chunks.emplace_back();
+            m_memory_chunks.back().reserve(std::max(chunk_size, gcode.size()));
+        }
+        m_memory_chunks.back() += gcode;
+        m_memory_size += gcode.size();
+        if (m_memory_size > m_memory_max_size)
+            this->spill_memory_to_file();
+    } else {
         // writes string to file
         fwrite(gcode.c_str(), 1, gcode.size(), this->f);
-        m_processor.process_buffer(gcode);
     }
 }
 
+void GCode::GCodeOutputStream::spill_to_file()
+{
+    this->wait_async(false);
+    this->spill_memory_to_file();
+}
+
+void GCode::GCodeOutputStream::spill_memory_to_file()
+{
+    for (const std::string &chunk : m_memory_chunks)
+        fwrite(chunk.c_str(), 1, chunk.size(), this->f);
+    m_memory_chunks.clear();
+    m_memory_chunks.shrink_to_fit();
+    m_memory_size = 0;
+    m_memory_max_size = 0;
+}
+
 void GCode::GCodeOutputStream::writeln(const std::string &what)
 {
     if (! what.empty())
@@ -5501,7 +5748,7 @@ void GCode::_extrude_line(std::string& gcode_str, const Line& line, const double
         assert(false); // todo: investigate if it happens (it happens in perimeters)
         return;
     }
-    gcode_str += m_writer.extrude_to_xy(
+    m_writer.extrude_to_xy(gcode_str,
         this->point_to_gcode(line.b),
         e_per_mm * unscaled(line.length()),
         comment);
@@ -5542,7 +5789,7 @@ void GCode::_extrude_line_cut_corner(std::string& gcode_str, const Line& line, c
                 //Create a point
                 Point inter_point1 = line.point_at(scale_d(length1));
                 //extrude very reduced
-                gcode_str += this->m_writer.extrude_to_xy(
+                this->m_writer.extrude_to_xy(gcode_str,
                     this->point_to_gcode(inter_point1),
                     e_per_mm * (length1)*mult1,
                     comment);
@@ -5551,21 +5798,21 @@ void GCode::_extrude_line_cut_corner(std::string& gcode_str, const Line& line, c
                 if (line_length - length1 > length2) {
                     Point inter_point2 = line.point_at(scale_d(length1 + length2));
                     //extrude reduced
-                    gcode_str += this->m_writer.extrude_to_xy(
+                    this->m_writer.extrude_to_xy(gcode_str,
                         this->point_to_gcode(inter_point2),
                         e_per_mm * (length2)*mult2,
                         comment);
                     sum += e_per_mm * (length2)*mult2;
 
                     //extrude normal
-                    gcode_str += this->m_writer.extrude_to_xy(
+                    this->m_writer.extrude_to_xy(gcode_str,
                         this->point_to_gcode(line.b),
                         e_per_mm * (line_length - (length1 + length2)),
                         comment);
                     sum += e_per_mm * (line_length - (length1 + length2));
                 } else {
                     mult2 = 1 - coeff * (length2 / (line_length - length1));
-                    gcode_str += this->m_writer.extrude_to_xy(
+                    this->m_writer.extrude_to_xy(gcode_str,
                         this->point_to_gcode(line.b),
                         e_per_mm * (line_length - length1) * mult2,
                         comment);
@@ -5573,14 +5820,14 @@ void GCode::_extrude_line_cut_corner(std::string& gcode_str, const Line& line, c
                 }
             } else {
                 double mult = std::max(0.1, 1 - coeff * (scale_(path_width) / line_length));
-                gcode_str += this->m_writer.extrude_to_xy(
+                this->m_writer.extrude_to_xy(gcode_str,
                     this->point_to_gcode(line.b),
                     e_per_mm * line_length * mult,
                     comment);
             }
         } else {
             // nothing special, angle is too shallow to have any impact.
-            gcode_str += this->m_writer.extrude_to_xy(
+            this->m_writer.extrude_to_xy(gcode_str,
                 this->point_to_gcode(line.b),
                 e_per_mm * unscaled(line.length()),
                 comment);
@@ -5598,7 +5845,7 @@ std::string GCode::_extrude(const ExtrusionPath &path, const std::string &descri
 
     std::function<void(std::string&, const Line&, double, const std::string&)> func = [this](std::string& gcode, const Line& line, double e_per_mm, const std::string& comment) {
         if (line.a == line.b) return; //todo: investigate if it happens (it happens in perimeters)
-        gcode += m_writer.extrude_to_xy(
+        m_writer.extrude_to_xy(gcode,
             this->point_to_gcode(line.b),
             e_per_mm * unscaled(line.length()),
             comment);
@@ -5653,7 +5900,7 @@ std::string GCode::_extrude(const ExtrusionPath &path, const std::string &descri
                     const Slic3r::Geometry::ArcSegment& arc = fitting_result[fitting_index].arc_data;
                     const double arc_length = fitting_result[fitting_index].arc_data.length * SCALING_FACTOR;
                     const Vec2d center_offset = this->point_to_gcode(arc.center) - this->point_to_gcode(arc.start_point);
-                    gcode += m_writer.extrude_arc_to_xy(
+                    m_writer.extrude_arc_to_xy(gcode,
                         this->point_to_gcode(arc.end_point),
                         center_offset,
                         e_per_mm * arc_length,
@@ -6138,7 +6385,7 @@ std::string GCode::_before_extrude(const ExtrusionPath &path, const std::string
         m_delayed_layer_change.clear();
         gcode += unlift;
     }
-    gcode += m_writer.unretract();
+    m_writer.unretract(gcode);
 
     // extrude arc or line
     if (path.role() != m_last_extrusion_role && !m_config.feature_gcode.value.empty()) {
@@ -6205,7 +6452,7 @@ std::string GCode::_before_extrude(const ExtrusionPath &path, const std::string
     }
     // F     is mm per minute.
     // speed is mm per second
-    gcode += m_writer.set_speed(speed, "", comment);
+    m_writer.set_speed(gcode, speed, "", comment);
 
     return gcode;
 }
@@ -6385,7 +6632,7 @@ void GCode::write_travel_to(std::string &gcode, const Polyline& travel, std::str
             } else if (current_speed < max_speed) {
                 current_speed = max_speed;
             }
-            gcode += m_writer.travel_to_xy(
+            m_writer.travel_to_xy(gcode,
                 this->point_to_gcode(travel.points[idx_print]),
                 current_speed>2 ? double(uint32_t(current_speed)) : current_speed,
                 comment);
@@ -6415,14 +6662,14 @@ void GCode::write_travel_to(std::string &gcode, const Polyline& travel, std::str
 
         //finish writing moves at current speed
         for (; idx_print < travel.size(); ++idx_print)
-            gcode += m_writer.travel_to_xy(this->point_to_gcode(travel.points[idx_print]),
+            m_writer.travel_to_xy(gcode, this->point_to_gcode(travel.points[idx_print]),
                 current_speed > 2 ? double(uint32_t(current_speed)) : current_speed,
                 comment);
         this->set_last_pos(travel.points.back());
     } else if (travel.size() >= 2) {
         for (size_t i = 1; i < travel.size(); ++i)
             // use G1 because we rely on paths being straight (G0 may make round paths)
-            gcode += m_writer.travel_to_xy(this->point_to_gcode(travel.points[i]), 0.0, comment);
+            m_writer.travel_to_xy(gcode, this->point_to_gcode(travel.points[i]), 0.0, comment);
         this->set_last_pos(travel.points.back());
     }
 }
@@ -125,6 +125,8 @@ public:
 };
 
 struct LayerResult {
+    // G-code of the layer. The post-processing filters of process_layers() edit it as text, each filter tokenizing it
+    // with its own GCodeReader or scanner.
     std::string gcode;
     size_t      layer_id;
     // Is spiral vase post processing enabled for this layer?
@@ -214,8 +216,8 @@ public:
 private:
     class GCodeOutputStream {
     public:
-        GCodeOutputStream(FILE* f, GCodeProcessor& processor, GCode& gcodegen) : f(f), m_processor(processor), m_gcodegen(gcodegen) {}
-        ~GCodeOutputStream() { this->close(); }
+        GCodeOutputStream(FILE* f, GCodeProcessor& processor, GCode& gcodegen);
+        ~GCodeOutputStream();
 
         // Set a find-replace post-processor to modify the G-code before GCodePostProcessor.
         // It is being set to null inside process_layers(), because the find-replace process
@@ -227,6 +229,21 @@ private:
 
         bool is_open() const { return f; }
         bool is_error() const;
+
+        // Keep the G-code in memory instead of writing it, as long as it's smaller than max_size.
+        // Then the file is written only once, by GCodeProcessor::finalize(), with the remaining times already inserted.
+        // If the export throws, the G-code kept in memory is discarded, as the temp file is removed.
+        void keep_in_memory(size_t max_size) { m_memory_max_size = max_size; }
+        bool is_in_memory() const { return m_memory_max_size > 0; }
+        // Write the G-code kept in memory into the file, and don't keep the next writes in memory.
+        void spill_to_file();
+        // Give the G-code kept in memory, to be written by GCodeProcessor::finalize().
+        std::vector<std::string> extract_memory() { m_memory_size = 0; return std::move(m_memory_chunks); }
+
+        // Hand the G-code over to a writer thread and to a GCodeProcessor thread, instead of writing and processing it in the calling thread.
+        // The queues are bounded: if the disk or the processor is slower than the G-code generation, write() waits.
+        // flush() waits for both threads to finish their work.
+        void set_async(bool async);
         
         void flush();
         void close();
@@ -252,6 +269,21 @@ private:
         GCodeFindReplace *m_find_replace_backup { nullptr };
         GCodeProcessor   &m_processor;
         GCode            &m_gcodegen;
+        // G-code not written yet, see keep_in_memory().
+        std::vector<std::string> m_memory_chunks;
+        size_t            m_memory_size { 0 };
+        size_t            m_memory_max_size { 0 };
+        // Writer & processor threads, see set_async().
+        struct AsyncStages;
+        std::unique_ptr<AsyncStages> m_async;
+        // G-code not handed over to the threads yet.
+        std::string       m_async_buffer;
+
+        void write_to_file(const std::string &gcode);
+        void spill_memory_to_file();
+        void hand_over_async_buffer();
+        // Wait for the threads to finish. If discard, the buffers still in the queues are dropped.
+        void wait_async(bool discard);
     };
     void            _do_export(Print &print, GCodeOutputStream &file, ThumbnailsGeneratorCallback thumbnail_cb);
     void            _move_to_print_object(std::string& gcode_out, const Print& print, size_t finished_objects, uint16_t initial_extruder_id);
@@ -260,6 +292,12 @@ private:
     static std::vector<LayerToPrint>                                   collect_layers_to_print(const PrintObject &object, Print::StatusMonitor &status_monitor);
     static std::vector<std::pair<coordf_t, std::vector<LayerToPrint>>> collect_layers_to_print(const Print &print, Print::StatusMonitor &status_monitor);
 
+    struct ObjectByExtruder;
+    // Extrusions of a layer grouped by an extruder, then by an object, an island and a region.
+    using ObjectsByExtruder = std::map<uint16_t, std::vector<ObjectByExtruder>>;
+    // Pure function of the layers and of the tool ordering, thus it can be computed ahead of process_layer() in parallel.
+    static ObjectsByExtruder group_extrusions_by_extruder(const Print &print, const std::vector<LayerToPrint> &layers, const LayerTools &layer_tools);
+
     LayerResult process_layer(
         const Print                     &print,
         Print::StatusMonitor            &status_monitor,
@@ -271,8 +309,17 @@ private:
 		const std::vector<const PrintInstance*> *ordering,
         // If set to size_t(-1), then print all copies of all objects.
         // Otherwise print a single copy of a single object.
-        size_t                     single_object_idx = size_t(-1)
+        size_t                     single_object_idx = size_t(-1),
+        // Output of group_extrusions_by_extruder() for these layers, if already computed.
+        ObjectsByExtruder         *by_extruder_prepared = nullptr
         );
+    // Layer passed from the parallel to the serial stages of the process_layers() pipeline.
+    struct LayerToProcess {
+        // Index into layers_to_print, past its end for the NOP layer of the pressure equalizer.
+        size_t                              idx { 0 };
+        // Extrusions grouped ahead of time, null if left to process_layer().
+        std::shared_ptr<ObjectsByExtruder>  by_extruder;
+    };
     // Process all layers of all objects (non-sequential mode) with a parallel pipeline:
     // Generate G-code, run the filters (vase mode, cooling buffer), run the G-code analyser
     // and export G-code into file.
@@ -1,7 +1,9 @@
 #include "FindReplace.hpp"
 #include "../Utils.hpp"
 
+#include <algorithm>
 #include <cctype> // isalpha
+#include <cstring>
 #include <boost/algorithm/string/replace.hpp>
 
 namespace Slic3r {
@@ -22,6 +24,39 @@ const void unescape_extended_search_mode(std::string &s)
 // \u: The hexadecimal representation of a two-byte character, made of 4 digits in the 0-9, A-F/a-f range.
 }
 
+static inline char to_lower_ascii(char c)
+{
+    return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+}
+
+// Could the pattern be searched for as a plain text? The case insensitive search is done for ASCII patterns only.
+static bool is_literal_pattern(const std::string &pattern, bool regexp, bool case_insensitive)
+{
+    return ! pattern.empty() && std::all_of(pattern.begin(), pattern.end(), [regexp, case_insensitive](char c) {
+        return (! case_insensitive || uint8_t(c) < 0x80) && (! regexp || strchr(".[]{}()\\*+?|^$", c) == nullptr);
+    });
+}
+
+// Could the pattern appear in a text after a substitution inserted the replacement? That is, could the pattern overlap with the replacement?
+// If the replacement is empty, the pattern may be created by joining the text around the removed match.
+static bool may_create_pattern(const std::string &replacement, const std::string &pattern, bool case_insensitive)
+{
+    if (replacement.empty())
+        return pattern.size() > 1;
+    auto equal = [case_insensitive](char a, char b) { return case_insensitive ? to_lower_ascii(a) == to_lower_ascii(b) : a == b; };
+    // Offset of the replacement relative to the start of the pattern.
+    for (int offset = 1 - int(replacement.size()); offset < int(pattern.size()); ++ offset) {
+        int  begin = std::max(0, offset);
+        int  end   = std::min(int(pattern.size()), offset + int(replacement.size()));
+        bool match = true;
+        for (int i = begin; i < end && match; ++ i)
+            match = equal(pattern[i], replacement[i - offset]);
+        if (match)
+            return true;
+    }
+    return false;
+}
+
 GCodeFindReplace::GCodeFindReplace(const std::vector<std::string> &gcode_substitutions)
 {
     if ((gcode_substitutions.size() % 4) != 0)
@@ -53,6 +88,105 @@ GCodeFindReplace::GCodeFindReplace(const std::vector<std::string> &gcode_substit
         }
         m_substitutions.emplace_back(std::move(out));
     }
+
+    // Literal patterns are searched for all at once, the substitutions of the patterns not present in a layer are skipped.
+    for (Substitution &substitution : m_substitutions)
+        if (is_literal_pattern(substitution.plain_pattern, substitution.regexp, substitution.case_insensitive))
+            substitution.literal_pattern = int(m_literal_matcher.add_pattern(substitution.plain_pattern, substitution.case_insensitive));
+    m_literal_matcher.build();
+    for (size_t i = 0; i < m_substitutions.size(); ++ i) {
+        Substitution &substitution = m_substitutions[i];
+        substitution.may_create.assign(m_substitutions.size(), false);
+        for (size_t j = i + 1; j < m_substitutions.size(); ++ j)
+            if (const Substitution &next = m_substitutions[j]; next.literal_pattern != -1)
+                substitution.may_create[j] = substitution.regexp || may_create_pattern(substitution.format, next.plain_pattern, next.case_insensitive);
+    }
+}
+
+size_t GCodeFindReplace::LiteralMatcher::add_pattern(const std::string &pattern, bool case_insensitive)
+{
+    assert(! pattern.empty());
+    m_patterns.push_back({ pattern, case_insensitive });
+    return m_patterns.size() - 1;
+}
+
+void GCodeFindReplace::LiteralMatcher::build()
+{
+    // Map the characters of the patterns to a compact alphabet, upper case letters share the class of their lower case counterparts.
+    m_char_class.fill(0);
+    m_num_classes = 1;
+    for (const Pattern &pattern : m_patterns)
+        for (char c : pattern.pattern)
+            if (uint8_t &cls = m_char_class[uint8_t(to_lower_ascii(c))]; cls == 0)
+                cls = uint8_t(m_num_classes ++);
+    for (char c = 'A'; c <= 'Z'; ++ c)
+        m_char_class[uint8_t(c)] = m_char_class[uint8_t(to_lower_ascii(c))];
+    // There are at most 26 classes less than 256 characters.
+    assert(m_num_classes <= 256);
+
+    // Trie of the lower case patterns.
+    m_transitions.assign(m_num_classes, -1);
+    m_outputs.assign(1, {});
+    for (size_t idx = 0; idx < m_patterns.size(); ++ idx) {
+        int32_t state = 0;
+        for (char c : m_patterns[idx].pattern) {
+            int32_t &next = m_transitions[state * m_num_classes + m_char_class[uint8_t(c)]];
+            if (next == -1) {
+                next = int32_t(m_outputs.size());
+                m_outputs.emplace_back();
+                // Don't hold the reference over the resize.
+                state = next;
+                m_transitions.resize(m_transitions.size() + m_num_classes, -1);
+            } else
+                state = next;
+        }
+        m_outputs[state].emplace_back(idx);
+    }
+
+    // Breadth first traversal to calculate the suffix links and to complete the transitions.
+    std::vector<int32_t> suffix(m_outputs.size(), 0);
+    std::vector<int32_t> queue;
+    queue.reserve(m_outputs.size());
+    for (size_t cls = 0; cls < m_num_classes; ++ cls)
+        if (int32_t &next = m_transitions[cls]; next == -1)
+            next = 0;
+        else
+            queue.emplace_back(next);
+    for (size_t i = 0; i < queue.size(); ++ i) {
+        int32_t state = queue[i];
+        for (size_t cls = 0; cls < m_num_classes; ++ cls) {
+            int32_t fallback = m_transitions[suffix[state] * m_num_classes + cls];
+            int32_t &next = m_transitions[state * m_num_classes + cls];
+            if (next == -1)
+                next = fallback;
+            else {
+                suffix[next] = fallback;
+                append(m_outputs[next], m_outputs[fallback]);
+                queue.emplace_back(next);
+            }
+        }
+    }
+}
+
+std::vector<char> GCodeFindReplace::LiteralMatcher::find(const std::string &text) const
+{
+    std::vector<char> found(m_patterns.size(), false);
+    size_t  num_found = 0;
+    int32_t state     = 0;
+    for (size_t i = 0; i < text.size(); ++ i) {
+        state = m_transitions[state * m_num_classes + m_char_class[uint8_t(text[i])]];
+        for (size_t idx : m_outputs[state])
+            if (! found[idx]) {
+                const Pattern &pattern = m_patterns[idx];
+                // The automaton matches case insensitive, verify the case sensitive patterns.
+                if (pattern.case_insensitive || text.compare(i + 1 - pattern.pattern.size(), pattern.pattern.size(), pattern.pattern) == 0) {
+                    found[idx] = true;
+                    if (++ num_found == m_patterns.size())
+                        return found;
+                }
+            }
+    }
+    return found;
 }
 
 class ToStringIterator 
@@ -107,12 +241,27 @@ static void find_and_replace_whole_word(std::string &inout, const std::string &m
 
 std::string GCodeFindReplace::process_layer(const std::string &ain)
 {
+    // Substitutions to be applied: their pattern is present in the layer or it may have been created by a preceding substitution.
+    std::vector<char> apply(m_substitutions.size(), true);
+    if (! m_literal_matcher.empty()) {
+        std::vector<char> present = m_literal_matcher.find(ain);
+        for (size_t i = 0; i < m_substitutions.size(); ++ i)
+            if (int idx = m_substitutions[i].literal_pattern; idx != -1)
+                apply[i] = present[idx];
+    }
+
     std::string out;
     const std::string *in = &ain;
     std::string temp;
     temp.reserve(in->size());
 
-    for (const Substitution &substitution : m_substitutions) {
+    for (size_t i = 0; i < m_substitutions.size(); ++ i) {
+        if (! apply[i])
+            continue;
+        const Substitution &substitution = m_substitutions[i];
+        for (size_t j = i + 1; j < m_substitutions.size(); ++ j)
+            if (substitution.may_create[j])
+                apply[j] = true;
         if (substitution.regexp) {
             temp.clear();
             temp.reserve(in->size());
@@ -150,6 +299,9 @@ std::string GCodeFindReplace::process_layer(const std::string &ain)
         in = &out;
     }
 
+    if (in == &ain)
+        // No substitution applied.
+        out = ain;
     return out;
 }
 
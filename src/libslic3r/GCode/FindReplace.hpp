@@ -3,6 +3,8 @@
 
 #include "../PrintConfig.hpp"
 
+#include <array>
+
 #include <boost/regex.hpp>
 
 namespace Slic3r {
@@ -16,6 +18,32 @@ public:
     std::string process_layer(const std::string &gcode);
     
 private:
+    // Aho-Corasick automaton over the literal patterns, finding all the patterns present in a layer with a single pass over the layer.
+    // The automaton runs over the text converted to lower case, matches of the case sensitive patterns are verified.
+    class LiteralMatcher {
+    public:
+        // Returns the index of the pattern.
+        size_t add_pattern(const std::string &pattern, bool case_insensitive);
+        void   build();
+        // Flags of the patterns found in text, indexed by the pattern index.
+        std::vector<char> find(const std::string &text) const;
+        bool   empty() const { return m_patterns.empty(); }
+
+    private:
+        struct Pattern {
+            std::string pattern;
+            bool        case_insensitive;
+        };
+        std::vector<Pattern>                m_patterns;
+        // Characters not contained in any pattern are mapped to class zero.
+        std::array<uint8_t, 256>            m_char_class;
+        size_t                              m_num_classes { 0 };
+        // State transitions, m_num_classes per state. State zero is the root.
+        std::vector<int32_t>                m_transitions;
+        // Patterns ending at a state, including the patterns of its suffix states.
+        std::vector<std::vector<size_t>>    m_outputs;
+    };
+
     struct Substitution {
         std::string     plain_pattern;
         boost::regex    regexp_pattern;
@@ -26,8 +54,15 @@ private:
         bool            whole_word { false };
         // Valid for regexp only. Equivalent to Perl's /s modifier.
         bool            single_line { false };
+
+        // Index of the pattern in m_literal_matcher. The substitution is skipped if its pattern is not present in the layer
+        // and if it could not be created by any of the preceding substitutions. -1 if the substitution has to be applied always.
+        int             literal_pattern { -1 };
+        // Flags of the following substitutions, whose pattern may be created by this substitution.
+        std::vector<char> may_create;
     };
     std::vector<Substitution> m_substitutions;
+    LiteralMatcher            m_literal_matcher;
 };
 
 }
@@ -0,0 +1,182 @@
+#include "GCodeCache.hpp"
+
+#include "libslic3r/Model.hpp"
+#include "libslic3r/PrintConfig.hpp"
+#include "libslic3r/Utils.hpp"
+
+#include <iterator>
+
+#include <boost/algorithm/hex.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <boost/nowide/iostream.hpp>
+//FIXME replace with <boost/md5.hpp> after it becomes mainstream, see AppConfig::appconfig_md5_hash_line().
+#include <boost/uuid/detail/md5.hpp>
+
+namespace Slic3r {
+
+namespace {
+
+// The values are length prefixed, so that they may contain any character including new lines.
+void append_field(std::string &key, const std::string &name, const std::string &value)
+{
+    key += name;
+    key += ' ';
+    key += std::to_string(value.size());
+    key += ' ';
+    key += value;
+    key += '\n';
+}
+
+// Binary values (coordinates, transformations) are written as hex to be locale independent and exact.
+void append_bytes(std::string &key, const std::string &name, const void *data, size_t size)
+{
+    std::string value;
+    boost::algorithm::hex(static_cast<const unsigned char*>(data), static_cast<const unsigned char*>(data) + size, std::back_inserter(value));
+    append_field(key, name, value);
+}
+
+void append_config(std::string &key, const DynamicPrintConfig &config)
+{
+    const t_config_option_keys opt_keys = config.keys();
+    append_field(key, "config", std::to_string(opt_keys.size()));
+    for (const std::string &opt_key : opt_keys)
+        append_field(key, opt_key, config.opt_serialize(opt_key));
+}
+
+void md5_facets(boost::uuids::detail::md5 &md5_hash, const FacetsAnnotation &facets)
+{
+    const std::pair<std::vector<std::pair<int, int>>, std::vector<bool>> &data = facets.get_data();
+    if (! data.first.empty())
+        md5_hash.process_bytes(data.first.data(), data.first.size() * sizeof(data.first.front()));
+    for (bool bit : data.second)
+        md5_hash.process_byte(bit ? 1 : 0);
+    // Separate the facets of the next annotation.
+    const uint64_t sizes[2] { data.first.size(), data.second.size() };
+    md5_hash.process_bytes(sizes, sizeof(sizes));
+}
+
+// The meshes are too large to be stored in the key, their MD5 digest is stored instead.
+std::string volume_digest(const ModelVolume &volume)
+{
+    using boost::uuids::detail::md5;
+    md5 md5_hash;
+    const indexed_triangle_set &its = volume.mesh().its;
+    const uint64_t sizes[2] { its.vertices.size(), its.indices.size() };
+    md5_hash.process_bytes(sizes, sizeof(sizes));
+    if (! its.vertices.empty())
+        md5_hash.process_bytes(its.vertices.data(), its.vertices.size() * sizeof(its.vertices.front()));
+    if (! its.indices.empty())
+        md5_hash.process_bytes(its.indices.data(), its.indices.size() * sizeof(its.indices.front()));
+    md5_facets(md5_hash, volume.supported_facets);
+    md5_facets(md5_hash, volume.seam_facets);
+    md5_facets(md5_hash, volume.mmu_segmentation_facets);
+    md5::digest_type md5_digest{};
+    md5_hash.get_digest(md5_digest);
+    std::string md5_digest_str;
+    boost::algorithm::hex(md5_digest, md5_digest + std::size(md5_digest), std::back_inserter(md5_digest_str));
+    return md5_digest_str;
+}
+
+// Names of the files of a cache entry: the G-code and the key with the output path.
+boost::filesystem::path gcode_cache_path(const std::string &cache_dir, const std::string &key, const char *extension)
+{
+    return boost::filesystem::path(cache_dir) / ((boost::format("%016x") % uint64_t(boost::hash<std::string>()(key))).str() + extension);
+}
+
+} // namespace
+
+std::string gcode_cache_key(const Model &model, const DynamicPrintConfig &full_print_config, const std::string &outfile)
+{
+    std::string key;
+    append_field(key, "version", SLIC3R_APP_NAME " " SLIC3R_VERSION " " SLIC3R_BUILD_ID);
+    append_field(key, "outfile", outfile);
+    append_config(key, full_print_config);
+    append_field(key, "custom_gcode_mode", std::to_string(int(model.custom_gcode_per_print_z.mode)));
+    for (const CustomGCode::Item &item : model.custom_gcode_per_print_z.gcodes) {
+        append_bytes(key, "custom_gcode_print_z", &item.print_z, sizeof(item.print_z));
+        append_field(key, "custom_gcode_type", std::to_string(int(item.type)));
+        append_field(key, "custom_gcode_extruder", std::to_string(item.extruder));
+        append_field(key, "custom_gcode_color", item.color);
+        append_field(key, "custom_gcode_extra", item.extra);
+    }
+    for (const ModelObject *object : model.objects) {
+        append_field(key, "object", object->name);
+        append_field(key, "input_file", object->input_file);
+        append_config(key, object->config.get());
+        const std::vector<coordf_t> layer_height_profile = object->layer_height_profile.get();
+        append_bytes(key, "layer_height_profile", layer_height_profile.data(), layer_height_profile.size() * sizeof(coordf_t));
+        for (const auto &[range, config] : object->layer_config_ranges) {
+            append_bytes(key, "layer_range", &range, sizeof(range));
+            append_config(key, config.get());
+        }
+        for (const ModelVolume *volume : object->volumes) {
+            append_field(key, "volume", volume->name);
+            append_field(key, "volume_type", std::to_string(int(volume->type())));
+            append_bytes(key, "volume_matrix", volume->get_matrix().data(), 16 * sizeof(double));
+            append_config(key, volume->config.get());
+            append_field(key, "volume_mesh", volume_digest(*volume));
+        }
+        for (const ModelInstance *instance : object->instances) {
+            append_field(key, "instance", instance->printable ? "1" : "0");
+            append_bytes(key, "instance_matrix", instance->get_matrix().data(), 16 * sizeof(double));
+        }
+    }
+    return key;
+}
+
+std::string gcode_cache_load(const std::string &cache_dir, const std::string &key)
+{
+    const boost::filesystem::path gcode_path = gcode_cache_path(cache_dir, key, ".gcode");
+    const boost::filesystem::path key_path   = gcode_cache_path(cache_dir, key, ".key");
+    std::string outfile;
+    {
+        boost::nowide::ifstream ifs(key_path.string(), std::ios::binary);
+        if (! ifs || ! std::getline(ifs, outfile) || outfile.empty() || ! boost::filesystem::exists(gcode_path))
+            return std::string();
+        // The file names are a 64 bit hash of the key: a different job may share them.
+        if (std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()) != key)
+            return std::string();
+    }
+    std::string error_message;
+    if (copy_file(gcode_path.string(), outfile, error_message) != SUCCESS) {
+        boost::nowide::cerr << "Copying the cached G-code " << gcode_path.string() << " to " << outfile << " failed: " << error_message << std::endl;
+        return std::string();
+    }
+    return outfile;
+}
+
+void gcode_cache_store(const std::string &cache_dir, const std::string &key, const std::string &outfile)
+{
+    const boost::filesystem::path gcode_path = gcode_cache_path(cache_dir, key, ".gcode");
+    const boost::filesystem::path key_path   = gcode_cache_path(cache_dir, key, ".key");
+    const std::string             tmp_suffix = "." + boost::filesystem::unique_path().string() + ".tmp";
+    const std::string             gcode_tmp  = gcode_path.string() + tmp_suffix;
+    const std::string             key_tmp    = key_path.string() + tmp_suffix;
+    auto failed = [&](const std::string &error_message) {
+        boost::nowide::cerr << "Storing the G-code " << outfile << " into the cache " << cache_dir << " failed: " << error_message << std::endl;
+        boost::system::error_code ec;
+        boost::filesystem::remove(gcode_tmp, ec);
+        boost::filesystem::remove(key_tmp, ec);
+    };
+    std::string error_message;
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(cache_dir, ec);
+    if (copy_file(outfile, gcode_tmp, error_message) != SUCCESS)
+        return failed(error_message);
+    if (std::error_code err = rename_file(gcode_tmp, gcode_path.string()))
+        return failed(err.message());
+    {
+        boost::nowide::ofstream ofs(key_tmp, std::ios::binary);
+        ofs << outfile << '\n' << key;
+        ofs.close();
+        if (! ofs)
+            return failed("writing " + key_tmp);
+    }
+    if (std::error_code err = rename_file(key_tmp, key_path.string()))
+        return failed(err.message());
+}
+
+} // namespace Slic3r
@@ -0,0 +1,29 @@
+#ifndef slic3r_GCode_GCodeCache_hpp_
+#define slic3r_GCode_GCodeCache_hpp_
+
+#include <string>
+
+#include "../libslic3r.h"
+
+namespace Slic3r {
+
+class DynamicPrintConfig;
+class Model;
+
+// Cache of exported G-codes in a directory (command line --gcode-cache), so that a repeated export of the same job is a copy.
+
+// Key of a G-code in the cache: the slicer version, the output file name, the full print config, the custom G-codes per print Z
+// (color changes, pauses ...) and the names, configs, transformations and digests of the meshes and painted facets of the objects
+// and of their arranged instances. The key is stored with the G-code and compared on a hit, the file names only hold its hash.
+extern std::string gcode_cache_key(const Model &model, const DynamicPrintConfig &full_print_config, const std::string &outfile);
+
+// Copy the cached G-code to the output path it was first exported to. Returns the output path, empty if the G-code is not cached.
+extern std::string gcode_cache_load(const std::string &cache_dir, const std::string &key);
+
+// Keep a copy of the exported G-code. The files are written under temporary names and renamed, so that a concurrent export
+// never reads a partial G-code: the key file, written last, marks the entry as complete. Failures are reported and leave no file.
+extern void gcode_cache_store(const std::string &cache_dir, const std::string &key, const std::string &outfile);
+
+} // namespace Slic3r
+
+#endif /* slic3r_GCode_GCodeCache_hpp_ */
@@ -345,14 +345,18 @@ void GCodeProcessor::TimeProcessor::reset()
     machines[static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Normal)].enabled = true;
 }
 
-void GCodeProcessor::TimeProcessor::post_process(const std::string& filename, std::vector<GCodeProcessorResult::MoveVertex>& moves, std::vector<size_t>& lines_ends)
+void GCodeProcessor::TimeProcessor::post_process(const std::string& filename, std::vector<GCodeProcessorResult::MoveVertex>& moves, std::vector<size_t>& lines_ends, const std::vector<std::string>* gcode_in_memory)
 {
-    FilePtr in{ boost::nowide::fopen(filename.c_str(), "rb") };
-    if (in.f == nullptr)
-        throw Slic3r::RuntimeError(std::string("Time estimator post process export failed.\nCannot open file for reading.\n"));
+    // The G-code is read from the file, or from memory if it wasn't written yet.
+    FilePtr in{ nullptr };
+    if (gcode_in_memory == nullptr) {
+        in.f = boost::nowide::fopen(filename.c_str(), "rb");
+        if (in.f == nullptr)
+            throw Slic3r::RuntimeError(std::string("Time estimator post process export failed.\nCannot open file for reading.\n"));
+    }
 
-    // temporary file to contain modified gcode
-    std::string out_path = filename + ".postprocess";
+    // temporary file to contain modified gcode (no need if the gcode wasn't written yet: it's written directly in the final file)
+    std::string out_path = gcode_in_memory == nullptr ? filename + ".postprocess" : filename;
     FilePtr out{ boost::nowide::fopen(out_path.c_str(), "wb") };
     if (out.f == nullptr) {
         throw Slic3r::RuntimeError(std::string("Time estimator post process export failed.\nCannot open file for writing.\n"));
@@ -602,53 +606,60 @@ void GCodeProcessor::TimeProcessor::post_process(const std::string& filename, st
     unsigned int line_id = 0;
     std::vector<std::pair<unsigned int, unsigned int>> offsets;
 
-    {
+    // Extract the lines of a block of G-code and process them. eof is set with an empty block after the last one.
+    auto process_block = [&](const char *it, const char *it_bufend, bool eof) {
+        while (it != it_bufend || (eof && ! gcode_line.empty())) {
+            // Find end of line.
+            bool eol    = false;
+            auto it_end = it;
+            for (; it_end != it_bufend && ! (eol = *it_end == '\r' || *it_end == '\n'); ++ it_end) ;
+            // End of line is indicated also if end of file was reached.
+            eol |= eof && it_end == it_bufend;
+            gcode_line.insert(gcode_line.end(), it, it_end);
+            if (eol) {
+                ++line_id;
+
+                gcode_line += "\n";
+                // replace placeholder lines
+                auto [processed, lines_added_count] = process_placeholders(gcode_line);
+                if (processed && lines_added_count > 0)
+                    offsets.push_back({ line_id, lines_added_count });
+                if (! processed && ! is_temporary_decoration(gcode_line) && GCodeReader::GCodeLine::cmd_is(gcode_line, "G1")) {
+                    // remove temporary lines, add lines M73 where needed
+                    unsigned int extra_lines_count = process_line_G1(g1_lines_counter ++);
+                    if (extra_lines_count > 0)
+                        offsets.push_back({ line_id, extra_lines_count });
+                }
+
+                export_line += gcode_line;
+                if (export_line.length() > 65535)
+                    write_string(export_line);
+                gcode_line.clear();
+            }
+            // Skip EOL.
+            it = it_end; 
+            if (it != it_bufend && *it == '\r')
+                ++ it;
+            if (it != it_bufend && *it == '\n')
+                ++ it;
+        }
+    };
+
+    // Line buffer.
+    assert(gcode_line.empty());
+    if (gcode_in_memory != nullptr) {
+        for (const std::string &chunk : *gcode_in_memory)
+            process_block(chunk.data(), chunk.data() + chunk.size(), false);
+        process_block(nullptr, nullptr, true);
+    } else {
         // Read the input stream 64kB at a time, extract lines and process them.
         std::vector<char> buffer(65536 * 10, 0);
-        // Line buffer.
-        assert(gcode_line.empty());
         for (;;) {
             size_t cnt_read = ::fread(buffer.data(), 1, buffer.size(), in.f);
             if (::ferror(in.f))
                 throw Slic3r::RuntimeError(std::string("Time estimator post process export failed.\nError while reading from file.\n"));
-            bool eof       = cnt_read == 0;
-            auto it        = buffer.begin();
-            auto it_bufend = buffer.begin() + cnt_read;
-            while (it != it_bufend || (eof && ! gcode_line.empty())) {
-                // Find end of line.
-                bool eol    = false;
-                auto it_end = it;
-                for (; it_end != it_bufend && ! (eol = *it_end == '\r' || *it_end == '\n'); ++ it_end) ;
-                // End of line is indicated also if end of file was reached.
-                eol |= eof && it_end == it_bufend;
-                gcode_line.insert(gcode_line.end(), it, it_end);
-                if (eol) {
-                    ++line_id;
-
-                    gcode_line += "\n";
-                    // replace placeholder lines
-                    auto [processed, lines_added_count] = process_placeholders(gcode_line);
-                    if (processed && lines_added_count > 0)
-                        offsets.push_back({ line_id, lines_added_count });
-                    if (! processed && ! is_temporary_decoration(gcode_line) && GCodeReader::GCodeLine::cmd_is(gcode_line, "G1")) {
-                        // remove temporary lines, add lines M73 where needed
-                        unsigned int extra_lines_count = process_line_G1(g1_lines_counter ++);
-                        if (extra_lines_count > 0)
-                            offsets.push_back({ line_id, extra_lines_count });
-                    }
-
-                    export_line += gcode_line;
-                    if (export_line.length() > 65535)
-                        write_string(export_line);
-                    gcode_line.clear();
-                }
-                // Skip EOL.
-                it = it_end; 
-                if (it != it_bufend && *it == '\r')
-                    ++ it;
-                if (it != it_bufend && *it == '\n')
-                    ++ it;
-            }
+            bool eof = cnt_read == 0;
+            process_block(buffer.data(), buffer.data() + cnt_read, eof);
             if (eof)
                 break;
         }
@@ -672,7 +683,7 @@ void GCodeProcessor::TimeProcessor::post_process(const std::string& filename, st
     }
 
     std::error_code err_code;
-    if (err_code = rename_file(out_path, filename)) {
+    if (out_path != filename && (err_code = rename_file(out_path, filename))) {
         std::string err_msg = (std::string("Failed to rename the output G-code file from ") + out_path + " to " + filename + '\n' +
             "Is " + out_path + " locked? (gcp)" + err_code.message() + '\n');
         if (copy_file(out_path, filename, err_msg, true) != SUCCESS)
@@ -1436,7 +1447,8 @@ void GCodeProcessor::process_file(const std::string& filename, std::function<voi
     // 1st move must be a dummy move (should be added by the reset())
     assert(m_result.moves.size() == 1 && m_result.moves.front().type == EMoveType::Noop);
     size_t parse_line_callback_cntr = 10000;
-    m_parser.parse_file(filename, [this, cancel_callback, &parse_line_callback_cntr](GCodeReader& reader, const GCodeReader::GCodeLine& line) {
+    // The lines are tokenized in parallel, then processed in order as the state of the machine depends on all the previous lines.
+    m_parser.parse_file_parallel(filename, [this, cancel_callback, &parse_line_callback_cntr](GCodeReader& reader, const GCodeReader::GCodeLine& line) {
         if (-- parse_line_callback_cntr == 0) {
             // Don't call the cancel_callback() too often, do it every at every 10000'th line.
             parse_line_callback_cntr = 10000;
@@ -1473,7 +1485,7 @@ void GCodeProcessor::process_buffer(const std::string &buffer)
     });
 }
 
-void GCodeProcessor::finalize(bool post_process)
+void GCodeProcessor::finalize(bool post_process, const std::vector<std::string>* gcode_in_memory)
 {
     // update width/height of wipe moves
     for (GCodeProcessorResult::MoveVertex& move : m_result.moves) {
@@ -1513,7 +1525,7 @@ void GCodeProcessor::finalize(bool post_process)
 #endif // ENABLE_GCODE_VIEWER_DATA_CHECKING
 
     if (post_process)
-        m_time_processor.post_process(m_result.filename, m_result.moves, m_result.lines_ends);
+        m_time_processor.post_process(m_result.filename, m_result.moves, m_result.lines_ends, gcode_in_memory);
 #if ENABLE_GCODE_VIEWER_STATISTICS
     m_result.time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - m_start_time).count();
 #endif // ENABLE_GCODE_VIEWER_STATISTICS
@@ -1945,7 +1957,7 @@ void GCodeProcessor::process_gcode_line(const GCodeReader::GCodeLine& line, bool
             break;
         }
     } else {
-        const std::string &comment = line.raw();
+        std::string_view comment = line.raw_view();
         if (comment.length() > 2 && comment.front() == ';')
             // Process tags embedded into comments. Tag comments always start at the start of a line
             // with a comment and continue with a tag without any whitespace separator.
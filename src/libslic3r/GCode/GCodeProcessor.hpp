@@ -370,7 +370,9 @@ namespace Slic3r {
 
             // post process the file with the given filename to add remaining time lines M73
             // and updates moves' gcode ids accordingly
-            void post_process(const std::string& filename, std::vector<GCodeProcessorResult::MoveVertex>& moves, std::vector<size_t>& lines_ends);
+            // If gcode_in_memory is set, the gcode is read from it instead of the file, and the file is written only once.
+            void post_process(const std::string& filename, std::vector<GCodeProcessorResult::MoveVertex>& moves, std::vector<size_t>& lines_ends,
+                const std::vector<std::string>* gcode_in_memory = nullptr);
         };
 
         struct UsedFilaments  // filaments per ColorChange
@@ -635,7 +637,8 @@ namespace Slic3r {
         // Streaming interface, for processing G-codes just generated by PrusaSlicer in a pipelined fashion.
         void initialize(const std::string& filename);
         void process_buffer(const std::string& buffer);
-        void finalize(bool post_process);
+        // gcode_in_memory: the G-code that was processed, if it wasn't written into the file yet (see TimeProcessor::post_process).
+        void finalize(bool post_process, const std::vector<std::string>* gcode_in_memory = nullptr);
 
         float get_time(PrintEstimatedStatistics::ETimeMode mode) const;
         std::string get_time_dhm(PrintEstimatedStatistics::ETimeMode mode) const;
@@ -23,17 +23,18 @@ std::string SpiralVase::process_layer(const std::string &gcode)
         return gcode;
     }
     
+    // Tokenize the layer once, both the measuring and the rewriting passes below replay the parsed lines.
+    m_reader.parse_buffer(gcode, m_lines);
+
     // Get total XY length for this layer by summing all extrusion moves.
     float total_layer_length = 0;
     float layer_height = 0;
     float z = 0.f;
     std::string height_str = "";
     {
-        //FIXME Performance warning: This copies the GCodeConfig of the reader.
-        GCodeReader r = m_reader;  // clone
         bool set_z = false;
         bool milling = false;
-        r.parse_buffer(gcode, [&total_layer_length, &layer_height, &z, &set_z, &height_str, &milling]
+        m_reader.visit_lines(m_lines, [&total_layer_length, &layer_height, &z, &set_z, &height_str, &milling]
             (GCodeReader &reader, const GCodeReader::GCodeLine &line) {
             if (boost::starts_with(line.comment(), " milling"))
                 milling = true;
@@ -49,11 +50,11 @@ std::string SpiralVase::process_layer(const std::string &gcode)
                         }
                     }
                 } else {
-                    const std::string& comment = line.raw();
+                    std::string_view comment = line.raw_view();
                     if (comment.length() > 2 && comment.front() == ';') {
-                        std::string comment_str = comment.substr(1);
+                        std::string_view comment_str = comment.substr(1);
                         if (boost::starts_with(comment_str, GCodeProcessor::reserved_tag(GCodeProcessor::ETags::Height))) {
-                            height_str = comment_str.substr(GCodeProcessor::reserved_tag(GCodeProcessor::ETags::Height).size());
+                            height_str = std::string(comment_str.substr(GCodeProcessor::reserved_tag(GCodeProcessor::ETags::Height).size()));
                         }
                     }
                 }
@@ -86,21 +87,25 @@ std::string SpiralVase::process_layer(const std::string &gcode)
     double last_old_E = 0;
     bool is_milling = false;
     GCodeReader::GCodeLine line_last_position;
-    m_reader.parse_buffer(gcode, [this, &keep_first_travel , &new_gcode, &z, total_layer_length, layer_height_factor, &len, &E_accumulator, &last_old_E, &height_str, &is_milling, &line_last_position]
-        (GCodeReader &reader, GCodeReader::GCodeLine line) {
-        if (boost::starts_with(line.comment()," milling"))
+    m_reader.visit_lines(m_lines, [this, &keep_first_travel , &new_gcode, &z, total_layer_length, layer_height_factor, &len, &E_accumulator, &last_old_E, &height_str, &is_milling, &line_last_position]
+        (GCodeReader &reader, const GCodeReader::GCodeLine &parsed_line) {
+        if (boost::starts_with(parsed_line.comment()," milling"))
             is_milling = true;
         if (!is_milling) {
-            if (line.cmd_is("G1")) {
-                if (line.has_z()) {
+            if (parsed_line.cmd_is("G1")) {
+                if (parsed_line.has_z()) {
                     // If this is the initial Z move of the layer, replace it with a
                     // (redundant) move to the last Z of previous layer.
+                    GCodeReader::GCodeLine line = parsed_line;
                     line.set(reader, Z, z);
-                    new_gcode += line.raw() + '\n';
+                    new_gcode += line.raw_view();
+                    new_gcode += '\n';
                     return;
                 } else {
-                    float dist_XY = line.dist_XY(reader);
+                    float dist_XY = parsed_line.dist_XY(reader);
                     if (dist_XY > 0) {
+                        // The moves are copied out of the parsed buffer, they are modified or kept as the last position.
+                        GCodeReader::GCodeLine line = parsed_line;
                         // horizontal move
                         if (line.extruding(reader)) {
                             keep_first_travel = false;
@@ -116,12 +121,14 @@ std::string SpiralVase::process_layer(const std::string &gcode)
                                     line.set(reader, E, E_accumulator);
                                 }
                             }
-                            new_gcode += line.raw() + '\n';
+                            new_gcode += line.raw_view();
+                            new_gcode += '\n';
                         } else if (keep_first_travel) {
                             //we can travel until the first spiral extrusion
-                            new_gcode += line.raw() + '\n';
+                            new_gcode += line.raw_view();
+                            new_gcode += '\n';
                         }
-                        line_last_position = line;
+                        line_last_position = std::move(line);
                         return;
 
                         /*  Skip travel moves: the move to first perimeter point will
@@ -132,9 +139,9 @@ std::string SpiralVase::process_layer(const std::string &gcode)
                     }
                 }
             } else if (!height_str.empty()) {
-                const std::string& comment = line.raw();
+                std::string_view comment = parsed_line.raw_view();
                 if (comment.length() > 2 && comment.front() == ';') {
-                    std::string comment_str = comment.substr(1);
+                    std::string_view comment_str = comment.substr(1);
                     if (boost::starts_with(comment_str, GCodeProcessor::reserved_tag(GCodeProcessor::ETags::Height))) {
                         //do not write it on the gcode
                         return;
@@ -145,10 +152,12 @@ std::string SpiralVase::process_layer(const std::string &gcode)
                 new_gcode += "; End spiral transition layer\n";
                 new_gcode += "G92 E" + to_string_nozero(last_old_E, m_config.gcode_precision_e.value) + "\n";
             }
-            new_gcode += line.raw() + '\n';
+            new_gcode += parsed_line.raw_view();
+            new_gcode += '\n';
         } else {
             //milling, just copy
-            new_gcode += line.raw() + '\n';
+            new_gcode += parsed_line.raw_view();
+            new_gcode += '\n';
         }
     });
     if (m_transition_layer && !height_str.empty()) {
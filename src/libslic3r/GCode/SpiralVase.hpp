@@ -26,6 +26,8 @@ public:
 private:
     const PrintConfig  &m_config;
     GCodeReader 		m_reader;
+    // Lines of the layer being processed, kept to reuse their allocation.
+    GCodeReader::ParsedLines m_lines;
 
     bool 				m_enabled = false;
     // First spiral vase layer. Layer height has to be ramped up from zero to the target layer height.
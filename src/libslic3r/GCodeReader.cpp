@@ -1,8 +1,11 @@
 #include "GCodeReader.hpp"
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/nowide/fstream.hpp>
 #include <boost/nowide/cstdio.hpp>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
@@ -13,6 +16,10 @@
 #include <Shiny/Shiny.h>
 #include <fast_float/fast_float.h>
 
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+
 namespace Slic3r {
 
 static inline char get_extrusion_axis_char(const GCodeConfig &config)
@@ -40,7 +47,22 @@ const char* GCodeReader::parse_line_internal(const char *ptr, const char *end, G
     PROFILE_FUNC();
 
     assert(is_decimal_separator_point());
+
+    const char *c = this->tokenize_line_internal(ptr, end, gline, command);
     
+    if (gline.has(E) && m_config.use_relative_e_distances)
+        m_position[E] = 0;
+
+    if (m_verbose)
+        std::cout << gline.raw_view() << std::endl;
+
+    return c;
+}
+
+// Split the line into the command and the axis values. Does not depend on the position of the reader,
+// thus it may be called from multiple threads.
+const char* GCodeReader::tokenize_line_internal(const char *ptr, const char *end, GCodeLine &gline, std::pair<const char*, const char*> &command) const
+{
     // command and args
     const char *c = ptr;
     {
@@ -90,28 +112,21 @@ const char* GCodeReader::parse_line_internal(const char *ptr, const char *end, G
                 c = skip_word(c);
         }
     }
-    
-    if (gline.has(E) && m_config.use_relative_e_distances)
-        m_position[E] = 0;
 
     // Skip the rest of the line.
     for (; ! is_end_of_line(*c); ++ c);
 
-    // Copy the raw string including the comment, without the trailing newlines.
-    if (c > ptr) {
-        PROFILE_BLOCK(copy_raw_string);
-        gline.m_raw.assign(ptr, c);
-    }
+    // Reference the raw string including the comment, without the trailing newlines.
+    // It is copied only if the callback asks for GCodeLine::raw().
+    gline.m_raw_view = std::string_view(ptr, c - ptr);
+    gline.m_owns_raw = false;
 
-    // Skip the trailing newlines.
-	if (*c == '\r')
+    // Skip the trailing newlines. The end of a line of a memory mapped file may be the end of the mapping.
+	if (c != end && *c == '\r')
 		++ c;
-	if (*c == '\n')
+	if (c != end && *c == '\n')
 		++ c;
 
-    if (m_verbose)
-        std::cout << gline.m_raw << std::endl;
-
     return c;
 }
 
@@ -129,9 +144,77 @@ void GCodeReader::update_coordinates(GCodeLine &gline, std::pair<const char*, co
     }
 }
 
+// Finds the ends of the lines of a range: the first '\r' or '\n' of each line, or the end of the range.
+// Newlines are searched for by memchr(), which is vectorized by the C runtime. A carriage return is only searched for inside the line.
+// The next newline is remembered, so that a file with carriage return only line endings is not scanned to its end for each line.
+class EndOfLineFinder {
+public:
+    EndOfLineFinder(const char *end) : m_end(end) {}
+
+    const char* operator()(const char *begin)
+    {
+        if (m_newline == nullptr || m_newline < begin) {
+            m_newline = static_cast<const char*>(memchr(begin, '\n', m_end - begin));
+            if (m_newline == nullptr)
+                m_newline = m_end;
+        }
+        const char *cr = static_cast<const char*>(memchr(begin, '\r', m_newline - begin));
+        return cr == nullptr ? m_newline : cr;
+    }
+
+private:
+    const char *m_end;
+    const char *m_newline { nullptr };
+};
+
+template<typename ParseLineCallback, typename LineEndCallback>
+bool GCodeReader::parse_file_mapped_internal(const std::string &filename, ParseLineCallback parse_line_callback, LineEndCallback line_end_callback)
+{
+    boost::iostreams::mapped_file_source file;
+    try {
+        file.open(boost::filesystem::path(filename));
+    } catch (...) {
+        // Empty file or the file could not be mapped.
+        return false;
+    }
+    if (! file.is_open())
+        return false;
+
+    const char *begin = file.data();
+    const char *end   = begin + file.size();
+    // The last line, if it is not terminated by a newline, is copied so that the parser finds a zero terminator at its end.
+    std::string last_line;
+    EndOfLineFinder find_end_of_line(end);
+    m_parsing = true;
+    for (const char *it = begin; it != end;) {
+        const char *it_end = find_end_of_line(it);
+        if (it_end == end) {
+            last_line.assign(it, it_end);
+            parse_line_callback(last_line.c_str(), last_line.c_str() + last_line.size());
+        } else
+            parse_line_callback(it, it_end);
+        if (! m_parsing)
+            // The callback wishes to exit.
+            return true;
+        // Skip EOL.
+        it = it_end;
+        if (it != end && *it == '\r')
+            ++ it;
+        if (it != end && *it == '\n') {
+            line_end_callback(size_t(it - begin) + 1);
+            ++ it;
+        }
+    }
+    return true;
+}
+
 template<typename ParseLineCallback, typename LineEndCallback>
 bool GCodeReader::parse_file_raw_internal(const std::string &filename, ParseLineCallback parse_line_callback, LineEndCallback line_end_callback)
 {
+    // Parse the lines in place if the file could be memory mapped, otherwise read it through a buffer.
+    if (this->parse_file_mapped_internal(filename, parse_line_callback, line_end_callback))
+        return true;
+
     FilePtr in{ boost::nowide::fopen(filename.c_str(), "rb") };
 
     // Read the input stream 64kB at a time, extract lines and process them.
@@ -208,6 +291,114 @@ bool GCodeReader::parse_file(const std::string &file, callback_t callback, std::
     return this->parse_file_internal(file, callback, [&lines_ends](size_t file_pos){ lines_ends.emplace_back(file_pos); });
 }
 
+bool GCodeReader::parse_file_parallel(const std::string &filename, callback_t callback, std::vector<size_t> &lines_ends)
+{
+    lines_ends.clear();
+    boost::iostreams::mapped_file_source file;
+    try {
+        file.open(boost::filesystem::path(filename));
+    } catch (...) {
+    }
+    if (! file.is_open())
+        // Empty file or the file could not be mapped, parse it serially.
+        return this->parse_file(filename, callback, lines_ends);
+
+    // Lines of a part of the file split at a line boundary, tokenized by a worker thread.
+    struct Chunk {
+        const char             *begin;
+        const char             *end;
+        // Copy of the last line of the file if it is not terminated by a newline, so that the tokenizer finds a zero terminator.
+        std::string             last_line;
+        std::vector<GCodeLine>  lines;
+        std::vector<size_t>     lines_ends;
+    };
+    // Size of a chunk before it is extended to the next newline.
+    static constexpr const size_t chunk_size = 1024 * 1024;
+    const size_t batch_size  = size_t(std::max(1, tbb::this_task_arena::max_concurrency()));
+    const char  *file_begin  = file.data();
+    const char  *file_end    = file_begin + file.size();
+    const char  *chunk_begin = file_begin;
+
+    auto split_batch = [&](std::vector<Chunk> &batch) {
+        batch.clear();
+        while (batch.size() < batch_size && chunk_begin != file_end) {
+            const char *chunk_end = file_end;
+            if (size_t(file_end - chunk_begin) > chunk_size)
+                if (const char *eol = static_cast<const char*>(memchr(chunk_begin + chunk_size, '\n', file_end - chunk_begin - chunk_size)); eol != nullptr)
+                    chunk_end = eol + 1;
+            batch.push_back({ chunk_begin, chunk_end });
+            chunk_begin = chunk_end;
+        }
+    };
+    auto tokenize_batch = [this, file_begin, file_end](std::vector<Chunk> &batch) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, batch.size(), 1), [this, &batch, file_begin, file_end](const tbb::blocked_range<size_t> &range) {
+            for (size_t chunk_idx = range.begin(); chunk_idx < range.end(); ++ chunk_idx) {
+                Chunk &chunk = batch[chunk_idx];
+                std::pair<const char*, const char*> cmd;
+                EndOfLineFinder find_end_of_line(chunk.end);
+                for (const char *it = chunk.begin; it != chunk.end;) {
+                    const char *it_end = find_end_of_line(it);
+                    GCodeLine  &gline  = chunk.lines.emplace_back();
+                    if (it_end == file_end) {
+                        chunk.last_line.assign(it, it_end);
+                        this->tokenize_line_internal(chunk.last_line.c_str(), chunk.last_line.c_str() + chunk.last_line.size(), gline, cmd);
+                    } else
+                        this->tokenize_line_internal(it, it_end, gline, cmd);
+                    // Skip EOL.
+                    it = it_end;
+                    if (it != chunk.end && *it == '\r')
+                        ++ it;
+                    if (it != chunk.end && *it == '\n') {
+                        chunk.lines_ends.emplace_back(size_t(it - file_begin) + 1);
+                        ++ it;
+                    }
+                }
+            }
+        });
+    };
+
+    // Tokenize the next batch of chunks in parallel, while the lines of the current batch are passed to the callback
+    // in order by this thread, resolving the position of the reader.
+    std::vector<Chunk> batch, next_batch;
+    split_batch(batch);
+    tokenize_batch(batch);
+    m_parsing = true;
+    while (! batch.empty()) {
+        split_batch(next_batch);
+        tbb::task_group next_batch_tokenizer;
+        next_batch_tokenizer.run([&tokenize_batch, &next_batch]() { tokenize_batch(next_batch); });
+        try {
+            for (Chunk &chunk : batch) {
+                append(lines_ends, chunk.lines_ends);
+                for (GCodeLine &gline : chunk.lines) {
+                    std::pair<const char*, const char*> cmd;
+                    cmd.first  = skip_whitespaces(gline.raw_view().data());
+                    cmd.second = skip_word(cmd.first);
+                    if (gline.has(E) && m_config.use_relative_e_distances)
+                        m_position[E] = 0;
+                    if (m_verbose)
+                        std::cout << gline.raw_view() << std::endl;
+                    callback(*this, gline);
+                    update_coordinates(gline, cmd);
+                    if (! m_parsing)
+                        break;
+                }
+                if (! m_parsing)
+                    break;
+            }
+        } catch (...) {
+            next_batch_tokenizer.wait();
+            throw;
+        }
+        next_batch_tokenizer.wait();
+        if (! m_parsing)
+            // The callback wishes to exit.
+            break;
+        std::swap(batch, next_batch);
+    }
+    return true;
+}
+
 bool GCodeReader::parse_file_raw(const std::string &filename, raw_line_callback_t line_callback)
 {
     return this->parse_file_raw_internal(filename,
@@ -217,7 +408,7 @@ bool GCodeReader::parse_file_raw(const std::string &filename, raw_line_callback_
 
 bool GCodeReader::GCodeLine::has(char axis) const
 {
-    const char *c = m_raw.c_str();
+    const char *c = this->raw_view().data();
     // Skip the whitespaces.
     c = skip_whitespaces(c);
     // Skip the command.
@@ -240,7 +431,9 @@ bool GCodeReader::GCodeLine::has(char axis) const
 bool GCodeReader::GCodeLine::has_value(char axis, float &value) const
 {
     assert(is_decimal_separator_point());
-    const char *c = m_raw.c_str();
+    std::string_view raw = this->raw_view();
+    const char *c   = raw.data();
+    const char *end = raw.data() + raw.size();
     // Skip the whitespaces.
     c = skip_whitespaces(c);
     // Skip the command.
@@ -254,8 +447,15 @@ bool GCodeReader::GCodeLine::has_value(char axis, float &value) const
         // Check the name of the axis.
         if (*c == axis) {
             // Try to parse the numeric value.
-            char   *pend = nullptr;
-            double  v = strtod(++ c, &pend);
+            double      v;
+            const char *pend = fast_float::from_chars(++ c, end, v).ptr;
+            if (pend == c || ! is_end_of_word(*pend)) {
+                // Accept whatever strtod() accepts, such as a leading '+' in a hand written G-code.
+                // The line is followed by an end of line or by a zero terminator, strtod() stops there.
+                char *pend_strtod = nullptr;
+                v    = strtod(c, &pend_strtod);
+                pend = pend_strtod;
+            }
             if (pend != nullptr && is_end_of_word(*pend)) {
                 // The axis value has been parsed correctly.
                 value = float(v);
@@ -273,6 +473,10 @@ void GCodeReader::GCodeLine::set(const GCodeReader &reader, const Axis axis, con
     std::ostringstream ss;
     ss << std::fixed << std::setprecision(decimal_digits) << new_value;
 
+    // The line is modified, take ownership of the raw string.
+    this->raw();
+    m_raw_view = std::string_view();
+
     char match[3] = " X";
     if (int(axis) < 3)
         match[1] += int(axis);
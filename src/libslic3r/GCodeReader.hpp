@@ -7,6 +7,7 @@
 #include <functional>
 #include <string>
 #include <string_view>
+#include <vector>
 #include "PrintConfig.hpp"
 
 namespace Slic3r {
@@ -16,15 +17,40 @@ public:
     class GCodeLine {
     public:
         GCodeLine() { reset(); }
-        void reset() { m_mask = 0; memset(m_axis, 0, sizeof(m_axis)); m_raw.clear(); }
+        // A copy owns its raw string, it does not reference the parsed buffer.
+        GCodeLine(const GCodeLine &rhs) { *this = rhs; }
+        // A moved line keeps referencing the parsed buffer.
+        GCodeLine(GCodeLine &&rhs) = default;
+        GCodeLine& operator=(GCodeLine &&rhs) = default;
+        GCodeLine& operator=(const GCodeLine &rhs) {
+            if (this != &rhs) {
+                m_raw.assign(rhs.raw_view());
+                m_raw_view = std::string_view();
+                m_owns_raw = true;
+                memcpy(m_axis, rhs.m_axis, sizeof(m_axis));
+                m_mask = rhs.m_mask;
+            }
+            return *this;
+        }
+        void reset() { m_mask = 0; memset(m_axis, 0, sizeof(m_axis)); m_raw.clear(); m_raw_view = std::string_view(); m_owns_raw = true; }
 
-        const std::string&      raw() const { return m_raw; }
+        // The raw line is copied into a string on the first call only, use raw_view() if a copy is not needed.
+        const std::string&      raw() const {
+            if (! m_owns_raw) {
+                m_raw.assign(m_raw_view);
+                m_owns_raw = true;
+            }
+            return m_raw;
+        }
+        // Raw line without the trailing newlines. Valid until the parser moves to the next line, unless the line was copied.
+        // The line is always followed by an end of line character or by a zero terminator.
+        std::string_view        raw_view() const { return m_owns_raw ? std::string_view(m_raw) : m_raw_view; }
         const std::string_view  cmd() const { 
-            const char *cmd = GCodeReader::skip_whitespaces(m_raw.c_str());
+            const char *cmd = GCodeReader::skip_whitespaces(this->raw_view().data());
             return std::string_view(cmd, GCodeReader::skip_word(cmd) - cmd);
         }
         const std::string_view  comment() const
-            { size_t pos = m_raw.find(';'); return (pos == std::string::npos) ? std::string_view() : std::string_view(m_raw).substr(pos + 1); }
+            { std::string_view raw = this->raw_view(); size_t pos = raw.find(';'); return (pos == std::string::npos) ? std::string_view() : raw.substr(pos + 1); }
 
         bool  has(Axis axis) const { return (m_mask & (1 << int(axis))) != 0; }
         float value(Axis axis) const { return m_axis[axis]; }
@@ -44,7 +70,7 @@ public:
             float y = this->has(Y) ? (this->y() - reader.y()) : 0;
             return sqrt(x*x + y*y);
         }
-        bool cmd_is(const char *cmd_test)          const { return cmd_is(m_raw, cmd_test); }
+        bool cmd_is(const char *cmd_test)          const { return cmd_is(this->raw_view().data(), cmd_test); }
         bool extruding(const GCodeReader &reader)  const { return this->cmd_is("G1") && this->dist_E(reader) > 0; }
         bool retracting(const GCodeReader &reader) const { return this->cmd_is("G1") && this->dist_E(reader) < 0; }
         bool travel()     const { return this->cmd_is("G1") && ! this->has(E); }
@@ -62,14 +88,20 @@ public:
         float e() const { return m_axis[E]; }
         float f() const { return m_axis[F]; }
 
-        static bool cmd_is(const std::string &gcode_line, const char *cmd_test) {
-            const char *cmd = GCodeReader::skip_whitespaces(gcode_line.c_str());
+        static bool cmd_is(const std::string &gcode_line, const char *cmd_test) { return cmd_is(gcode_line.c_str(), cmd_test); }
+        static bool cmd_is(const char *gcode_line, const char *cmd_test) {
+            const char *cmd = GCodeReader::skip_whitespaces(gcode_line);
             size_t len = strlen(cmd_test); 
             return strncmp(cmd, cmd_test, len) == 0 && GCodeReader::is_end_of_word(cmd[len]);
         }
 
     private:
-        std::string      m_raw;
+        // Owned copy of the raw line, filled in lazily by raw() if m_raw_view points to the parsed buffer.
+        mutable std::string m_raw;
+        // Raw line inside the parsed buffer, used while the line does not own its raw string.
+        std::string_view m_raw_view;
+        // Is the text of the line in m_raw? False if it is only referenced by m_raw_view and not copied yet.
+        mutable bool     m_owns_raw { true };
         float            m_axis[NUM_AXES];
         uint32_t         m_mask;
         friend class GCodeReader;
@@ -107,6 +139,45 @@ public:
     void parse_buffer(const std::string &buffer)
         { this->parse_buffer(buffer, [](GCodeReader&, const GCodeReader::GCodeLine&){}); }
 
+    // Line tokenized by parse_buffer(buffer, lines), with the position of the reader seen by the callback of that line.
+    // The line references its text inside the parsed buffer, it is not copied.
+    struct ParsedLine {
+        GCodeLine gline;
+        float     position[NUM_AXES];
+    };
+    using ParsedLines = std::vector<ParsedLine>;
+
+    // Tokenize the buffer once, so that a filter needing several passes over a layer does not have to parse it again.
+    // The lines are valid as long as the buffer is alive and not modified.
+    void parse_buffer(const std::string &buffer, ParsedLines &lines)
+    {
+        lines.clear();
+        const char *ptr = buffer.c_str();
+        const char *end = ptr + buffer.size();
+        while (*ptr != 0) {
+            ParsedLine &line = lines.emplace_back();
+            memcpy(line.position, m_position, sizeof(m_position));
+            std::pair<const char*, const char*> cmd;
+            ptr = parse_line_internal(ptr, end, line.gline, cmd);
+            update_coordinates(line.gline, cmd);
+        }
+    }
+
+    // Call the callback for the lines tokenized by parse_buffer(buffer, lines) as if the buffer was parsed again,
+    // with the reader at the position of each line. The reader is left at the position after the last line.
+    template<typename Callback>
+    void visit_lines(const ParsedLines &lines, Callback callback)
+    {
+        float end_position[NUM_AXES];
+        memcpy(end_position, m_position, sizeof(m_position));
+        m_parsing = true;
+        for (auto it = lines.begin(); m_parsing && it != lines.end(); ++ it) {
+            memcpy(m_position, it->position, sizeof(m_position));
+            callback(*this, it->gline);
+        }
+        memcpy(m_position, end_position, sizeof(m_position));
+    }
+
     template<typename Callback>
     const char* parse_line(const char *ptr, const char *end, GCodeLine &gline, Callback &callback)
     {
@@ -126,6 +197,9 @@ public:
     // Collect positions of line ends in the binary G-code to be used by the G-code viewer when memory mapping and displaying section of G-code
     // as an overlay in the 3D scene.
     bool parse_file(const std::string &file, callback_t callback, std::vector<size_t> &lines_ends);
+    // Same as parse_file(file, callback, lines_ends), but the file is split into chunks at line boundaries, which are tokenized in parallel.
+    // The callback is still called for the lines in order by the calling thread.
+    bool parse_file_parallel(const std::string &file, callback_t callback, std::vector<size_t> &lines_ends);
     // Just read the G-code file line by line, calls callback (const char *begin, const char *end). Returns false if reading the file failed.
     bool parse_file_raw(const std::string &file, raw_line_callback_t callback);
 
@@ -148,12 +222,16 @@ public:
 //  void   set_extrusion_axis(char axis) { m_extrusion_axis = axis; }
 
 private:
+    // Memory map the file and call parse_line_callback() for the lines in place. Returns false if the file could not be mapped.
+    template<typename ParseLineCallback, typename LineEndCallback>
+    bool        parse_file_mapped_internal(const std::string &filename, ParseLineCallback parse_line_callback, LineEndCallback line_end_callback);
     template<typename ParseLineCallback, typename LineEndCallback>
     bool        parse_file_raw_internal(const std::string &filename, ParseLineCallback parse_line_callback, LineEndCallback line_end_callback);
     template<typename ParseLineCallback, typename LineEndCallback>
     bool        parse_file_internal(const std::string &filename, ParseLineCallback parse_line_callback, LineEndCallback line_end_callback);
 
     const char* parse_line_internal(const char *ptr, const char *end, GCodeLine &gline, std::pair<const char*, const char*> &command);
+    const char* tokenize_line_internal(const char *ptr, const char *end, GCodeLine &gline, std::pair<const char*, const char*> &command) const;
     void        update_coordinates(GCodeLine &gline, std::pair<const char*, const char*> &command);
 
     static bool         is_whitespace(char c)           { return c == ' ' || c == '\t'; }
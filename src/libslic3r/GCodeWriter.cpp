@@ -6,6 +6,9 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <map>
@@ -20,15 +23,87 @@
 
 #define FLAVOR_IS(val) this->config.gcode_flavor.value == val
 #define FLAVOR_IS_NOT(val) this->config.gcode_flavor.value != val
-// TODO: switch to gcodeformatter classes
-#define COMMENT(comment) if (this->config.gcode_comments.value && !comment.empty()) gcode << " ; " << comment;
-#define PRECISION(val, precision) to_string_nozero(val, precision)
-#define XYZ_NUM(val) PRECISION(val, this->config.gcode_precision_xyz.value)
-#define FLOAT_PRECISION(val, precision) std::defaultfloat << std::setprecision(precision) << (val)
-#define F_NUM(val) FLOAT_PRECISION(val, 8)
-#define E_NUM(val) PRECISION(val, this->config.gcode_precision_e.value)
+#define COMMENT(comment) if (this->config.gcode_comments.value && !comment.empty()) { gcode += " ; "; gcode += comment; }
+#define XYZ_NUM(val) num_nozero(val, this->config.gcode_precision_xyz.value)
+#define E_NUM(val) num_nozero(val, this->config.gcode_precision_e.value)
 namespace Slic3r {
 
+// The writer appends to a std::string instead of using std::ostringstream: no stream & locale object per line,
+// and no allocation at all when the caller reuses its buffer (see the methods with a "std::string &gcode" parameter).
+// The numbers are written with snprintf, as the G-code is always generated with the "C" locale (see CNumericLocalesSetter).
+namespace {
+
+inline void append_int(std::string &out, int64_t value)
+{
+    char  buf[24];
+    char *end = buf + sizeof(buf);
+    char *ptr = end;
+    uint64_t v = value < 0 ? uint64_t(-(value + 1)) + 1 : uint64_t(value);
+    do {
+        *--ptr = char('0' + v % 10);
+        v /= 10;
+    } while (v != 0);
+    if (value < 0)
+        *--ptr = '-';
+    out.append(ptr, end);
+}
+
+// Same output as to_string_nozero(value, max_precision).
+void append_num_nozero(std::string &out, double value, int32_t max_precision)
+{
+    assert(is_decimal_separator_point()); // for the sprintfs
+    // big enough for a "%f" of any double
+    char buf[400];
+    int  len;
+    double intpart;
+    if (modf(value, &intpart) == 0.0) {
+        //shortcut for int, same as std::to_string(intpart)
+        len = snprintf(buf, sizeof(buf), "%f", intpart);
+    } else {
+        //first, get the int part, to see how many digit it takes
+        int long10 = 0;
+        if (intpart > 9)
+            long10 = (int)std::floor(std::log10(std::abs(intpart)));
+        //set the usable precision: there is only 15-16 decimal digit in a double
+        len = snprintf(buf, sizeof(buf), "%.*f", int(std::min(15 - long10, int(max_precision))), value);
+        if (memchr(buf, '.', len) != nullptr) {
+            while (len > 1 && buf[len - 1] == '0')
+                --len;
+            // remove the '.' at the end of the int
+            if (len > 1 && buf[len - 1] == '.')
+                --len;
+        }
+    }
+    out.append(buf, len);
+}
+
+inline std::string num_nozero(double value, int32_t max_precision)
+{
+    std::string out;
+    append_num_nozero(out, value, max_precision);
+    return out;
+}
+
+// Same output as "std::defaultfloat << std::setprecision(8) << value"
+inline void append_f_num(std::string &out, double value)
+{
+    assert(is_decimal_separator_point()); // for the sprintfs
+    char buf[32];
+    int  len = snprintf(buf, sizeof(buf), "%.8g", value);
+    out.append(buf, len);
+}
+
+// Same output as "std::ostream << value" with default stream flags.
+inline void append_g_num(std::string &out, double value)
+{
+    assert(is_decimal_separator_point()); // for the sprintfs
+    char buf[32];
+    int  len = snprintf(buf, sizeof(buf), "%g", value);
+    out.append(buf, len);
+}
+
+} // namespace
+
 std::string GCodeWriter::get_default_pause_gcode(const GCodeConfig &config)
 {
     if (config.pause_print_gcode.value.empty()) {
@@ -141,11 +216,11 @@ void GCodeWriter::set_mills(std::vector<uint16_t> mill_ids)
 
 std::string GCodeWriter::preamble()
 {
-    std::ostringstream gcode;
+    std::string gcode;
     
     if (FLAVOR_IS_NOT(gcfMakerWare)) {
-        gcode << "G21 ; set units to millimeters\n";
-        gcode << "G90 ; use absolute coordinates\n";
+        gcode += "G21 ; set units to millimeters\n";
+        gcode += "G90 ; use absolute coordinates\n";
     }
     if (FLAVOR_IS(gcfSprinter) ||
         FLAVOR_IS(gcfRepRap) ||
@@ -158,22 +233,22 @@ std::string GCodeWriter::preamble()
         FLAVOR_IS(gcfKlipper))
     {
         if (this->config.use_relative_e_distances) {
-            gcode << "M83 ; use relative distances for extrusion\n";
+            gcode += "M83 ; use relative distances for extrusion\n";
         } else {
-            gcode << "M82 ; use absolute distances for extrusion\n";
+            gcode += "M82 ; use absolute distances for extrusion\n";
         }
-        gcode << this->reset_e(true);
+        gcode += this->reset_e(true);
     }
     
-    return gcode.str();
+    return gcode;
 }
 
 std::string GCodeWriter::postamble() const
 {
-    std::ostringstream gcode;
+    std::string gcode;
     if (FLAVOR_IS(gcfMachinekit))
-          gcode << "M2 ; end of program\n";
-    return gcode.str();
+          gcode += "M2 ; end of program\n";
+    return gcode;
 }
 
 std::string GCodeWriter::set_temperature(const int16_t temperature, bool wait, int tool)
@@ -193,7 +268,7 @@ std::string GCodeWriter::set_temperature(const int16_t temperature, bool wait, i
     if (wait && (FLAVOR_IS(gcfMakerWare) || FLAVOR_IS(gcfSailfish)))
         return "";
     
-    std::string code, comment;
+    const char *code, *comment;
     if (wait && FLAVOR_IS_NOT(gcfTeacup) && FLAVOR_IS_NOT(gcfRepRap)) {
         code = "M109";
         comment = "set temperature and wait for it to be reached";
@@ -206,31 +281,37 @@ std::string GCodeWriter::set_temperature(const int16_t temperature, bool wait, i
         comment = "set temperature";
     }
     
-    std::ostringstream gcode;
-    gcode << code << " ";
+    std::string gcode;
+    gcode += code;
+    gcode += ' ';
     if (FLAVOR_IS(gcfMach3) || FLAVOR_IS(gcfMachinekit)) {
-        gcode << "P";
+        gcode += 'P';
     } else if (FLAVOR_IS(gcfRepRap)) {
-        gcode << "P" << tool << " S";
+        gcode += 'P';
+        append_int(gcode, tool);
+        gcode += " S";
     } else if (wait && (FLAVOR_IS(gcfMarlinFirmware) || FLAVOR_IS(gcfMarlinLegacy)) && temp_w_offset < m_last_temperature_with_offset) {
-        gcode << "R"; //marlin doesn't wait with S if it's a cooling change, it needs a R
+        gcode += 'R'; //marlin doesn't wait with S if it's a cooling change, it needs a R
     } else {
-        gcode << "S";
+        gcode += 'S';
     }
-    gcode << temp_w_offset;
+    append_int(gcode, temp_w_offset);
     bool multiple_tools = this->multiple_extruders && ! m_single_extruder_multi_material;
     if (tool != -1 && (multiple_tools || FLAVOR_IS(gcfMakerWare) || FLAVOR_IS(gcfSailfish)) && FLAVOR_IS_NOT(gcfRepRap)) {
-        gcode << " T" << tool;
+        gcode += " T";
+        append_int(gcode, tool);
     }
-    gcode << " ; " << comment << "\n";
+    gcode += " ; ";
+    gcode += comment;
+    gcode += '\n';
     
     if ((FLAVOR_IS(gcfTeacup) || FLAVOR_IS(gcfRepRap)) && wait)
-        gcode << "M116 ; wait for temperature to be reached\n";
+        gcode += "M116 ; wait for temperature to be reached\n";
     
     m_last_temperature = temperature;
     m_last_temperature_with_offset = temp_w_offset;
 
-    return gcode.str();
+    return gcode;
 }
 
 std::string GCodeWriter::set_bed_temperature(uint32_t temperature, bool wait)
@@ -241,7 +322,7 @@ std::string GCodeWriter::set_bed_temperature(uint32_t temperature, bool wait)
     m_last_bed_temperature = temperature;
     m_last_bed_temperature_reached = wait;
 
-    std::string code, comment;
+    const char *code, *comment;
     if (wait && FLAVOR_IS_NOT(gcfTeacup)) {
         if (FLAVOR_IS(gcfMakerWare) || FLAVOR_IS(gcfSailfish)) {
             code = "M109";
@@ -254,19 +335,23 @@ std::string GCodeWriter::set_bed_temperature(uint32_t temperature, bool wait)
         comment = "set bed temperature";
     }
     
-    std::ostringstream gcode;
-    gcode << code << " ";
+    std::string gcode;
+    gcode += code;
+    gcode += ' ';
     if (FLAVOR_IS(gcfMach3) || FLAVOR_IS(gcfMachinekit)) {
-        gcode << "P";
+        gcode += 'P';
     } else {
-        gcode << "S";
+        gcode += 'S';
     }
-    gcode << temperature << " ; " << comment << "\n";
+    append_int(gcode, temperature);
+    gcode += " ; ";
+    gcode += comment;
+    gcode += '\n';
     
     if (FLAVOR_IS(gcfTeacup) && wait)
-        gcode << "M116 ; wait for bed temperature to be reached\n";
+        gcode += "M116 ; wait for bed temperature to be reached\n";
     
-    return gcode.str();
+    return gcode;
 }
 
 
@@ -297,49 +382,67 @@ uint32_t GCodeWriter::get_acceleration() const
     return m_current_acceleration;
 }
 
-std::string GCodeWriter::write_acceleration(){
+std::string GCodeWriter::write_acceleration()
+{
+    std::string gcode;
+    this->write_acceleration(gcode);
+    return gcode;
+}
+
+void GCodeWriter::write_acceleration(std::string &gcode)
+{
     bool need_write_travel_accel = (FLAVOR_IS(gcfMarlinFirmware) || FLAVOR_IS(gcfRepRap)) &&
                                    m_current_travel_acceleration != m_last_travel_acceleration;
     bool need_write_main_accel = m_current_acceleration != m_last_acceleration &&
                                  m_current_acceleration != 0;
     if (!need_write_main_accel && !need_write_travel_accel)
-        return "";
+        return;
 
     m_last_acceleration = m_current_acceleration;
     m_last_travel_acceleration = m_current_travel_acceleration;
 
-    std::ostringstream gcode;
+    const size_t start = gcode.size();
 	//try to set only printing acceleration, travel should be untouched if possible
     if (FLAVOR_IS(gcfRepetier)) {
         // M201: Set max printing acceleration
-        if (m_current_acceleration > 0)
-            gcode << "M201 X" << m_current_acceleration << " Y" << m_current_acceleration;
+        if (m_current_acceleration > 0) {
+            gcode += "M201 X";
+            append_int(gcode, m_current_acceleration);
+            gcode += " Y";
+            append_int(gcode, m_current_acceleration);
+        }
     } else if(FLAVOR_IS(gcfLerdge) || FLAVOR_IS(gcfSprinter)){
         // M204: Set printing acceleration
         // This is new MarlinFirmware with separated print/retraction/travel acceleration.
         // Use M204 P, we don't want to override travel acc by M204 S (which is deprecated anyway).
-        if (m_current_acceleration > 0)
-            gcode << "M204 P" << m_current_acceleration;
+        if (m_current_acceleration > 0) {
+            gcode += "M204 P";
+            append_int(gcode, m_current_acceleration);
+        }
     } else if (FLAVOR_IS(gcfMarlinFirmware) || FLAVOR_IS(gcfRepRap)) {
         // M204: Set printing & travel acceleration
-        if (m_current_acceleration > 0)
-            gcode << "M204 P" << m_current_acceleration << " T" << (m_current_travel_acceleration > 0 ? m_current_travel_acceleration : m_current_acceleration);
-        else if(m_current_travel_acceleration > 0)
-            gcode << "M204 T" << m_current_travel_acceleration;
+        if (m_current_acceleration > 0) {
+            gcode += "M204 P";
+            append_int(gcode, m_current_acceleration);
+            gcode += " T";
+            append_int(gcode, m_current_travel_acceleration > 0 ? m_current_travel_acceleration : m_current_acceleration);
+        } else if (m_current_travel_acceleration > 0) {
+            gcode += "M204 T";
+            append_int(gcode, m_current_travel_acceleration);
+        }
     } else { // gcfMarlinLegacy
         // M204: Set default acceleration
-        if (m_current_acceleration > 0)
-            gcode << "M204 S" << m_current_acceleration;
+        if (m_current_acceleration > 0) {
+            gcode += "M204 S";
+            append_int(gcode, m_current_acceleration);
+        }
     }
     //if at least something, add comment and line return
-    if (gcode.tellp() != std::streampos(0)) {
+    if (gcode.size() != start) {
         if (this->config.gcode_comments)
-            gcode << " ; adjust acceleration";
-        gcode << "\n";
-        return gcode.str();
+            gcode += " ; adjust acceleration";
+        gcode += '\n';
     }
-    assert(gcode.str().empty());
-    return "";
 }
 
 std::string GCodeWriter::reset_e(bool force)
@@ -358,11 +461,12 @@ std::string GCodeWriter::reset_e(bool force)
     }
 
     if (! m_extrusion_axis.empty() && ! this->config.use_relative_e_distances) {
-        std::ostringstream gcode;
-        gcode << "G92 " << m_extrusion_axis << "0";
-        if (this->config.gcode_comments) gcode << " ; reset extrusion distance";
-        gcode << "\n";
-        return gcode.str();
+        std::string gcode = "G92 ";
+        gcode += m_extrusion_axis;
+        gcode += '0';
+        if (this->config.gcode_comments) gcode += " ; reset extrusion distance";
+        gcode += '\n';
+        return gcode;
     } else {
         return "";
     }
@@ -376,11 +480,11 @@ std::string GCodeWriter::update_progress(uint32_t num, uint32_t tot, bool allow_
     uint8_t percent = (uint32_t)floor(100.0 * num / tot + 0.5);
     if (!allow_100) percent = std::min(percent, (uint8_t)99);
     
-    std::ostringstream gcode;
-    gcode << "M73 P" << int(percent);
-    if (this->config.gcode_comments) gcode << " ; update progress";
-    gcode << "\n";
-    return gcode.str();
+    std::string gcode = "M73 P";
+    append_int(gcode, int(percent));
+    if (this->config.gcode_comments) gcode += " ; update progress";
+    gcode += '\n';
+    return gcode;
 }
 
 std::string GCodeWriter::toolchange_prefix() const
@@ -417,48 +521,50 @@ std::string GCodeWriter::toolchange(uint16_t tool_id)
 
     // return the toolchange command
     // if we are running a single-extruder setup, just set the extruder and return nothing
-    std::ostringstream gcode;
+    std::string gcode;
     if (this->multiple_extruders) {
+        gcode += this->toolchange_prefix();
         if (FLAVOR_IS(gcfKlipper)) {
             //check if we can use the tool_name field or not
             if (tool_id > 0 && tool_id < this->config.tool_name.values.size() && !this->config.tool_name.values[tool_id].empty()
                 // NOTE: this will probably break if there's more than 10 tools, as it's relying on the
                 // ASCII character table.
                 && this->config.tool_name.values[tool_id][0] != static_cast<char>(('0' + tool_id))) {
-                gcode << this->toolchange_prefix() << this->config.tool_name.values[tool_id];
+                gcode += this->config.tool_name.values[tool_id];
             } else {
-                gcode << this->toolchange_prefix() << "extruder";
+                gcode += "extruder";
                 if (tool_id > 0)
-                    gcode << tool_id;
+                    append_int(gcode, tool_id);
             }
         } else {
-            gcode << this->toolchange_prefix() << tool_id;
+            append_int(gcode, tool_id);
         }
         if (this->config.gcode_comments)
-            gcode << " ; change extruder";
-        gcode << "\n";
-        gcode << this->reset_e(true);
+            gcode += " ; change extruder";
+        gcode += '\n';
+        gcode += this->reset_e(true);
     }
-    return gcode.str();
+    return gcode;
 }
 
 std::string GCodeWriter::set_speed(const double speed, const std::string &comment, const std::string &cooling_marker)
+{
+    std::string gcode;
+    this->set_speed(gcode, speed, comment, cooling_marker);
+    return gcode;
+}
+
+void GCodeWriter::set_speed(std::string &gcode, const double speed, const std::string &comment, const std::string &cooling_marker)
 {
     const double F = speed * 60;
     m_current_speed = speed;
     assert(F > 0.);
     assert(F < 10000000.);
-//    GCodeG1Formatter w;
-//    w.emit_f(F);
-//    w.emit_comment(this->config.gcode_comments, comment);
-//    w.emit_string(cooling_marker);
-//    return w.string();
-    std::ostringstream gcode;
-    gcode << "G1 F" << F_NUM(F);
+    gcode += "G1 F";
+    append_f_num(gcode, F);
     COMMENT(comment);
-    gcode << cooling_marker;
-    gcode << "\n";
-    return gcode.str();
+    gcode += cooling_marker;
+    gcode += '\n';
 }
 
 double GCodeWriter::get_speed() const
@@ -468,8 +574,15 @@ double GCodeWriter::get_speed() const
 
 std::string GCodeWriter::travel_to_xy(const Vec2d &point, const double speed, const std::string &comment)
 {
-    std::ostringstream gcode;
-    gcode << write_acceleration();
+    std::string gcode;
+    this->travel_to_xy(gcode, point, speed, comment);
+    return gcode;
+}
+
+void GCodeWriter::travel_to_xy(std::string &gcode, const Vec2d &point, const double speed, const std::string &comment)
+{
+    const size_t start = gcode.size();
+    this->write_acceleration(gcode);
 
     double travel_speed = this->config.travel_speed.value;
     if ((speed > 0) & (speed < travel_speed))
@@ -479,7 +592,9 @@ std::string GCodeWriter::travel_to_xy(const Vec2d &point, const double speed, co
     std::string str_y = XYZ_NUM(point.y());
     if (!m_pos_str_x.empty() && m_pos_str_x == str_x && m_pos_str_y == str_y) {
         //if point too close to the other, then do not write it, it's useless.
-        return "";
+        // (the acceleration is dropped with it, as it was already marked as written)
+        gcode.resize(start);
+        return;
     }
 
     m_pos.x() = point.x();
@@ -487,17 +602,14 @@ std::string GCodeWriter::travel_to_xy(const Vec2d &point, const double speed, co
     m_pos_str_x = std::move(str_x);
     m_pos_str_y = std::move(str_y);
 
-//    GCodeG1Formatter w;
-//    w.emit_xy(point);
-//    w.emit_f(this->config.travel_speed.value * 60.0);
-//    w.emit_comment(this->config.gcode_comments, comment);
-//    return w.string();
-    gcode << "G1 X" << m_pos_str_x
-          <<   " Y" << m_pos_str_y
-          <<   " F" << F_NUM(travel_speed * 60);
+    gcode += "G1 X";
+    gcode += m_pos_str_x;
+    gcode += " Y";
+    gcode += m_pos_str_y;
+    gcode += " F";
+    append_f_num(gcode, travel_speed * 60);
     COMMENT(comment);
-    gcode << "\n";
-    return gcode.str();
+    gcode += '\n';
 }
 
 std::string GCodeWriter::travel_to_xyz(const Vec3d &point, const double speed, const std::string &comment)
@@ -532,22 +644,33 @@ std::string GCodeWriter::travel_to_xyz(const Vec3d &point, const double speed, c
     if ((speed > 0) & (speed < travel_speed))
         travel_speed = speed;
 
-    std::ostringstream gcode;
-    gcode << write_acceleration();
-    gcode << "G1 X" << m_pos_str_x
-          << " Y" << m_pos_str_y;
+    std::string gcode;
+    this->write_acceleration(gcode);
+    gcode += "G1 X";
+    gcode += m_pos_str_x;
+    gcode += " Y";
+    gcode += m_pos_str_y;
+    gcode += " Z";
     if (config.z_step > SCALING_FACTOR)
-        gcode << " Z" << PRECISION(point.z(), 6);
+        append_num_nozero(gcode, point.z(), 6);
     else
-        gcode << " Z" << XYZ_NUM(point.z());
-    gcode <<   " F" << F_NUM(travel_speed * 60);
+        append_num_nozero(gcode, point.z(), this->config.gcode_precision_xyz.value);
+    gcode += " F";
+    append_f_num(gcode, travel_speed * 60);
 
     COMMENT(comment);
-    gcode << "\n";
-    return gcode.str();
+    gcode += '\n';
+    return gcode;
 }
 
 std::string GCodeWriter::travel_to_z(double z, const std::string &comment)
+{
+    std::string gcode;
+    this->travel_to_z(gcode, z, comment);
+    return gcode;
+}
+
+void GCodeWriter::travel_to_z(std::string &gcode, double z, const std::string &comment)
 {
     /*  If target Z is lower than current Z but higher than nominal Z
         we don't perform the move but we only adjust the nominal Z by
@@ -558,38 +681,34 @@ std::string GCodeWriter::travel_to_z(double z, const std::string &comment)
         m_lifted -= (z - nominal_z);
         if (std::abs(m_lifted) < EPSILON)
             m_lifted = 0.;
-        return "";
+        return;
     }
     /*  In all the other cases, we perform an actual Z move and cancel
         the lift. */
     m_lifted = 0;
-    return this->_travel_to_z(z, comment);
+    this->_travel_to_z(gcode, z, comment);
 }
 
-std::string GCodeWriter::_travel_to_z(double z, const std::string &comment)
+void GCodeWriter::_travel_to_z(std::string &gcode, double z, const std::string &comment)
 {
     m_pos.z() = z;
 
-    std::ostringstream gcode;
-
-    gcode << write_acceleration();    if (config.z_step > SCALING_FACTOR)
-        gcode << "G1 Z" << PRECISION(z, 6);
+    this->write_acceleration(gcode);
+    gcode += "G1 Z";
+    const size_t z_pos = gcode.size();
+    if (config.z_step > SCALING_FACTOR)
+        append_num_nozero(gcode, z, 6);
     else
-        gcode << "G1 Z" << XYZ_NUM(z);
+        append_num_nozero(gcode, z, this->config.gcode_precision_xyz.value);
+    // replace 'Z-0' by 'Z0'
+    if (gcode.size() == z_pos + 2 && gcode[z_pos] == '-' && gcode[z_pos + 1] == '0')
+        gcode.erase(z_pos, 1);
 
     const double speed = this->config.travel_speed_z.value == 0.0 ? this->config.travel_speed.value : this->config.travel_speed_z.value;
-    gcode <<   " F" << F_NUM(speed * 60.0);
+    gcode += " F";
+    append_f_num(gcode, speed * 60.0);
     COMMENT(comment);
-    gcode << "\n";
-    // replace 'Z-0' by ' Z0'
-    std::string str = gcode.str();
-    if (auto it = str.find("Z-0 "); it != std::string::npos) {
-        str.replace(it, 2, "Z");
-    }
-    if (auto it = str.find("Z-0\n"); it != std::string::npos) {
-        str.replace(it, 2, "Z");
-    }
-    return str;
+    gcode += '\n';
 }
 
 bool GCodeWriter::will_move_z(double z) const
@@ -623,6 +742,13 @@ std::pair<std::string, bool> GCodeWriter::_compute_de(double dE)
 }
 
 std::string GCodeWriter::extrude_to_xy(const Vec2d &point, double dE, const std::string &comment)
+{
+    std::string gcode;
+    this->extrude_to_xy(gcode, point, dE, comment);
+    return gcode;
+}
+
+void GCodeWriter::extrude_to_xy(std::string &gcode, const Vec2d &point, double dE, const std::string &comment)
 {
     assert(dE == dE);
     assert(m_pos.x() != point.x() || m_pos.y() != point.y());
@@ -631,7 +757,7 @@ std::string GCodeWriter::extrude_to_xy(const Vec2d &point, double dE, const std:
     if (!m_pos_str_x.empty() && m_pos_str_x == str_x && m_pos_str_y == str_y) {
         //if point too close to the other, then do not write it, it's useless.
         this->m_de_left += dE;
-        return "";
+        return;
     }
     m_pos.x() = point.x();
     m_pos.y() = point.y();
@@ -639,21 +765,31 @@ std::string GCodeWriter::extrude_to_xy(const Vec2d &point, double dE, const std:
     m_pos_str_y = std::move(str_y);
     auto [e_str, is_extrude] = this->_compute_de(dE);
 
-    std::ostringstream gcode;
-    gcode << write_acceleration();
-    gcode << "G1 X" << m_pos_str_x
-        << " Y" << m_pos_str_y;
-    if(is_extrude)
-        gcode <<    " " << m_extrusion_axis << e_str;
+    this->write_acceleration(gcode);
+    gcode += "G1 X";
+    gcode += m_pos_str_x;
+    gcode += " Y";
+    gcode += m_pos_str_y;
+    if (is_extrude) {
+        gcode += ' ';
+        gcode += m_extrusion_axis;
+        gcode += e_str;
+    }
     COMMENT(comment);
-    gcode << "\n";
-    return gcode.str();
+    gcode += '\n';
 }
 
 //BBS: generate G2 or G3 extrude which moves by arc
 //point is end point which means X and Y axis
 //center_offset is I and J axis
 std::string GCodeWriter::extrude_arc_to_xy(const Vec2d& point, const Vec2d& center_offset, double dE, const bool is_ccw, const std::string& comment)
+{
+    std::string gcode;
+    this->extrude_arc_to_xy(gcode, point, center_offset, dE, is_ccw, comment);
+    return gcode;
+}
+
+void GCodeWriter::extrude_arc_to_xy(std::string &gcode, const Vec2d& point, const Vec2d& center_offset, double dE, const bool is_ccw, const std::string& comment)
 {
     m_pos.x() = point.x();
     m_pos.y() = point.y();
@@ -668,10 +804,17 @@ std::string GCodeWriter::extrude_arc_to_xy(const Vec2d& point, const Vec2d& cent
         w.emit(m_extrusion_axis, e_str);
     //BBS
     w.emit_comment(this->config.gcode_comments, comment);
-    return w.string();
+    w.append_to(gcode);
 }
 
 std::string GCodeWriter::extrude_to_xyz(const Vec3d &point, double dE, const std::string &comment)
+{
+    std::string gcode;
+    this->extrude_to_xyz(gcode, point, dE, comment);
+    return gcode;
+}
+
+void GCodeWriter::extrude_to_xyz(std::string &gcode, const Vec3d &point, double dE, const std::string &comment)
 {
     assert(dE == dE);
     m_pos.x() = point.x();
@@ -681,48 +824,53 @@ std::string GCodeWriter::extrude_to_xyz(const Vec3d &point, double dE, const std
     m_lifted = 0;
     auto [e_str, is_extrude] = this->_compute_de(dE);
 
-//    GCodeG1Formatter w;
-//    w.emit_xyz(point);
-//    w.emit_e(m_extrusion_axis, m_extruder->E());
-//    w.emit_comment(this->config.gcode_comments, comment);
-//    return w.string();
-    std::ostringstream gcode;
-    gcode << write_acceleration();
-    gcode << "G1 X" << m_pos_str_x
-        << " Y" << m_pos_str_y
-        << " Z" << XYZ_NUM(point.z() + m_pos.z());
-    if (is_extrude)
-            gcode <<    " " << m_extrusion_axis << e_str;
-    COMMENT(comment);
-    gcode << "\n";
-    // replace 'Z-0' by ' Z0'
-    std::string str = gcode.str();
-    if (auto it = str.find("Z-0 "); it != std::string::npos) {
-        str.replace(it, 2, "Z");
-    }
-    if (auto it = str.find("Z-0\n"); it != std::string::npos) {
-        str.replace(it, 2, "Z");
+    this->write_acceleration(gcode);
+    gcode += "G1 X";
+    gcode += m_pos_str_x;
+    gcode += " Y";
+    gcode += m_pos_str_y;
+    gcode += " Z";
+    const size_t z_pos = gcode.size();
+    append_num_nozero(gcode, point.z() + m_pos.z(), this->config.gcode_precision_xyz.value);
+    // replace 'Z-0' by 'Z0'
+    if (gcode.size() == z_pos + 2 && gcode[z_pos] == '-' && gcode[z_pos + 1] == '0')
+        gcode.erase(z_pos, 1);
+    if (is_extrude) {
+        gcode += ' ';
+        gcode += m_extrusion_axis;
+        gcode += e_str;
     }
-    return str;
+    COMMENT(comment);
+    gcode += '\n';
 }
 
 std::string GCodeWriter::retract(bool before_wipe)
+{
+    std::string gcode;
+    this->retract(gcode, before_wipe);
+    return gcode;
+}
+
+void GCodeWriter::retract(std::string &gcode, bool before_wipe)
 {
     double factor = before_wipe ? m_tool->retract_before_wipe() : 1.;
     assert((factor >= 0. || before_wipe) && factor <= 1. + EPSILON);
     // if before_wipe but no retract_before_wipe, then no retract
     if (factor == 0)
-        return "";
+        return;
     //check for override
     if (config_region && config_region->print_retract_length >= 0) {
-        return this->_retract(
+        this->_retract(
+            gcode,
             factor * config_region->print_retract_length,
             factor * m_tool->retract_restart_extra(),
             std::nullopt,
             "retract"
         );
+        return;
     }
-    return this->_retract(
+    this->_retract(
+        gcode,
         factor * m_tool->retract_length(),
         factor * m_tool->retract_restart_extra(),
         std::nullopt,
@@ -734,18 +882,19 @@ std::string GCodeWriter::retract_for_toolchange(bool before_wipe)
 {
     double factor = before_wipe ? m_tool->retract_before_wipe() : 1.;
     assert(factor >= 0. && factor <= 1. + EPSILON);
-    return this->_retract(
+    std::string gcode;
+    this->_retract(
+        gcode,
         factor * m_tool->retract_length_toolchange(),
         std::nullopt,
         factor * m_tool->retract_restart_extra_toolchange(),
         "retract for toolchange"
     );
+    return gcode;
 }
 
-std::string GCodeWriter::_retract(double length, std::optional<double> restart_extra, std::optional<double> restart_extra_toolchange, const std::string &comment)
+void GCodeWriter::_retract(std::string &gcode, double length, std::optional<double> restart_extra, std::optional<double> restart_extra_toolchange, const std::string &comment)
 {
-    std::ostringstream gcode;
-    
     /*  If firmware retraction is enabled, we use a fake value of 1
         since we ignore the actual configured retract_length which 
         might be 0, in which case the retraction logic gets skipped. */
@@ -775,58 +924,54 @@ std::string GCodeWriter::_retract(double length, std::optional<double> restart_e
     if (dE != 0) {
         if (this->config.use_firmware_retraction) {
             if (FLAVOR_IS(gcfMachinekit))
-                gcode << "G22 ; retract\n";
+                gcode += "G22 ; retract\n";
             else
-                gcode << "G10 ; retract\n";
+                gcode += "G10 ; retract\n";
         } else if (! m_extrusion_axis.empty()) {
-//            GCodeG1Formatter w;
-//            w.emit_e(m_extrusion_axis, m_extruder->E());
-//            w.emit_f(m_extruder->retract_speed() * 60.);
-//            w.emit_comment(this->config.gcode_comments, comment);
-//            gcode = w.string();
-            gcode << "G1 " << m_extrusion_axis << E_NUM(m_tool->E())
-                           << " F" << F_NUM(m_tool->retract_speed() * 60.);
+            gcode += "G1 ";
+            gcode += m_extrusion_axis;
+            append_num_nozero(gcode, m_tool->E(), this->config.gcode_precision_e.value);
+            gcode += " F";
+            append_f_num(gcode, m_tool->retract_speed() * 60.);
             COMMENT(comment);
-            gcode << "\n";
+            gcode += '\n';
         }
     }
     
     if (FLAVOR_IS(gcfMakerWare))
-        gcode << "M103 ; extruder off\n";
-    
-    return gcode.str();
+        gcode += "M103 ; extruder off\n";
 }
 
 std::string GCodeWriter::unretract()
 {
-    std::ostringstream gcode;
-//    std::string gcode;
-    
+    std::string gcode;
+    this->unretract(gcode);
+    return gcode;
+}
+
+void GCodeWriter::unretract(std::string &gcode)
+{
     if (FLAVOR_IS(gcfMakerWare))
-        gcode << "M101 ; extruder on\n";
+        gcode += "M101 ; extruder on\n";
     
     double dE = m_tool->unretract();
     assert(dE >= 0);
     assert(dE < 10000000);
     if (dE != 0) {
         if (this->config.use_firmware_retraction) {
-            gcode << (FLAVOR_IS(gcfMachinekit) ? "G23 ; unretract\n" : "G11 ; unretract\n");
-            gcode << this->reset_e();
+            gcode += (FLAVOR_IS(gcfMachinekit) ? "G23 ; unretract\n" : "G11 ; unretract\n");
+            gcode += this->reset_e();
         } else if (! m_extrusion_axis.empty()) {
             // use G1 instead of G0 because G0 will blend the restart with the previous travel move
-//            GCodeG1Formatter w;
-//            w.emit_e(m_extrusion_axis, m_tool->E());
-//            w.emit_f(m_tool->deretract_speed() * 60.);
-//            w.emit_comment(this->config.gcode_comments, " ; unretract");
-//            gcode += w.string();
-            gcode << "G1 " << m_extrusion_axis << E_NUM(m_tool->E())
-                           << " F" << F_NUM(m_tool->deretract_speed() * 60.);
-            if (this->config.gcode_comments) gcode << " ; unretract";
-            gcode << "\n";
+            gcode += "G1 ";
+            gcode += m_extrusion_axis;
+            append_num_nozero(gcode, m_tool->E(), this->config.gcode_precision_e.value);
+            gcode += " F";
+            append_f_num(gcode, m_tool->deretract_speed() * 60.);
+            if (this->config.gcode_comments) gcode += " ; unretract";
+            gcode += '\n';
         }
     }
-    
-    return gcode.str();
 }
 
 /*  If this method is called more than once before calling unlift(),
@@ -865,7 +1010,8 @@ std::string GCodeWriter::lift(int layer_id)
     // and subtracting layer_height from retract_lift might not give
     // exactly zero
     if (std::abs(m_lifted) < target_lift - EPSILON && target_lift > 0) {
-        std::string str =  this->_travel_to_z(m_pos.z() + target_lift - m_lifted, "lift Z");
+        std::string str;
+        this->_travel_to_z(str, m_pos.z() + target_lift - m_lifted, "lift Z");
         m_lifted = target_lift;
         return str;
     }
@@ -876,7 +1022,7 @@ std::string GCodeWriter::unlift()
 {
     std::string gcode;
     if (m_lifted > 0) {
-        gcode += this->_travel_to_z(m_pos.z() - m_lifted, "restore layer Z");
+        this->_travel_to_z(gcode, m_pos.z() - m_lifted, "restore layer Z");
     }
     m_lifted = 0;
     return gcode;
@@ -884,39 +1030,7 @@ std::string GCodeWriter::unlift()
 
 std::string GCodeWriter::set_fan(const GCodeFlavor gcode_flavor, bool gcode_comments, uint8_t speed, uint8_t tool_fan_offset, bool is_fan_percentage, const std::string comment/*=""*/)
 {
-/*
-    std::ostringstream gcode;
-    if (speed == 0) {
-        switch (gcode_flavor) {
-        case gcfTeacup:
-            gcode << "M106 S0"; break;
-        case gcfMakerWare:
-        case gcfSailfish:
-            gcode << "M127";    break;
-        default:
-            gcode << "M107";    break;
-        }
-        if (gcode_comments)
-            gcode << " ; disable fan";
-        gcode << "\n";
-    } else {
-        switch (gcode_flavor) {
-        case gcfMakerWare:
-        case gcfSailfish:
-            gcode << "M126";    break;
-        case gcfMach3:
-        case gcfMachinekit:
-            gcode << "M106 P" << 255.0 * speed / 100.0; break;
-        default:
-            gcode << "M106 S" << 255.0 * speed / 100.0; break;
-        }
-        if (gcode_comments) 
-            gcode << " ; enable fan";
-        gcode << "\n";
-    }
-    return gcode.str();*/
-
-    std::ostringstream gcode;
+    std::string gcode;
 
     //add fan_offset
     int16_t fan_speed = int8_t(std::min(uint8_t(100), speed));
@@ -927,31 +1041,33 @@ std::string GCodeWriter::set_fan(const GCodeFlavor gcode_flavor, bool gcode_comm
     // write it
     if (fan_speed == 0) {
         if ((gcfTeacup == gcode_flavor)) {
-            gcode << "M106 S0";
+            gcode += "M106 S0";
         } else if ((gcfMakerWare == gcode_flavor) || (gcfSailfish == gcode_flavor)) {
-            gcode << "M127";
+            gcode += "M127";
         } else {
-            gcode << "M107";
+            gcode += "M107";
         }
-        if (gcode_comments) gcode << " ; disable fan";
-        gcode << "\n";
+        if (gcode_comments) gcode += " ; disable fan";
+        gcode += '\n';
     } else {
         if ((gcfMakerWare == gcode_flavor) || (gcfSailfish == gcode_flavor)) {
-            gcode << "M126 T";
+            gcode += "M126 T";
         } else {
-            gcode << "M106 ";
+            gcode += "M106 ";
             if ((gcfMach3 == gcode_flavor) || (gcfMachinekit == gcode_flavor)) {
-                gcode << "P";
+                gcode += 'P';
             } else {
-                gcode << "S";
+                gcode += 'S';
             }
-            gcode << (fan_baseline * (fan_speed / 100.0));
+            append_g_num(gcode, fan_baseline * (fan_speed / 100.0));
+        }
+        if (gcode_comments) {
+            gcode += " ; ";
+            gcode += (comment.empty() ? "enable fan" : comment);
         }
-        if (gcode_comments)
-            gcode << " ; " << (comment.empty() ? "enable fan" : comment);
-        gcode << "\n";
+        gcode += '\n';
     }
-    return gcode.str();
+    return gcode;
 }
 
 std::string GCodeWriter::set_fan(const uint8_t speed, uint16_t default_tool)
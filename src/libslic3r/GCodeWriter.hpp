@@ -43,7 +43,10 @@ public:
     void        set_acceleration(uint32_t acceleration);
     void        set_travel_acceleration(uint32_t acceleration);
     uint32_t    get_acceleration() const;
+    // The methods with a "std::string &gcode" parameter append to it instead of returning a new string.
+    // Reuse the same buffer from one call to the next to avoid any allocation.
     std::string write_acceleration();
+    void        write_acceleration(std::string &gcode);
     std::string reset_e(bool force = false);
     std::string update_progress(uint32_t num, uint32_t tot, bool allow_100 = false) const;
     // return false if this extruder was already selected
@@ -57,18 +60,26 @@ public:
     std::string toolchange(uint16_t tool_id);
     // in mm/s
     std::string set_speed(const double speed, const std::string &comment = std::string(), const std::string &cooling_marker = std::string());
+    void        set_speed(std::string &gcode, const double speed, const std::string &comment = std::string(), const std::string &cooling_marker = std::string());
     // in mm/s
     double      get_speed() const;
     std::string travel_to_xy(const Vec2d &point, const double speed = 0.0, const std::string &comment = std::string());
+    void        travel_to_xy(std::string &gcode, const Vec2d &point, const double speed = 0.0, const std::string &comment = std::string());
     std::string travel_to_xyz(const Vec3d &point, const double speed = 0.0, const std::string &comment = std::string());
     std::string travel_to_z(double z, const std::string &comment = std::string());
+    void        travel_to_z(std::string &gcode, double z, const std::string &comment = std::string());
     bool        will_move_z(double z) const;
     std::string extrude_to_xy(const Vec2d &point, double dE, const std::string &comment = std::string());
+    void        extrude_to_xy(std::string &gcode, const Vec2d &point, double dE, const std::string &comment = std::string());
     std::string extrude_arc_to_xy(const Vec2d& point, const Vec2d& center_offset, double dE, const bool is_ccw, const std::string& comment = std::string()); //BBS: generate G2 or G3 extrude which moves by arc
+    void        extrude_arc_to_xy(std::string &gcode, const Vec2d& point, const Vec2d& center_offset, double dE, const bool is_ccw, const std::string& comment = std::string());
     std::string extrude_to_xyz(const Vec3d &point, double dE, const std::string &comment = std::string());
+    void        extrude_to_xyz(std::string &gcode, const Vec3d &point, double dE, const std::string &comment = std::string());
     std::string retract(bool before_wipe = false);
+    void        retract(std::string &gcode, bool before_wipe = false);
     std::string retract_for_toolchange(bool before_wipe = false);
     std::string unretract();
+    void        unretract(std::string &gcode);
     void        set_extra_lift(double extra_zlift) { this->m_extra_lift = extra_zlift; }
     double      get_extra_lift() { return this->m_extra_lift; }
     std::string lift(int layer_id);
@@ -116,8 +127,8 @@ private:
     std::pair<std::string, bool> _compute_de(double dE);
 
     
-    std::string _travel_to_z(double z, const std::string &comment);
-    std::string _retract(double length, std::optional<double> restart_extra, std::optional<double> restart_extra_toolchange, const std::string &comment);
+    void        _travel_to_z(std::string &gcode, double z, const std::string &comment);
+    void        _retract(std::string &gcode, double length, std::optional<double> restart_extra, std::optional<double> restart_extra_toolchange, const std::string &comment);
 
 };
 
@@ -232,6 +243,17 @@ public:
 #endif
     }
 
+    // Same as string(), but appended to the output buffer.
+    void append_to(std::string &out) {
+#ifndef DONT_USE_CHARCONV
+        *ptr_err.ptr ++ = '\n';
+        out.append(this->buf, ptr_err.ptr - buf);
+#else 
+        * ptr_err_ptr++ = '\n';
+        out.append(this->buf, ptr_err_ptr - buf);
+#endif
+    }
+
 protected:
     static constexpr const size_t   buflen = 256;
     char                            buf[buflen];
@@ -1,6 +1,7 @@
 #include <boost/log/trivial.hpp>
 
 #include "MedialAxis.hpp"
+#include "VoronoiCache.hpp"
 
 #include "clipper.hpp"
 #include "../ClipperUtils.hpp"
@@ -742,26 +743,29 @@ MedialAxis::polyline_from_voronoi(const ExPolygon& voronoi_polygon, ThickPolylin
 {
     std::map<const VD::edge_type*, std::pair<coordf_t, coordf_t> > thickness;
     Lines lines = voronoi_polygon.lines();
-    VD vd;
     ExPolygons poly_temp;
     const ExPolygon* poly_to_use = &voronoi_polygon;
-    construct_voronoi(lines.begin(), lines.end(), &vd);
+    // The diagram is shared with the other builds on the same polygon, possibly with other widths, see VoronoiCache.
+    std::shared_ptr<const Geometry::VoronoiDiagram> vd = Geometry::VoronoiCache::get(lines);
     //use a degraded mode, so it won't slow down too much #2664
      // first simplify from resolution, to see where we are
-    if (vd.edges().size() > 20000) {
+    // (the diagram is rebuilt only if the simplification did change the polygon)
+    if (vd->edges().size() > 20000) {
         poly_temp = poly_to_use->simplify(this->m_resolution / 2);
-        if (poly_temp.size() == 1) poly_to_use = &poly_temp.front();
-        lines = poly_to_use->lines();
-        vd.clear();
-        construct_voronoi(lines.begin(), lines.end(), &vd);
+        if (poly_temp.size() == 1) {
+            poly_to_use = &poly_temp.front();
+            lines = poly_to_use->lines();
+            vd = Geometry::VoronoiCache::get(lines);
+        }
     }
     // maybe a second one, and this time, use an adapted resolution
-    if (vd.edges().size() > 20000) {
-        poly_temp = poly_to_use->simplify(this->m_resolution * (vd.edges().size() / 40000.));
-        if (poly_temp.size() == 1) poly_to_use = &poly_temp.front();
-        lines = poly_to_use->lines();
-        vd.clear();
-        construct_voronoi(lines.begin(), lines.end(), &vd);
+    if (vd->edges().size() > 20000) {
+        poly_temp = poly_to_use->simplify(this->m_resolution * (vd->edges().size() / 40000.));
+        if (poly_temp.size() == 1) {
+            poly_to_use = &poly_temp.front();
+            lines = poly_to_use->lines();
+            vd = Geometry::VoronoiCache::get(lines);
+        }
     }
 
     typedef const VD::edge_type   edge_t;
@@ -793,7 +797,7 @@ MedialAxis::polyline_from_voronoi(const ExPolygon& voronoi_polygon, ThickPolylin
     std::set<const VD::edge_type*> valid_edges;
     {
         std::set<const edge_t*> seen_edges;
-        for (VD::const_edge_iterator edge = vd.edges().begin(); edge != vd.edges().end(); ++edge) {
+        for (VD::const_edge_iterator edge = vd->edges().begin(); edge != vd->edges().end(); ++edge) {
             // if we only process segments representing closed loops, none if the
             // infinite edges (if any) would be part of our MAT anyway
             if (edge->is_secondary() || edge->is_infinite()) continue;
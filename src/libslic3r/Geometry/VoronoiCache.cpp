@@ -0,0 +1,133 @@
+#include "VoronoiCache.hpp"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace Slic3r {
+namespace Geometry {
+namespace VoronoiCache {
+
+// Smaller diagrams are cheaper to construct than to look up and to keep, and the gap fill produces many of them.
+static constexpr size_t MIN_LINES = 32;
+// About 50 MB of diagrams: a Voronoi edge with its share of the vertices and of the cells takes about 100 bytes.
+static constexpr size_t MAX_EDGES = 500000;
+
+namespace {
+
+struct Entry
+{
+    size_t                                  hash;
+    Lines                                   lines;
+    std::shared_ptr<const VoronoiDiagram>   diagram;
+};
+
+struct Cache
+{
+    std::mutex                                                  mutex;
+    // Most recently used first.
+    std::list<Entry>                                            entries;
+    std::unordered_multimap<size_t, std::list<Entry>::iterator> by_hash;
+    size_t                                                      num_edges = 0;
+    Stats                                                       stats;
+
+    // Returns the diagram of the lines and moves it to the front, or nullptr. Called with the mutex locked.
+    std::shared_ptr<const VoronoiDiagram> find(size_t hash, const Lines &lines)
+    {
+        auto range = by_hash.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++ it)
+            if (it->second->lines == lines) {
+                entries.splice(entries.begin(), entries, it->second);
+                return entries.front().diagram;
+            }
+        return nullptr;
+    }
+
+    void evict_last()
+    {
+        auto range = by_hash.equal_range(entries.back().hash);
+        for (auto it = range.first; it != range.second; ++ it)
+            if (&*it->second == &entries.back()) {
+                by_hash.erase(it);
+                break;
+            }
+        num_edges -= entries.back().diagram->edges().size();
+        entries.pop_back();
+    }
+};
+
+static Cache& cache()
+{
+    static Cache instance;
+    return instance;
+}
+
+static size_t hash_lines(const Lines &lines)
+{
+    size_t seed = lines.size();
+    auto   hash_combine = [&seed](coord_t v) { seed ^= std::hash<coord_t>()(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2); };
+    for (const Line &line : lines) {
+        hash_combine(line.a.x());
+        hash_combine(line.a.y());
+        hash_combine(line.b.x());
+        hash_combine(line.b.y());
+    }
+    return seed;
+}
+
+} // namespace
+
+std::shared_ptr<const VoronoiDiagram> get(const Lines &lines)
+{
+    if (lines.size() < MIN_LINES) {
+        auto diagram = std::make_shared<VoronoiDiagram>();
+        boost::polygon::construct_voronoi(lines.begin(), lines.end(), diagram.get());
+        return diagram;
+    }
+
+    Cache       &c    = cache();
+    const size_t hash = hash_lines(lines);
+    {
+        std::lock_guard<std::mutex> lock(c.mutex);
+        if (std::shared_ptr<const VoronoiDiagram> diagram = c.find(hash, lines); diagram) {
+            ++ c.stats.hits;
+            return diagram;
+        }
+        ++ c.stats.misses;
+    }
+
+    // Construct the diagram without holding the lock.
+    auto diagram = std::make_shared<VoronoiDiagram>();
+    boost::polygon::construct_voronoi(lines.begin(), lines.end(), diagram.get());
+
+    std::lock_guard<std::mutex> lock(c.mutex);
+    // Another thread may have constructed the same diagram in the meantime.
+    if (std::shared_ptr<const VoronoiDiagram> other = c.find(hash, lines); other)
+        return other;
+    c.entries.push_front({ hash, lines, diagram });
+    c.by_hash.emplace(hash, c.entries.begin());
+    c.num_edges += diagram->edges().size();
+    while (c.num_edges > MAX_EDGES && c.entries.size() > 1)
+        c.evict_last();
+    return diagram;
+}
+
+void clear()
+{
+    Cache &c = cache();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    c.by_hash.clear();
+    c.entries.clear();
+    c.num_edges = 0;
+    c.stats     = {};
+}
+
+Stats stats()
+{
+    Cache &c = cache();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    return c.stats;
+}
+
+} // namespace VoronoiCache
+} } // namespace Slic3r::Geometry
@@ -0,0 +1,35 @@
+#ifndef slic3r_Geometry_VoronoiCache_hpp_
+#define slic3r_Geometry_VoronoiCache_hpp_
+
+#include "Voronoi.hpp"
+
+#include <memory>
+
+namespace Slic3r {
+namespace Geometry {
+
+// Cache of the Voronoi diagrams of sets of line segments, shared by the consumers of the same polygons:
+// the thin walls and the gap fill of MedialAxis and Arachne's SkeletalTrapezoidation. A prismatic part is sliced
+// into the same polygons at every layer, and MedialAxis is called on the same polygon with different widths.
+// A diagram depends on the segments and on their order only, thus the segments are the key.
+// The cache is thread safe. It keeps the most recently used diagrams, up to a total number of Voronoi edges.
+namespace VoronoiCache {
+
+// Voronoi diagram of the segments, taken from the cache or constructed and stored into the cache.
+// The diagram is shared between threads: it shall not be modified, not even the colors of its elements.
+std::shared_ptr<const VoronoiDiagram> get(const Lines &lines);
+// Release the cached diagrams, once the layers of a print are generated.
+void clear();
+
+struct Stats {
+    size_t hits   = 0;
+    size_t misses = 0;
+};
+// Number of lookups of the diagrams stored into the cache, since the last clear().
+Stats stats();
+
+} // namespace VoronoiCache
+
+} } // namespace Slic3r::Geometry
+
+#endif // slic3r_Geometry_VoronoiCache_hpp_
@@ -400,6 +400,40 @@ void Layer::export_region_fill_surfaces_to_svg_debug(const char *name) const
     this->export_region_fill_surfaces_to_svg(debug_out_path("Layer-fill_surfaces-%s-%d.svg", name, idx ++).c_str());
 }
 
+void Layer::release_intermediate_data()
+{
+    for (LayerRegion *layerm : m_regions) {
+        // The thin fills were copied to the fills by make_fills().
+        layerm->thin_fills.clear();
+        ExPolygons().swap(layerm->raw_slices);
+        ExPolygons().swap(layerm->fill_expolygons);
+        ExPolygons().swap(layerm->fill_no_overlap_expolygons);
+        Polylines().swap(layerm->unsupported_bridge_edges);
+    }
+}
+
+void Layer::release_exported_data()
+{
+    for (LayerRegion *layerm : m_regions) {
+        Surfaces().swap(layerm->m_slices.surfaces);
+        Surfaces().swap(layerm->fill_surfaces.surfaces);
+        layerm->perimeters.clear();
+        layerm->milling.clear();
+        layerm->fills.clear();
+        layerm->ironings.clear();
+    }
+    this->release_intermediate_data();
+    ExPolygons().swap(this->lslices);
+    std::vector<BoundingBox>().swap(this->lslices_bboxes);
+}
+
+void SupportLayer::release_exported_data()
+{
+    Layer::release_exported_data();
+    ExPolygons().swap(this->support_islands.expolygons);
+    this->support_fills.clear();
+}
+
 void SupportLayer::simplify_support_extrusion_path() {
     const PrintConfig& print_config = this->object()->print()->config();
     const bool spiral_mode = print_config.spiral_vase;
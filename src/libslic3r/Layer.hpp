@@ -154,6 +154,10 @@ public:
     void                    restore_untyped_slices();
     // To improve robustness of detect_surfaces_type() when reslicing (working with typed slices), see GH issue #7442.
     void                    restore_untyped_slices_no_extra_perimeters();
+    // Release the data only used to generate the extrusions, once the layer is infilled and supported, see Print::low_memory().
+    void                    release_intermediate_data();
+    // Release the slices and the extrusions of a layer, whose G-code was generated already, see Print::low_memory().
+    virtual void            release_exported_data();
     // Slices merged into islands, to be used by the elephant foot compensation to trim the individual surfaces with the shrunk merged slices.
     ExPolygons              merged(float offset) const;
     void                    make_perimeters();
@@ -208,6 +212,7 @@ public:
     size_t                      interface_id() const { return m_interface_id; }
 
     void simplify_support_extrusion_path();
+    void                        release_exported_data() override;
 protected:
     friend class PrintObject;
 
@@ -23,6 +23,7 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/log/trivial.hpp>
 #include <boost/nowide/iostream.hpp>
 
@@ -1768,6 +1769,22 @@ bool ModelVolume::is_splittable() const
     return m_is_splittable == 1;
 }
 
+size_t ModelVolume::mesh_hash() const
+{
+    // The meshes are shared and never modified once shared, a new mesh is a new shared pointer.
+    if (m_mesh_hash_of.owner_before(m_mesh) || m_mesh.owner_before(m_mesh_hash_of) || m_mesh_hash_of.expired()) {
+        const indexed_triangle_set &its = this->mesh().its;
+        size_t seed = its.indices.size();
+        if (! its.vertices.empty())
+            boost::hash_range(seed, its.vertices.front().data(), its.vertices.front().data() + 3 * its.vertices.size());
+        if (! its.indices.empty())
+            boost::hash_range(seed, its.indices.front().data(), its.indices.front().data() + 3 * its.indices.size());
+        m_mesh_hash    = seed;
+        m_mesh_hash_of = m_mesh;
+    }
+    return m_mesh_hash;
+}
+
 void ModelVolume::center_geometry_after_creation(bool update_source_offset)
 {
     Vec3d shift = this->mesh().bounding_box().center();
@@ -1776,6 +1793,7 @@ void ModelVolume::center_geometry_after_creation(bool update_source_offset)
     	if (m_mesh) {
         	const_cast<TriangleMesh*>(m_mesh.get())->translate(-(float)shift(0), -(float)shift(1), -(float)shift(2));
             const_cast<TriangleMesh*>(m_mesh.get())->set_init_shift(shift);
+            m_mesh_hash_of.reset();
         }
         if (m_convex_hull)
 			const_cast<TriangleMesh*>(m_convex_hull.get())->translate(-(float)shift(0), -(float)shift(1), -(float)shift(2));
@@ -1964,6 +1982,7 @@ void ModelVolume::mirror(Axis axis)
 void ModelVolume::scale_geometry_after_creation(const Vec3f& versor)
 {
 	const_cast<TriangleMesh*>(m_mesh.get())->scale(versor);
+    m_mesh_hash_of.reset();
 	const_cast<TriangleMesh*>(m_convex_hull.get())->scale(versor);
 }
 
@@ -671,6 +671,9 @@ public:
     int                 extruder_id() const;
 
     bool                is_splittable() const;
+    // Hash of the vertices and triangles of the mesh. Computed at the first call and kept as long as the mesh is not replaced,
+    // thus it is computed once for the copies of a ModelVolume sharing their mesh.
+    size_t              mesh_hash() const;
 
     // Split this volume, append the result to the object owning this volume.
     // Return the number of volumes created from this one.
@@ -781,6 +784,9 @@ private:
     //      0   ->   is not splittable
     //      1   ->   is splittable
     mutable int               		m_is_splittable{ -1 };
+    // See mesh_hash(). The hash is valid if computed for m_mesh.
+    mutable std::weak_ptr<const TriangleMesh> m_mesh_hash_of;
+    mutable size_t                      m_mesh_hash{ 0 };
 
 	ModelVolume(ModelObject *object, const TriangleMesh &mesh, ModelVolumeType type = ModelVolumeType::MODEL_PART) : m_mesh(new TriangleMesh(mesh)), m_type(type), object(object)
     {
@@ -814,6 +820,7 @@ private:
         ObjectBase(other),
         name(other.name), source(other.source), m_mesh(other.m_mesh), m_convex_hull(other.m_convex_hull),
         config(other.config), m_type(other.m_type), object(object), m_transformation(other.m_transformation),
+        m_mesh_hash_of(other.m_mesh_hash_of), m_mesh_hash(other.m_mesh_hash),
         supported_facets(other.supported_facets), seam_facets(other.seam_facets), mmu_segmentation_facets(other.mmu_segmentation_facets)
     {
 		assert(this->id().valid()); 
@@ -14,6 +14,7 @@
 #include "Line.hpp"
 #include "Milling/MillingPostProcess.hpp"
 #include "Polygon.hpp"
+#include "PolygonSet.hpp"
 #include "ShortestPath.hpp"
 #include "SVG.hpp"
 
@@ -30,6 +31,8 @@
 
 #include <boost/log/trivial.hpp>
 
+#include <tbb/parallel_for.h>
+
 //#define ARACHNE_DEBUG
 
 #ifdef ARACHNE_DEBUG
@@ -482,7 +485,7 @@ ProcessSurfaceResult PerimeterGenerator::process_arachne(int& loop_number, const
         this->throw_if_canceled();
     if (ExtrusionEntityCollection extrusion_coll = _traverse_extrusions(ordered_extrusions); !extrusion_coll.empty()) {
         extrusion_coll.set_can_sort_reverse(false, false);
-        this->loops->append(extrusion_coll);
+        result.loops.append(extrusion_coll);
     }
 
     ExPolygons    infill_contour = union_ex(wallToolPaths.getInnerContour());
@@ -537,7 +540,7 @@ void PerimeterGenerator::split_top_surfaces(const ExPolygons *lower_slices,
     if (!this->config->only_one_perimeter_top_other_algo.value) {
         grown_upper_slices = offset(*upper_slices, min_width_top_surface);
     } else {
-        ExPolygons grown_accumulator;
+        PolygonSet grown_accumulator;
         // make thin upper surfaces disapear with -+offset_top_surface
         // do offset2 per island, to avoid big blob merging
         // remove polygon too thin (but don't mess with holes)
@@ -548,18 +551,18 @@ void PerimeterGenerator::split_top_surfaces(const ExPolygons *lower_slices,
                                            (this->mill_extra_size > SCALED_EPSILON ? (double) mill_extra_size : 0));
             if (!contour.empty()) {
                 if (expoly_to_grow.holes.empty()) {
-                    for (Polygon &p : contour) grown_accumulator.push_back(ExPolygon{p});
+                    grown_accumulator.append(contour);
                 } else {
                     Polygons holes = expoly_to_grow.holes;
                     for (Polygon &h : holes) h.reverse();
                     holes = offset(holes,
                                    -min_width_top_surface -
                                        ((this->mill_extra_size > SCALED_EPSILON) ? (double) mill_extra_size : 0));
-                    for (ExPolygon p : diff_ex(contour, holes)) grown_accumulator.push_back(p);
+                    grown_accumulator.append(diff(contour, holes));
                 }
             }
         }
-        grown_upper_slices = union_(grown_accumulator);
+        grown_upper_slices = to_polygons(union_(grown_accumulator));
     }
 
     // get boungding box of last
@@ -572,15 +575,15 @@ void PerimeterGenerator::split_top_surfaces(const ExPolygons *lower_slices,
     // set the clip to a virtual "second perimeter"
     fill_clip = offset_ex(orig_polygons, -coordf_t(ext_perimeter_spacing));
     // Check whether surface be bridge or not
-    ExPolygons bridge_checker;
+    PolygonSet bridge_checker;
     if (lower_slices != nullptr) {
         // BBS: get the Polygons below the polygon this layer
         Polygons lower_polygons_series_clipped = ClipperUtils::clip_clipper_polygons_with_subject_bbox(*lower_slices, last_box);
         coordf_t bridge_offset = std::max(coordf_t(ext_perimeter_spacing), coordf_t(perimeter_width));
         // SoftFever: improve bridging
         const coordf_t bridge_margin = scale_d(this->config->bridged_infill_margin.get_abs_value(unscaled(perimeter_width)));
-        bridge_checker = offset_ex(diff_ex(orig_polygons, lower_polygons_series_clipped, ApplySafetyOffset::Yes),
-                                   1.5 * bridge_offset + bridge_margin + perimeter_spacing / 2);
+        bridge_checker = offset(diff(PolygonSet(orig_polygons), PolygonSet(lower_polygons_series_clipped), ApplySafetyOffset::Yes),
+                                1.5 * bridge_offset + bridge_margin + perimeter_spacing / 2);
     }
     ExPolygons delete_bridge = diff_ex(orig_polygons, bridge_checker, ApplySafetyOffset::Yes);
     // get the real top surface
@@ -741,6 +744,7 @@ void PerimeterGenerator::process()
                 this->_lower_slices_bridge_flow_big = offset((simplified.empty() ? *this->lower_slices : simplified), (coordf_t)overhangs_width_flow_110 - (coordf_t)(ext_perimeter_width / 2));
                 if (use_arachne) convert_to_clipperpath(this->_lower_slices_bridge_flow_big, this->_lower_slices_bridge_flow_big_clipperpaths);
             }
+            m_overhang_regions.build({ &_lower_slices_bridge_speed_small, &_lower_slices_bridge_speed_big, &_lower_slices_bridge_flow_small, &_lower_slices_bridge_flow_big });
         }
     }
     this->throw_if_canceled();
@@ -762,135 +766,158 @@ void PerimeterGenerator::process()
 
     processs_no_bridge(all_surfaces);
 
-    int surface_idx = 0;
     const int extra_odd_perimeter = (config->extra_perimeters_odd_layers && layer->id() % 2 == 1 ? 1 : 0);
-    for (const Surface& surface : all_surfaces) {
-        // detect how many perimeters must be generated for this island
-        int        loop_number = this->config->perimeters + surface.extra_perimeters - 1 + extra_odd_perimeter;  // 0-indexed loops
-        surface_idx++;
+    // The islands don't depend on each other, process them in parallel (nested into the parallel processing of the layers),
+    // each one into its own result. These are then merged in the order of the surfaces, thus the output doesn't depend
+    // on the scheduling of the threads.
+    std::vector<ProcessSurfaceResult> surface_results(all_surfaces.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, all_surfaces.size()),
+        [this, &all_surfaces, &surface_results, extra_odd_perimeter](const tbb::blocked_range<size_t> &range) {
+            for (size_t surface_idx = range.begin(); surface_idx < range.end(); ++ surface_idx)
+                surface_results[surface_idx] = this->process_surface(all_surfaces[surface_idx], extra_odd_perimeter);
+        });
 
-        if (print_config->spiral_vase) {
-            if (layer->id() >= config->bottom_solid_layers) {
-                loop_number = 0;
-            }
-        }
+    for (ProcessSurfaceResult &surface_result : surface_results) {
+        if (!surface_result.loops.empty())
+            this->loops->append_move_from(surface_result.loops);
+        if (!surface_result.gap_fill.empty())
+            this->gap_fill->append_move_from(surface_result.gap_fill);
+        // append infill areas to fill_surfaces
+        this->fill_surfaces->append(std::move(surface_result.fill_surfaces), stPosInternal | stDensSparse);
+        append(this->fill_no_overlap, std::move(surface_result.fill_no_overlap));
+    }
+#if _DEBUG
+    this->loops->visit(LoopAssertVisitor{});
+#endif
+}
+
+ProcessSurfaceResult PerimeterGenerator::process_surface(const Surface &surface, const int extra_odd_perimeter)
+{
+    // detect how many perimeters must be generated for this island
+    int        loop_number = this->config->perimeters + surface.extra_perimeters - 1 + extra_odd_perimeter;  // 0-indexed loops
 
-        if ((layer->id() == 0 && this->config->only_one_perimeter_first_layer) || (this->config->only_one_perimeter_top && loop_number > 0 && this->upper_slices == NULL)) {
+    if (print_config->spiral_vase) {
+        if (layer->id() >= config->bottom_solid_layers) {
             loop_number = 0;
         }
+    }
 
-        ProcessSurfaceResult surface_process_result;
-        //core generation
-        if (use_arachne) {
-            surface_process_result = process_arachne(loop_number, surface);
-        } else {
-            surface_process_result = process_classic(loop_number, surface);
-        }
-        this->throw_if_canceled();
+    if ((layer->id() == 0 && this->config->only_one_perimeter_first_layer) || (this->config->only_one_perimeter_top && loop_number > 0 && this->upper_slices == NULL)) {
+        loop_number = 0;
+    }
+
+    ProcessSurfaceResult surface_process_result;
+    //core generation
+    if (use_arachne) {
+        surface_process_result = process_arachne(loop_number, surface);
+    } else {
+        surface_process_result = process_classic(loop_number, surface);
+    }
+    this->throw_if_canceled();
 
 
-        // create one more offset to be used as boundary for fill
-        // we offset by half the perimeter spacing (to get to the actual infill boundary)
-        // and then we offset back and forth by half the infill spacing to only consider the
-        // non-collapsing regions
-        coord_t inset = 0;
-        coord_t infill_peri_overlap = 0;
-        // only apply infill overlap if we actually have one perimeter
-        if (loop_number >= 0) {
-            // half infill / perimeter
-            inset = (loop_number == 0) ?
-                // one loop
-                this->get_ext_perimeter_spacing() / 2 :
-                // two or more loops?
-                this->get_perimeter_spacing() / 2;
-            //infill_peri_overlap = scale_t(this->config->get_abs_value("infill_overlap", unscale<coordf_t>(perimeter_spacing + solid_infill_spacing) / 2));
-            //give the overlap size to let the infill do his overlap
-            //add overlap if at least one perimeter
-            coordf_t perimeter_spacing_for_encroach = 0;
-            if(this->config->perimeters == 1)
-                perimeter_spacing_for_encroach = this->ext_perimeter_flow.spacing();
-            else if(this->config->only_one_perimeter_top.value)
-                //note: use the min of the two to avoid overextrusion if only one perimeter top
-                // TODO: only do that if there is a top & a not-top surface
-                perimeter_spacing_for_encroach = std::min(this->perimeter_flow.spacing(), this->ext_perimeter_flow.spacing());
-            else //if(layerm->region().config().perimeters > 1)
-                perimeter_spacing_for_encroach = this->perimeter_flow.spacing();
-            infill_peri_overlap = scale_t(this->config->get_abs_value("infill_overlap", perimeter_spacing_for_encroach));
-        }
-
-        //remove gapfill from last
-        ExPolygons last_no_gaps = (surface_process_result.gap_srf.empty()) ? surface_process_result.inner_perimeter : diff_ex(surface_process_result.inner_perimeter, surface_process_result.gap_srf);
-
-        // simplify infill contours according to resolution
-        Polygons not_filled_p;
-        for (ExPolygon& ex : last_no_gaps)
+    // create one more offset to be used as boundary for fill
+    // we offset by half the perimeter spacing (to get to the actual infill boundary)
+    // and then we offset back and forth by half the infill spacing to only consider the
+    // non-collapsing regions
+    coord_t inset = 0;
+    coord_t infill_peri_overlap = 0;
+    // only apply infill overlap if we actually have one perimeter
+    if (loop_number >= 0) {
+        // half infill / perimeter
+        inset = (loop_number == 0) ?
+            // one loop
+            this->get_ext_perimeter_spacing() / 2 :
+            // two or more loops?
+            this->get_perimeter_spacing() / 2;
+        //infill_peri_overlap = scale_t(this->config->get_abs_value("infill_overlap", unscale<coordf_t>(perimeter_spacing + solid_infill_spacing) / 2));
+        //give the overlap size to let the infill do his overlap
+        //add overlap if at least one perimeter
+        coordf_t perimeter_spacing_for_encroach = 0;
+        if(this->config->perimeters == 1)
+            perimeter_spacing_for_encroach = this->ext_perimeter_flow.spacing();
+        else if(this->config->only_one_perimeter_top.value)
+            //note: use the min of the two to avoid overextrusion if only one perimeter top
+            // TODO: only do that if there is a top & a not-top surface
+            perimeter_spacing_for_encroach = std::min(this->perimeter_flow.spacing(), this->ext_perimeter_flow.spacing());
+        else //if(layerm->region().config().perimeters > 1)
+            perimeter_spacing_for_encroach = this->perimeter_flow.spacing();
+        infill_peri_overlap = scale_t(this->config->get_abs_value("infill_overlap", perimeter_spacing_for_encroach));
+    }
+
+    //remove gapfill from last
+    ExPolygons last_no_gaps = (surface_process_result.gap_srf.empty()) ? surface_process_result.inner_perimeter : diff_ex(surface_process_result.inner_perimeter, surface_process_result.gap_srf);
+
+    // simplify infill contours according to resolution
+    Polygons not_filled_p;
+    for (ExPolygon& ex : last_no_gaps)
+        ex.simplify_p(scale_t(std::max(this->print_config->resolution.value, print_config->resolution_internal / 4)), &not_filled_p);
+    ExPolygons not_filled_exp = union_ex(not_filled_p);
+    // collapse too narrow infill areas
+    coord_t min_perimeter_infill_spacing = (coord_t)(this->get_solid_infill_spacing() * (1. - INSET_OVERLAP_TOLERANCE));
+    ExPolygons infill_exp;
+    //special branch if gap : don't inset away from gaps!
+    if (surface_process_result.gap_srf.empty()) {
+        infill_exp = offset2_ex(not_filled_exp,
+            double(-inset - min_perimeter_infill_spacing / 2 + infill_peri_overlap - this->get_infill_gap()),
+            double(min_perimeter_infill_spacing / 2));
+    } else {
+        //store the infill_exp but not offseted, it will be used as a clip to remove the gapfill portion
+        const ExPolygons infill_exp_no_gap = offset2_ex(not_filled_exp,
+            double(-inset - min_perimeter_infill_spacing / 2 + infill_peri_overlap - this->get_infill_gap()),
+            double(inset + min_perimeter_infill_spacing / 2 - infill_peri_overlap + this->get_infill_gap()));
+        //redo the same as not_filled_exp but with last instead of last_no_gaps
+        not_filled_p.clear();
+        for (ExPolygon& ex : surface_process_result.inner_perimeter)
             ex.simplify_p(scale_t(std::max(this->print_config->resolution.value, print_config->resolution_internal / 4)), &not_filled_p);
-        ExPolygons not_filled_exp = union_ex(not_filled_p);
-        // collapse too narrow infill areas
-        coord_t min_perimeter_infill_spacing = (coord_t)(this->get_solid_infill_spacing() * (1. - INSET_OVERLAP_TOLERANCE));
-        ExPolygons infill_exp;
-        //special branch if gap : don't inset away from gaps!
-        if (surface_process_result.gap_srf.empty()) {
-            infill_exp = offset2_ex(not_filled_exp,
-                double(-inset - min_perimeter_infill_spacing / 2 + infill_peri_overlap - this->get_infill_gap()),
-                double(min_perimeter_infill_spacing / 2));
-        } else {
-            //store the infill_exp but not offseted, it will be used as a clip to remove the gapfill portion
-            const ExPolygons infill_exp_no_gap = offset2_ex(not_filled_exp,
-                double(-inset - min_perimeter_infill_spacing / 2 + infill_peri_overlap - this->get_infill_gap()),
-                double(inset + min_perimeter_infill_spacing / 2 - infill_peri_overlap + this->get_infill_gap()));
-            //redo the same as not_filled_exp but with last instead of last_no_gaps
-            not_filled_p.clear();
-            for (ExPolygon& ex : surface_process_result.inner_perimeter)
-                ex.simplify_p(scale_t(std::max(this->print_config->resolution.value, print_config->resolution_internal / 4)), &not_filled_p);
-            not_filled_exp = union_ex(not_filled_p);
-            infill_exp = offset2_ex(not_filled_exp,
-                double(-inset - min_perimeter_infill_spacing / 2 + infill_peri_overlap - this->get_infill_gap()),
-                double(min_perimeter_infill_spacing / 2));
-            // intersect(growth(surface_process_result.inner_perimeter-gap) , surface_process_result.inner_perimeter), so you have the (surface_process_result.inner_perimeter - small gap) but without voids betweeng gap & surface_process_result.inner_perimeter
-            infill_exp = intersection_ex(infill_exp, infill_exp_no_gap);
-        }
-        
-        this->throw_if_canceled();
-        //if any top_fills, grow them by ext_perimeter_spacing/2 to have the real un-anchored fill
-        ExPolygons top_infill_exp = intersection_ex(surface_process_result.fill_clip, offset_ex(surface_process_result.top_fills, double(this->get_ext_perimeter_spacing() / 2)));
+        not_filled_exp = union_ex(not_filled_p);
+        infill_exp = offset2_ex(not_filled_exp,
+            double(-inset - min_perimeter_infill_spacing / 2 + infill_peri_overlap - this->get_infill_gap()),
+            double(min_perimeter_infill_spacing / 2));
+        // intersect(growth(surface_process_result.inner_perimeter-gap) , surface_process_result.inner_perimeter), so you have the (surface_process_result.inner_perimeter - small gap) but without voids betweeng gap & surface_process_result.inner_perimeter
+        infill_exp = intersection_ex(infill_exp, infill_exp_no_gap);
+    }
+    
+    this->throw_if_canceled();
+    //if any top_fills, grow them by ext_perimeter_spacing/2 to have the real un-anchored fill
+    ExPolygons top_infill_exp = intersection_ex(surface_process_result.fill_clip, offset_ex(surface_process_result.top_fills, double(this->get_ext_perimeter_spacing() / 2)));
+    if (!surface_process_result.top_fills.empty()) {
+        infill_exp = union_ex(infill_exp, offset_ex(top_infill_exp, double(infill_peri_overlap)));
+    }
+    // append infill areas to fill_surfaces
+    surface_process_result.fill_surfaces = std::move(infill_exp);
+
+    if (infill_peri_overlap != 0) {
+        ExPolygons polyWithoutOverlap;
+        if (min_perimeter_infill_spacing / 2 > infill_peri_overlap)
+            polyWithoutOverlap = offset2_ex(
+                not_filled_exp,
+                double(-inset - infill_gap - min_perimeter_infill_spacing / 2 + infill_peri_overlap),
+                double(min_perimeter_infill_spacing / 2 - infill_peri_overlap));
+        else
+            polyWithoutOverlap = offset_ex(
+                not_filled_exp,
+                double(-inset - this->get_infill_gap()));
         if (!surface_process_result.top_fills.empty()) {
-            infill_exp = union_ex(infill_exp, offset_ex(top_infill_exp, double(infill_peri_overlap)));
-        }
-        // append infill areas to fill_surfaces
-        this->fill_surfaces->append(infill_exp, stPosInternal | stDensSparse);
-
-        if (infill_peri_overlap != 0) {
-            ExPolygons polyWithoutOverlap;
-            if (min_perimeter_infill_spacing / 2 > infill_peri_overlap)
-                polyWithoutOverlap = offset2_ex(
-                    not_filled_exp,
-                    double(-inset - infill_gap - min_perimeter_infill_spacing / 2 + infill_peri_overlap),
-                    double(min_perimeter_infill_spacing / 2 - infill_peri_overlap));
-            else
-                polyWithoutOverlap = offset_ex(
-                    not_filled_exp,
-                    double(-inset - this->get_infill_gap()));
-            if (!surface_process_result.top_fills.empty()) {
-                polyWithoutOverlap = union_ex(polyWithoutOverlap, top_infill_exp);
-            }
-            this->fill_no_overlap.insert(this->fill_no_overlap.end(), polyWithoutOverlap.begin(), polyWithoutOverlap.end());
-            /*{
-                static int isaqsdsdfsdfqzfn = 0;
-                std::stringstream stri;
-                stri << this->layer->id() << "_2_end_makeperimeter_" << isaqsdsdfsdfqzfn++ << ".svg";
-                SVG svg(stri.str());
-                svg.draw(to_polylines(infill_exp), "blue");
-                svg.draw(to_polylines(fill_no_overlap), "cyan");
-                svg.draw(to_polylines(not_filled_exp), "green");
-                svg.draw(to_polylines(last_no_gaps), "yellow");
-                //svg.draw(to_polylines(offset_ex(surface_process_result.fill_clip, ext_perimeter_spacing / 2)), "brown");
-                svg.draw(to_polylines(top_infill_exp), "orange");
-                svg.Close();
-            }*/
+            polyWithoutOverlap = union_ex(polyWithoutOverlap, top_infill_exp);
         }
+        surface_process_result.fill_no_overlap = std::move(polyWithoutOverlap);
+        /*{
+            static int isaqsdsdfsdfqzfn = 0;
+            std::stringstream stri;
+            stri << this->layer->id() << "_2_end_makeperimeter_" << isaqsdsdfsdfqzfn++ << ".svg";
+            SVG svg(stri.str());
+            svg.draw(to_polylines(infill_exp), "blue");
+            svg.draw(to_polylines(fill_no_overlap), "cyan");
+            svg.draw(to_polylines(not_filled_exp), "green");
+            svg.draw(to_polylines(last_no_gaps), "yellow");
+            //svg.draw(to_polylines(offset_ex(surface_process_result.fill_clip, ext_perimeter_spacing / 2)), "brown");
+            svg.draw(to_polylines(top_infill_exp), "orange");
+            svg.Close();
+        }*/
     }
 
+    return surface_process_result;
 }
 
 void PerimeterGenerator::processs_no_bridge(Surfaces& all_surfaces) {
@@ -1188,7 +1215,8 @@ ProcessSurfaceResult PerimeterGenerator::process_classic(int& loop_number, const
         std::vector<PerimeterGeneratorLoops> contours(loop_number + 1);    // depth => loops
         std::vector<PerimeterGeneratorLoops> holes(loop_number + 1);       // depth => loops
         ThickPolylines thin_walls_thickpolys;
-        ExPolygons no_last_gapfill;
+        // Only clipped against, thus kept flat.
+        PolygonSet no_last_gapfill;
         // we loop one time more than needed in order to find gaps after the last perimeter was applied
         for (int perimeter_idx = 0;; ++perimeter_idx) {  // outer loop is 0
             this->throw_if_canceled();
@@ -1430,16 +1458,16 @@ ProcessSurfaceResult PerimeterGenerator::process_classic(int& loop_number, const
                     // not using safety offset here would "detect" very narrow gaps
                     // (but still long enough to escape the area threshold) that gap fill
                     // won't be able to fill but we'd still remove from infill area
-                    no_last_gapfill = offset_ex(next_onion, 0.5f * good_spacing + 10,
+                    no_last_gapfill = offset(PolygonSet(next_onion), 0.5f * good_spacing + 10,
                         (round_peri ? ClipperLib::JoinType::jtRound : ClipperLib::JoinType::jtMiter),
                         (round_peri ? min_round_spacing : 3));
                     if (perimeter_idx == 1) {
                         append(gaps, diff_ex(
-                            offset_ex(last, -0.5f * this->get_ext_perimeter_spacing()),
+                            offset(PolygonSet(last), -0.5f * this->get_ext_perimeter_spacing()),
                             no_last_gapfill));  // safety offset
                     } else {
                         append(gaps, diff_ex(
-                            offset_ex(last, -0.5f * this->get_perimeter_spacing()),
+                            offset(PolygonSet(last), -0.5f * this->get_perimeter_spacing()),
                             no_last_gapfill));  // safety offset
                     }
                 }
@@ -1665,11 +1693,11 @@ ProcessSurfaceResult PerimeterGenerator::process_classic(int& loop_number, const
         // append perimeters for this slice as a collection
         if (!peri_entities.empty()) {
             //move it, to avoid to clone evrything and then delete it
-            this->loops->append(peri_entities);
+            results.loops.append(peri_entities);
         }
     } // for each loop of an island
 #if _DEBUG
-    this->loops->visit(LoopAssertVisitor{});
+    results.loops.visit(LoopAssertVisitor{});
 #endif
 
     // fill gaps
@@ -1765,7 +1793,7 @@ ProcessSurfaceResult PerimeterGenerator::process_classic(int& loop_number, const
         // create extrusion from lines
         Flow gap_fill_flow = Flow::new_from_width(this->perimeter_flow.width(), this->perimeter_flow.nozzle_diameter(),this->perimeter_flow.height(), this->config->gap_fill_overlap.get_abs_value(1.), false);
         if (!polylines.empty()) {
-            this->gap_fill->append(Geometry::thin_variable_width(
+            results.gap_fill.append(Geometry::thin_variable_width(
                 polylines,
                 erGapFill, 
                 gap_fill_flow, 
@@ -1778,7 +1806,7 @@ ProcessSurfaceResult PerimeterGenerator::process_classic(int& loop_number, const
                 that medial axis skips but infill might join with other infill regions
                 and use zigzag).  */
                 // get clean surface of gap
-            results.gap_srf = union_ex(offset(this->gap_fill->polygons_covered_by_width(float(SCALED_EPSILON) / 10), float(SCALED_EPSILON / 2)));
+            results.gap_srf = union_ex(offset(results.gap_fill.polygons_covered_by_width(float(SCALED_EPSILON) / 10), float(SCALED_EPSILON / 2)));
             // intersection to ignore the bits of gapfill tha may be over infill, as it's epsilon and there may be some voids here anyway.
             results.gap_srf = intersection_ex(results.gap_srf, gaps_ex);
             // the diff(last, gap) will be done after, as we have to keep the last un-gapped to avoid unneeded gap/infill offset
@@ -1791,6 +1819,88 @@ ProcessSurfaceResult PerimeterGenerator::process_classic(int& loop_number, const
 }
 
 
+void OverhangRegionsIndex::build(std::initializer_list<const Polygons*> regions)
+{
+    m_regions.clear();
+    std::vector<const Polygon*> polygons;
+    for (const Polygons *region : regions)
+        if (! region->empty()) {
+            std::vector<BoundingBox> bboxes;
+            bboxes.reserve(region->size());
+            for (const Polygon &polygon : *region) {
+                bboxes.emplace_back(get_extents(polygon));
+                polygons.emplace_back(&polygon);
+            }
+            m_regions.emplace_back(region, std::move(bboxes));
+        }
+    if (! polygons.empty())
+        m_grid.create(polygons, scale_t(1.));
+}
+
+template<typename PointAccessor>
+bool OverhangRegionsIndex::contains(size_t num_points, PointAccessor &&point) const
+{
+    if (m_regions.empty() || num_points < 2)
+        return false;
+    // The regions are all inside the grid.
+    BoundingBox bbox;
+    for (size_t i = 0; i < num_points; ++ i)
+        bbox.merge(point(i));
+    if (! m_grid.bbox().contains(bbox.min) || ! m_grid.bbox().contains(bbox.max))
+        return false;
+
+    // Does any segment of the polyline cross or touch an edge of the regions?
+    struct Visitor {
+        explicit Visitor(const EdgeGrid::Grid &grid) : grid(grid) {}
+
+        bool operator()(coord_t iy, coord_t ix) {
+            // Called with a row and colum of the grid cell, which is intersected by a line.
+            auto cell_data_range = grid.cell_data_range(iy, ix);
+            for (auto it_contour_and_segment = cell_data_range.first; it_contour_and_segment != cell_data_range.second; ++ it_contour_and_segment) {
+                auto segment = grid.segment(*it_contour_and_segment);
+                if (Geometry::segments_intersect(segment.first, segment.second, pt_prev, pt_this)) {
+                    this->intersect = true;
+                    return false;
+                }
+            }
+            // Continue traversing the grid along the edge.
+            return true;
+        }
+
+        const EdgeGrid::Grid &grid;
+        Point                 pt_prev;
+        Point                 pt_this;
+        bool                  intersect = false;
+    } visitor(m_grid);
+
+    visitor.pt_this = point(0);
+    for (size_t i = 1; i < num_points && ! visitor.intersect; ++ i) {
+        visitor.pt_prev = visitor.pt_this;
+        visitor.pt_this = point(i);
+        if (visitor.pt_prev != visitor.pt_this)
+            m_grid.visit_cells_intersecting_line(visitor.pt_prev, visitor.pt_this, visitor);
+    }
+    if (visitor.intersect)
+        return false;
+
+    // The whole polyline is on the same side of the boundary of each region, test its first point.
+    const Point pt = point(0);
+    for (const auto &[region, bboxes] : m_regions) {
+        bool inside = false;
+        for (size_t i = 0; i < region->size(); ++ i)
+            if (bboxes[i].contains(pt) && (*region)[i].contains(pt))
+                inside = ! inside;
+        if (! inside)
+            return false;
+    }
+    return true;
+}
+
+bool OverhangRegionsIndex::contains(const Polyline &polyline) const
+{
+    return this->contains(polyline.size(), [&polyline](size_t idx) { return polyline.points[idx]; });
+}
+
 ExtrusionPaths PerimeterGenerator::create_overhangs(const Polyline& loop_polygons, ExtrusionRole role, bool is_external) const {
     ExtrusionPaths paths;
     const double overhangs_width = this->config->overhangs_width.get_abs_value(this->overhang_flow.nozzle_diameter());
@@ -1809,6 +1919,15 @@ ExtrusionPaths PerimeterGenerator::create_overhangs(const Polyline& loop_polygon
         return paths;
     
     }
+    if (m_overhang_regions.contains(loop_polygons)) {
+        // Fully supported: clipping it by the regions would return it unchanged.
+        ExtrusionPath path(role, false);
+        path.polyline = loop_polygons;
+        path.mm3_per_mm = is_external ? this->ext_mm3_per_mm() : this->mm3_per_mm();
+        path.width = is_external ? this->ext_perimeter_flow.width() : this->perimeter_flow.width();
+        path.height = (float)this->layer->height;
+        return { path };
+    }
     //set the fan & speed before the flow
     Polylines ok_polylines = { loop_polygons };
 
@@ -2183,8 +2302,12 @@ ExtrusionPaths PerimeterGenerator::create_overhangs(const ClipperLib_Z::Path& ar
             assert(poly[i] != poly[i + 1]);
 #endif
 
+    // Fully supported: clipping it by the regions would return it unchanged.
+    const bool supported = m_overhang_regions.contains(arachne_path.size(),
+        [&arachne_path](size_t idx) { return Point(coord_t(arachne_path[idx].x()), coord_t(arachne_path[idx].y())); });
+
     std::vector<ClipperLib_Z::Path>* previous = &ok_polylines;
-    if (overhangs_width_speed > 0 && (overhangs_width_speed < overhangs_width || overhangs_width == 0)) {
+    if (! supported && overhangs_width_speed > 0 && (overhangs_width_speed < overhangs_width || overhangs_width == 0)) {
         if (!this->_lower_slices_bridge_speed_small_clipperpaths.empty()) {
             //small_speed = diff_pl(*previous, this->_lower_slices_bridge_speed_small);
 #ifdef _DEBUG
@@ -2227,7 +2350,7 @@ ExtrusionPaths PerimeterGenerator::create_overhangs(const ClipperLib_Z::Path& ar
             }
         }
     }
-    if (overhangs_width > 0) {
+    if (! supported && overhangs_width > 0) {
         if (!this->_lower_slices_bridge_flow_small.empty()) {
 #ifdef _DEBUG
             Points outer_points;
@@ -3,6 +3,7 @@
 
 #include "libslic3r.h"
 #include <vector>
+#include "EdgeGrid.hpp"
 #include "ExPolygonCollection.hpp"
 #include "Flow.hpp"
 #include "Layer.hpp"
@@ -64,11 +65,35 @@ public:
 
 typedef std::vector<PerimeterGeneratorLoop> PerimeterGeneratorLoops;
 
+// Edges of the overhang regions of a layer and the bounding boxes of their polygons, to find the loops fully inside
+// all of the regions without clipping them by the regions.
+class OverhangRegionsIndex {
+public:
+    // The regions are referenced, not copied. The empty regions are skipped.
+    void        build(std::initializer_list<const Polygons*> regions);
+    bool        empty() const { return m_regions.empty(); }
+
+    // Is the polyline strictly inside all the regions? Then clipping it by the regions returns it unchanged.
+    // Its points are read with point(idx), thus the Arachne paths are tested without converting them.
+    template<typename PointAccessor>
+    bool        contains(size_t num_points, PointAccessor &&point) const;
+    bool        contains(const Polyline &polyline) const;
+
+private:
+    EdgeGrid::Grid                                                     m_grid;
+    std::vector<std::pair<const Polygons*, std::vector<BoundingBox>>> m_regions;
+};
+
 struct ProcessSurfaceResult {
     ExPolygons inner_perimeter;
     ExPolygons gap_srf;
     ExPolygons top_fills;
     ExPolygons fill_clip;
+    // Outputs of the surface, appended to the outputs of the PerimeterGenerator in the order of the surfaces.
+    ExtrusionEntityCollection loops;
+    ExtrusionEntityCollection gap_fill;
+    ExPolygons fill_surfaces;
+    ExPolygons fill_no_overlap;
 };
 
 class PerimeterGenerator {
@@ -139,6 +164,8 @@ private:
     ClipperLib_Z::Paths _lower_slices_bridge_flow_big_clipperpaths;
     ClipperLib_Z::Paths _lower_slices_bridge_speed_small_clipperpaths;
     ClipperLib_Z::Paths _lower_slices_bridge_speed_big_clipperpaths;
+    // Index of the _lower_slices_bridge_* regions, to extrude the loops fully inside all of them without clipping them.
+    OverhangRegionsIndex m_overhang_regions;
 
     //process data
     coord_t perimeter_width; coord_t get_perimeter_width() { return perimeter_width; }
@@ -153,6 +180,8 @@ private:
     ExPolygons unmillable;
     coord_t mill_extra_size;
 
+    // Generate the perimeters, gap fill and infill areas of a single island. Called in parallel for all the islands.
+    ProcessSurfaceResult process_surface(const Surface& surface, const int extra_odd_perimeter);
     ProcessSurfaceResult process_classic(int& loop_number, const Surface& surface);
     ProcessSurfaceResult process_arachne(int& loop_number, const Surface& surface);
     
@@ -7,6 +7,9 @@
 #include <iomanip>
 #include <sstream>
 #include <map>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
 
 #ifdef _MSC_VER
     #include <stdlib.h>  // provides **_environ
@@ -1238,6 +1241,34 @@ namespace client
         }
     };
 
+    // Reserved words of the macro language, which may not be used as variable names.
+    // Also used by split_template() to leave the [keyword] expansions to the parser.
+    static constexpr std::string_view reserved_keywords[] {
+        "and",
+        "digits",
+        "zdigits",
+        "if",
+        "int",
+        //"inf",
+        "else",
+        "elsif",
+        "endif",
+        "false",
+        "min",
+        "max",
+        "random",
+        "round",
+        "not",
+        "or",
+        "true",
+        "exists",
+        "default_double",
+        "default_int",
+        "default_bool",
+        "default_string",
+        "ignore_legacy"
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     //  Our macro_processor grammar
     ///////////////////////////////////////////////////////////////////////////
@@ -1500,30 +1531,8 @@ namespace client
             regular_expression = raw[lexeme['/' > *((utf8char - char_('\\') - char_('/')) | ('\\' > char_)) > '/']];
             regular_expression.name("regular_expression");
 
-            keywords.add
-                ("and")
-                ("digits")
-                ("zdigits")
-                ("if")
-                ("int")
-                //("inf")
-                ("else")
-                ("elsif")
-                ("endif")
-                ("false")
-                ("min")
-                ("max")
-                ("random")
-                ("round")
-                ("not")
-                ("or")
-                ("true")
-                ("exists")
-                ("default_double")
-                ("default_int")
-                ("default_bool")
-                ("default_string")
-                ("ignore_legacy");
+            for (std::string_view keyword : reserved_keywords)
+                keywords.add(std::string(keyword));
 
             if (0) {
                 debug(start);
@@ -1624,7 +1633,234 @@ static std::string process_macro(const std::string &templ, client::MyContext &co
     return output;
 }
 
+struct PlaceholderParser::CompiledTemplate
+{
+    enum SegmentType {
+        stLiteral,
+        stLegacyVariable,
+        // Macro made of a single variable reference {variable}, {variable[index]} or {variable[index_variable]},
+        // evaluated without the parser.
+        stVariable,
+        stMacro,
+    };
+    struct Segment {
+        SegmentType type;
+        // Literal text with the escapes resolved, name of the legacy variable or of the variable
+        // or source of the macro including the braces.
+        std::string text;
+        // Vector index of a stVariable: the index variable if not empty, otherwise index if not negative.
+        std::string index_variable;
+        int         index { -1 };
+    };
+    // Full template, parsed as a whole if it was not split or if one of its segments failed.
+    std::string             source;
+    bool                    split { false };
+    std::vector<Segment>    segments;
+};
+
+// Parse a macro made of a single variable reference: {variable}, {variable[index]} or {variable[index_variable]}, with optional spaces.
+// Appends a stVariable segment and returns true, or returns false for any other macro.
+static bool parse_variable_macro(std::string_view macro, std::vector<PlaceholderParser::CompiledTemplate::Segment> &segments)
+{
+    using Segment = PlaceholderParser::CompiledTemplate::Segment;
+    auto is_space = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r'; };
+    auto is_alpha = [](char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; };
+    auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+    assert(macro.size() >= 2 && macro.front() == '{' && macro.back() == '}');
+    const char *it  = macro.data() + 1;
+    const char *end = macro.data() + macro.size() - 1;
+    auto skip_spaces = [&it, end, &is_space]() { while (it != end && is_space(*it)) ++ it; };
+    auto identifier  = [&it, end, &is_alpha, &is_digit](std::string &out) {
+        const char *begin = it;
+        if (it == end || ! is_alpha(*it))
+            return false;
+        while (it != end && (is_alpha(*it) || is_digit(*it)))
+            ++ it;
+        std::string_view name(begin, it - begin);
+        if (std::find(std::begin(client::reserved_keywords), std::end(client::reserved_keywords), name) != std::end(client::reserved_keywords))
+            return false;
+        out = name;
+        return true;
+    };
+
+    Segment segment{ PlaceholderParser::CompiledTemplate::stVariable, {} };
+    skip_spaces();
+    if (! identifier(segment.text))
+        return false;
+    skip_spaces();
+    if (it != end && *it == '[') {
+        ++ it;
+        skip_spaces();
+        if (it != end && is_digit(*it)) {
+            const char *begin = it;
+            while (it != end && is_digit(*it))
+                ++ it;
+            // Leave large numbers to the parser, which reports the overflow.
+            if (it - begin > 6)
+                return false;
+            segment.index = std::atoi(std::string(begin, it).c_str());
+        } else if (! identifier(segment.index_variable))
+            return false;
+        skip_spaces();
+        if (it == end || *it != ']')
+            return false;
+        ++ it;
+        skip_spaces();
+    }
+    if (it != end)
+        return false;
+    segments.push_back(std::move(segment));
+    return true;
+}
+
+// Evaluate a stVariable segment the way the parser evaluates a macro made of a single variable reference.
+static std::string evaluate_variable(const PlaceholderParser::CompiledTemplate::Segment &segment, const client::MyContext &context)
+{
+    using Iterator = std::string::const_iterator;
+    boost::iterator_range<Iterator> opt_key(segment.text.begin(), segment.text.end());
+    client::OptWithPos<Iterator>    opt;
+    client::expr<Iterator>          value;
+    client::MyContext::resolve_variable(&context, opt_key, opt);
+    if (segment.index_variable.empty() && segment.index < 0) {
+        client::MyContext::scalar_variable_reference(&context, opt, value);
+    } else {
+        int index = segment.index;
+        if (! segment.index_variable.empty()) {
+            boost::iterator_range<Iterator> index_key(segment.index_variable.begin(), segment.index_variable.end());
+            client::OptWithPos<Iterator>    index_opt;
+            client::expr<Iterator>          index_value;
+            client::MyContext::resolve_variable(&context, index_key, index_opt);
+            client::MyContext::scalar_variable_reference(&context, index_opt, index_value);
+            client::MyContext::evaluate_index(index_value, index);
+        }
+        client::MyContext::vector_variable_reference(&context, opt, index, segment.text.end(), value);
+    }
+    std::string out;
+    client::expr<Iterator>::to_string2(value, out);
+    return out;
+}
+
+// Split the template into literal text, legacy [variables] and top level {macros} including their nested {if}...{endif} blocks.
+// Returns false for templates, which are not trivially split: string literals, regular expressions, legacy [variable[index]] expansions,
+// non-ASCII text or syntax errors. These are left to the parser.
+static bool split_template(const std::string &templ, std::vector<PlaceholderParser::CompiledTemplate::Segment> &segments)
+{
+    using Segment = PlaceholderParser::CompiledTemplate::Segment;
+    using CT      = PlaceholderParser::CompiledTemplate;
+    auto is_space      = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r'; };
+    auto is_identifier = [](char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'; };
+    auto is_escaped    = [](const char *it, const char *end) { return *it == '\\' && it + 1 != end && (it[1] == '[' || it[1] == '{'); };
+    auto append_literal = [&segments](const char *begin, const char *end) {
+        if (segments.empty() || segments.back().type != CT::stLiteral)
+            segments.push_back(Segment{ CT::stLiteral, {} });
+        segments.back().text.append(begin, end);
+    };
+
+    for (char c : templ)
+        if (static_cast<unsigned char>(c) >= 0x80)
+            return false;
+
+    const char *it  = templ.data();
+    const char *end = it + templ.size();
+    // The parser skips the leading white space.
+    while (it != end && is_space(*it))
+        ++ it;
+    while (it != end) {
+        const char *begin = it;
+        if (*it == '\\') {
+            // Escape character: escapes '[' and '{' or is printed as-is.
+            if (is_escaped(it, end))
+                ++ begin;
+            it = begin + 1;
+            append_literal(begin, it);
+        } else if (*it == '[') {
+            // Legacy variable expansion, only the simple [identifier] form.
+            const char *name = ++ it;
+            if (it == end || ! (is_identifier(*it) && ! (*it >= '0' && *it <= '9')))
+                return false;
+            while (it != end && is_identifier(*it))
+                ++ it;
+            if (it == end || *it != ']')
+                return false;
+            std::string_view name_view(name, it - name);
+            if (std::find(std::begin(client::reserved_keywords), std::end(client::reserved_keywords), name_view) != std::end(client::reserved_keywords))
+                return false;
+            segments.push_back(Segment{ CT::stLegacyVariable, std::string(name_view) });
+            ++ it;
+        } else if (*it == '{') {
+            // Macro up to its closing brace. An {if} extends the macro up to its matching {endif}.
+            int depth = 0;
+            for (;;) {
+                // it points to an opening brace of an expression.
+                ++ it;
+                const char *keyword = it;
+                while (keyword != end && is_space(*keyword))
+                    ++ keyword;
+                const char *keyword_end = keyword;
+                while (keyword_end != end && is_identifier(*keyword_end))
+                    ++ keyword_end;
+                std::string_view keyword_view(keyword, keyword_end - keyword);
+                if (keyword_view == "if")
+                    ++ depth;
+                else if ((keyword_view == "endif" || keyword_view == "else" || keyword_view == "elsif") && depth == 0)
+                    return false;
+                else if (keyword_view == "endif")
+                    -- depth;
+                for (; it != end && *it != '}'; ++ it)
+                    // Nested braces, string literals or regular expressions (matched by =~ or !~).
+                    if (*it == '{' || *it == '"' || *it == '~')
+                        return false;
+                if (it == end)
+                    return false;
+                ++ it;
+                if (depth == 0)
+                    break;
+                // Text block of an {if} / {elsif} / {else} up to the next expression.
+                for (; it != end && *it != '{'; ++ it)
+                    if (is_escaped(it, end))
+                        ++ it;
+                if (it == end)
+                    return false;
+            }
+            if (! parse_variable_macro(std::string_view(begin, it - begin), segments))
+                segments.push_back(Segment{ CT::stMacro, std::string(begin, it) });
+        } else {
+            // Free-form text up to the next escape character, legacy variable or macro.
+            while (it != end && *it != '\\' && *it != '[' && *it != '{')
+                ++ it;
+            append_literal(begin, it);
+        }
+    }
+    return true;
+}
+
+std::shared_ptr<const PlaceholderParser::CompiledTemplate> PlaceholderParser::compile(const std::string &templ)
+{
+    // The custom G-codes are filled in for each layer, tool change etc. and most of them are just a few constant templates.
+    // Each thread keeps its own cache, so that the G-code export threads do not wait on a lock for each custom G-code.
+    // The cache is emptied when it grows too large, for example when the templates are generated by the caller.
+    static constexpr size_t max_cached = 1024;
+    static thread_local std::unordered_map<std::string, std::shared_ptr<const CompiledTemplate>> cache;
+
+    if (auto it = cache.find(templ); it != cache.end())
+        return it->second;
+    auto out = std::make_shared<CompiledTemplate>();
+    out->source = templ;
+    out->split  = split_template(templ, out->segments);
+    if (! out->split)
+        out->segments.clear();
+    if (cache.size() >= max_cached)
+        cache.clear();
+    cache.emplace(templ, out);
+    return out;
+}
+
 std::string PlaceholderParser::process(const std::string &templ, unsigned int current_extruder_id, const DynamicConfig *config_override, ContextData *context_data) const
+{
+    return this->process(*compile(templ), current_extruder_id, config_override, context_data);
+}
+
+std::string PlaceholderParser::process(const CompiledTemplate &templ, unsigned int current_extruder_id, const DynamicConfig *config_override, ContextData *context_data) const
 {
     client::MyContext context;
     context.external_config 	= this->external_config();
@@ -1632,7 +1868,49 @@ std::string PlaceholderParser::process(const std::string &templ, unsigned int cu
     context.config_override     = config_override;
     context.current_extruder_id = current_extruder_id;
     context.context_data        = context_data;
-    return process_macro(templ, context);
+    if (! templ.split)
+        return process_macro(templ.source, context);
+
+    // The macros evaluated before a failing one may have drawn random numbers. The template is then parsed again
+    // as a whole starting from the same random generator state, as if it was never split.
+    std::optional<ContextData> context_data_initial;
+    std::string output;
+    try {
+        for (const CompiledTemplate::Segment &segment : templ.segments)
+            switch (segment.type) {
+            case CompiledTemplate::stLiteral:
+                output += segment.text;
+                break;
+            case CompiledTemplate::stLegacyVariable:
+            {
+                boost::iterator_range<std::string::const_iterator> opt_key(segment.text.begin(), segment.text.end());
+                std::string value;
+                client::MyContext::legacy_variable_expansion(&context, opt_key, value);
+                output += value;
+                break;
+            }
+            case CompiledTemplate::stVariable:
+                output += evaluate_variable(segment, context);
+                break;
+            case CompiledTemplate::stMacro:
+                if (context_data != nullptr && ! context_data_initial)
+                    context_data_initial = *context_data;
+                output += process_macro(segment.text, context);
+                break;
+            }
+    } catch (...) {
+        // Parse the template as a whole, so that the error is reported at its position in the full template.
+        if (context_data_initial)
+            *context_data = std::move(*context_data_initial);
+        client::MyContext context_full;
+        context_full.external_config     = context.external_config;
+        context_full.config              = context.config;
+        context_full.config_override     = context.config_override;
+        context_full.current_extruder_id = context.current_extruder_id;
+        context_full.context_data        = context.context_data;
+        return process_macro(templ.source, context_full);
+    }
+    return output;
 }
 
 // Evaluate a boolean expression using the full expressive power of the PlaceholderParser boolean expression syntax.
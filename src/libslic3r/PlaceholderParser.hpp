@@ -3,6 +3,7 @@
 
 #include "libslic3r.h"
 #include <map>
+#include <memory>
 #include <random>
 #include <string>
 #include <vector>
@@ -52,7 +53,16 @@ public:
 
     // Fill in the template using a macro processing language.
     // Throws Slic3r::PlaceholderParserError on syntax or runtime error.
+    // The template is compiled once by compile() and the compiled template is cached.
     std::string process(const std::string &templ, unsigned int current_extruder_id = 0, const DynamicConfig *config_override = nullptr, ContextData *context = nullptr) const;
+
+    // Template split into its literal text, legacy [variables], {variable} references and {macros}, so that only the macros
+    // are passed to the parser when the template is filled in. Templates that could not be split are parsed as a whole.
+    struct CompiledTemplate;
+    // Compile the template, or return the template compiled before. Thread safe.
+    static std::shared_ptr<const CompiledTemplate> compile(const std::string &templ);
+    // Fill in a compiled template. Throws Slic3r::PlaceholderParserError on syntax or runtime error.
+    std::string process(const CompiledTemplate &templ, unsigned int current_extruder_id = 0, const DynamicConfig *config_override = nullptr, ContextData *context = nullptr) const;
     
     // Evaluate a boolean expression using the full expressive power of the PlaceholderParser boolean expression syntax.
     // Throws Slic3r::PlaceholderParserError on syntax or runtime error.
@@ -0,0 +1,105 @@
+#include "PolygonSet.hpp"
+
+namespace Slic3r {
+
+void PolygonSet::append(const Point *begin, const Point *end)
+{
+    m_points.insert(m_points.end(), begin, end);
+    assert(m_points.size() <= size_t(std::numeric_limits<uint32_t>::max()));
+    m_ends.emplace_back(uint32_t(m_points.size()));
+}
+
+void PolygonSet::append(const Polygons &polygons)
+{
+    size_t num_points = 0;
+    for (const Polygon &polygon : polygons)
+        num_points += polygon.size();
+    this->reserve(m_ends.size() + polygons.size(), m_points.size() + num_points);
+    for (const Polygon &polygon : polygons)
+        this->append(polygon.points);
+}
+
+void PolygonSet::append(const ExPolygon &expolygon)
+{
+    this->append(expolygon.contour.points);
+    for (const Polygon &hole : expolygon.holes)
+        this->append(hole.points);
+}
+
+void PolygonSet::append(const ExPolygons &expolygons)
+{
+    size_t num_polygons = 0;
+    size_t num_points   = 0;
+    for (const ExPolygon &expolygon : expolygons) {
+        num_polygons += expolygon.holes.size() + 1;
+        num_points   += expolygon.contour.size();
+        for (const Polygon &hole : expolygon.holes)
+            num_points += hole.size();
+    }
+    this->reserve(m_ends.size() + num_polygons, m_points.size() + num_points);
+    for (const ExPolygon &expolygon : expolygons)
+        this->append(expolygon);
+}
+
+void PolygonSet::append(const std::vector<Points> &paths)
+{
+    size_t num_points = 0;
+    for (const Points &path : paths)
+        num_points += path.size();
+    this->reserve(m_ends.size() + paths.size(), m_points.size() + num_points);
+    for (const Points &path : paths)
+        this->append(path);
+}
+
+void PolygonSet::append(const PolygonSet &other)
+{
+    if (&other == this) {
+        this->append(PolygonSet(other));
+        return;
+    }
+    uint32_t shift = uint32_t(m_points.size());
+    m_points.insert(m_points.end(), other.m_points.begin(), other.m_points.end());
+    m_ends.reserve(m_ends.size() + other.m_ends.size());
+    for (uint32_t end : other.m_ends)
+        m_ends.emplace_back(end + shift);
+}
+
+Polygons PolygonSet::to_polygons() const
+{
+    Polygons out;
+    out.reserve(this->size());
+    for (size_t i = 0; i < this->size(); ++ i)
+        out.emplace_back(this->polygon(i));
+    return out;
+}
+
+double PolygonSet::area() const
+{
+    double a = 0.;
+    for (size_t i = 0; i < this->size(); ++ i) {
+        const Point *begin = this->begin(i);
+        const Point *end   = this->end(i);
+        if (end - begin >= 3) {
+            Vec2d p1 = (end - 1)->cast<double>();
+            for (const Point *it = begin; it != end; ++ it) {
+                Vec2d p2 = it->cast<double>();
+                a += cross2(p1, p2);
+                p1 = p2;
+            }
+        }
+    }
+    return 0.5 * a;
+}
+
+void PolygonSet::translate(const Point &vector)
+{
+    for (Point &pt : m_points)
+        pt += vector;
+}
+
+BoundingBox get_extents(const PolygonSet &polygons)
+{
+    return polygons.empty() ? BoundingBox() : BoundingBox(polygons.points());
+}
+
+} // namespace Slic3r
@@ -0,0 +1,77 @@
+#ifndef slic3r_PolygonSet_hpp_
+#define slic3r_PolygonSet_hpp_
+
+#include "libslic3r.h"
+#include "BoundingBox.hpp"
+#include "ExPolygon.hpp"
+#include "Point.hpp"
+#include "Polygon.hpp"
+
+namespace Slic3r {
+
+// Set of closed polygons stored flat: the points of all polygons in a single buffer and the end offsets
+// of the polygons into the buffer. Contrary to Polygons, there is no Polygon object with its vtable and its
+// own allocation per polygon, thus the set is cheap to build, to copy and to release, which matters
+// for the intermediate results of the clipping heavy code, see the PolygonSet overloads in ClipperUtils.hpp.
+// The polygons are oriented as Polygons: contours CCW, holes CW, so that a set filled in with ExPolygons
+// is interpreted the same way by the non-zero fill rule of the Clipper library.
+// Only worth it for results which are unioned or clipped against, as the shells of discover_vertical_shells(),
+// the bridge check and the gap detection of the PerimeterGenerator. The onion shells of the perimeter loop
+// stay ExPolygons: their number of islands and their holes drive the loops generation.
+class PolygonSet
+{
+public:
+    PolygonSet() = default;
+    explicit PolygonSet(const Polygons &polygons) { this->append(polygons); }
+    explicit PolygonSet(const ExPolygons &expolygons) { this->append(expolygons); }
+    // Paths returned by the Clipper library.
+    explicit PolygonSet(const std::vector<Points> &paths) { this->append(paths); }
+    // Points of all polygons and the end offset of each polygon into the points, as filled in by the Clipper library.
+    PolygonSet(Points &&points, std::vector<uint32_t> &&ends) : m_points(std::move(points)), m_ends(std::move(ends))
+        { assert(m_ends.empty() ? m_points.empty() : m_ends.back() == m_points.size()); }
+
+    size_t          size() const { return m_ends.size(); }
+    bool            empty() const { return m_ends.empty(); }
+    // Number of points over all polygons.
+    size_t          num_points() const { return m_points.size(); }
+    void            clear() { m_points.clear(); m_ends.clear(); }
+    void            reserve(size_t num_polygons, size_t num_points) { m_ends.reserve(num_polygons); m_points.reserve(num_points); }
+    void            shrink_to_fit() { m_points.shrink_to_fit(); m_ends.shrink_to_fit(); }
+
+    // Points of the idx-th polygon.
+    const Point*    begin(size_t idx) const { assert(idx < this->size()); return m_points.data() + (idx == 0 ? 0 : m_ends[idx - 1]); }
+    const Point*    end(size_t idx)   const { assert(idx < this->size()); return m_points.data() + m_ends[idx]; }
+    size_t          size(size_t idx)  const { return this->end(idx) - this->begin(idx); }
+    Polygon         polygon(size_t idx) const { return Polygon(Points(this->begin(idx), this->end(idx))); }
+    // Points of all polygons.
+    const Points&   points() const { return m_points; }
+
+    void            append(const Point *begin, const Point *end);
+    void            append(const Points &points) { this->append(points.data(), points.data() + points.size()); }
+    void            append(const Polygon &polygon) { this->append(polygon.points); }
+    void            append(const Polygons &polygons);
+    void            append(const ExPolygon &expolygon);
+    void            append(const ExPolygons &expolygons);
+    void            append(const std::vector<Points> &paths);
+    void            append(const PolygonSet &other);
+
+    Polygons        to_polygons() const;
+    // Sum of the signed areas: holes are subtracted.
+    double          area() const;
+    void            translate(const Point &vector);
+
+    bool            operator==(const PolygonSet &rhs) const { return m_ends == rhs.m_ends && m_points == rhs.m_points; }
+    bool            operator!=(const PolygonSet &rhs) const { return ! (*this == rhs); }
+
+private:
+    Points                  m_points;
+    // One past the last point of each polygon in m_points.
+    std::vector<uint32_t>   m_ends;
+};
+
+inline Polygons to_polygons(const PolygonSet &polygons) { return polygons.to_polygons(); }
+BoundingBox get_extents(const PolygonSet &polygons);
+
+} // namespace Slic3r
+
+#endif /* slic3r_PolygonSet_hpp_ */
@@ -813,6 +813,8 @@ static std::vector<std::string> s_Preset_printer_options {
     "fan_percentage",
     "fan_printer_min_speed",
     "gcode_ascii",
+    "gcode_async_output",
+    "gcode_memory_max_size",
     "gcode_filename_illegal_char",
     "gcode_flavor",
     "gcode_precision_xyz",
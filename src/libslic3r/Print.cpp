@@ -9,6 +9,7 @@
 #include "Flow.hpp"
 #include "Fill/FillBase.hpp"
 #include "Geometry/ConvexHull.hpp"
+#include "Geometry/VoronoiCache.hpp"
 #include "I18N.hpp"
 #include "ShortestPath.hpp"
 #include "SupportMaterial.hpp"
@@ -22,6 +23,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <boost/filesystem/path.hpp>
@@ -221,7 +223,10 @@ bool Print::invalidate_state_by_config_options(const ConfigOptionResolver& /* ne
         "wipe_speed",
     };
 
-    static std::unordered_set<std::string> steps_ignore;
+    static std::unordered_set<std::string> steps_ignore = {
+        "gcode_async_output",
+        "gcode_memory_max_size",
+    };
 
     std::vector<PrintStep> steps;
     std::vector<PrintObjectStep> osteps;
@@ -1048,21 +1053,49 @@ void Print::process()
     name_tbb_thread_pool_threads_set_locale();
     bool something_done = !is_step_done_unguarded(psSkirtBrim);
     BOOST_LOG_TRIVIAL(info) << "Starting the slicing process." << log_memory_info();
-    for (PrintObject* obj : m_objects) {
-        obj->make_perimeters();
-    }
-    //note: as object seems to be sliced independantly, it's maybe possible to add a tbb parallel_loop with simple partitioner on infill,
-    //  as prepare_infill has some function not // 
-    for (PrintObject* obj : m_objects) {
-        obj->infill();
-    }
-    for (PrintObject* obj : m_objects) {
-        obj->ironing();
+    // The objects are sliced independently up to the wipe tower, skirt and brim: run the steps of each object as a separate task,
+    // so that many small objects, each with too few layers to fill the thread pool, are processed concurrently.
+    // The steps of an object are still executed in order, their parallel loops over layers share the thread pool.
+    // Separate ModelObjects with identical meshes, transformations and configs (a part loaded or copied many times) produce the same layers:
+    // only the first object of such a group is processed, the others receive a copy of its layers.
+    std::vector<PrintObject*>                         leaders;
+    std::vector<std::pair<PrintObject*, PrintObject*>> followers;
+    {
+        std::unordered_map<size_t, std::vector<PrintObject*>> leaders_by_fingerprint;
+        for (PrintObject *obj : m_objects) {
+            std::vector<PrintObject*> &candidates = leaders_by_fingerprint[obj->slicing_fingerprint()];
+            auto it = std::find_if(candidates.begin(), candidates.end(), [obj](const PrintObject *leader) { return leader->has_same_slicing_input(*obj); });
+            if (it == candidates.end()) {
+                candidates.emplace_back(obj);
+                leaders.emplace_back(obj);
+            } else
+                followers.emplace_back(obj, *it);
+        }
     }
-	this->set_status(45, L("Generating support material"));
-    for (PrintObject* obj : m_objects) {
-        obj->generate_support_material();
+    if (! followers.empty())
+        BOOST_LOG_TRIVIAL(info) << "Sharing the layers of " << leaders.size() << " objects with " << followers.size() << " identical objects";
+    {
+        // The Voronoi diagrams shared by the layers of the objects are not needed once the layers are generated,
+        // nor when their generation is canceled or fails.
+        ScopeGuard voronoi_cache_guard([]() { Geometry::VoronoiCache::clear(); });
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, leaders.size(), 1), [this, &leaders](const tbb::blocked_range<size_t> &range) {
+            for (size_t object_idx = range.begin(); object_idx < range.end(); ++ object_idx) {
+                PrintObject *obj = leaders[object_idx];
+                obj->make_perimeters();
+                obj->infill();
+                obj->ironing();
+                if (obj->has_support_material())
+                    this->set_status(45, L("Generating support material"));
+                obj->generate_support_material();
+                if (m_low_memory)
+                    obj->release_intermediate_data();
+            }
+        });
     }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, followers.size(), 1), [&followers](const tbb::blocked_range<size_t> &range) {
+        for (size_t object_idx = range.begin(); object_idx < range.end(); ++ object_idx)
+            followers[object_idx].first->copy_layers_from(*followers[object_idx].second);
+    });
     if (this->set_started(psWipeTower)) {
         m_wipe_tower_data.clear();
         m_tool_ordering.clear();
@@ -1307,6 +1340,10 @@ std::string Print::export_gcode(const std::string& path_template, GCodeProcessor
     // The following line may die for multiple reasons.
     GCode gcode;
     gcode.do_export(this, path.c_str(), result, thumbnail_cb);
+    if (m_low_memory)
+        // The layers were released by the G-code export.
+        for (PrintObject *object : m_objects)
+            object->m_layer_data_released = true;
     return path.c_str();
 }
 
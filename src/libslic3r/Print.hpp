@@ -353,6 +353,12 @@ public:
     // Helpers to project custom facets on slices
     void project_and_append_custom_facets(bool seam, EnforcerBlockerType type, std::vector<Polygons>& expolys) const;
 
+    // Hash of the meshes, transformations and configs the layers are computed from.
+    // PrintObjects of separate, but identical ModelObjects have the same fingerprint.
+    size_t                      slicing_fingerprint() const;
+    // Would this PrintObject produce the very same layers and support layers as the other one?
+    bool                        has_same_slicing_input(const PrintObject &other) const;
+
     /// skirts if done per copy and not per platter
     const std::optional<ExtrusionEntityCollection>& skirt_first_layer() const { return m_skirt_first_layer; }
     const ExtrusionEntityCollection& skirt() const { return m_skirt; }
@@ -372,12 +378,17 @@ protected:
     bool                    invalidate_step(PrintObjectStep step);
     // Invalidates all PrintObject and Print steps.
     bool                    invalidate_all_steps();
+    // Invalidates the slicing after a change of the layer height profile, keeping the region slices
+    // of the Z levels, which are sliced again with the new profile.
+    bool                    invalidate_layer_height_profile();
     // Invalidate steps based on a set of parameters changed.
     // It may be called for both the PrintObjectConfig and PrintRegionConfig.
     bool                    invalidate_state_by_config_options(
         const ConfigOptionResolver &old_config, const ConfigOptionResolver &new_config, const std::vector<t_config_option_key> &opt_keys);
     // If ! m_slicing_params.valid, recalculate.
     void                    update_slicing_parameters();
+    // Instead of running the steps up to posSupportMaterial, copy the layers of another PrintObject with the same slicing input.
+    void                    copy_layers_from(const PrintObject &src);
 
     static PrintObjectConfig object_config_from_model_object(const PrintObjectConfig &default_object_config, const ModelObject &object, size_t num_extruders);
 
@@ -406,6 +417,8 @@ private:
     void combine_infill();
     void _generate_support_material();
     void _compute_max_sparse_spacing();
+    // Release the data of the layers, which is not needed by the skirt, brim and G-code export, see Print::low_memory().
+    void release_intermediate_data();
     std::pair<FillAdaptive::OctreePtr, FillAdaptive::OctreePtr> prepare_adaptive_infill_data();
     FillLightning::GeneratorPtr prepare_lightning_infill_data();
 
@@ -441,6 +454,18 @@ private:
     //this setting allow fill_aligned_z to get the max sparse spacing spacing.
     coord_t                                 m_max_sparse_spacing = 0;
 
+    // Data of the layers was released in low memory mode, any invalidated step needs the object to be sliced again.
+    bool                                    m_layer_data_released = false;
+
+    // The last infill() ironed the layers together with their fills and posIroning was not invalidated since,
+    // ironing() only has to record the step as done.
+    bool                                    m_ironed_with_fills = false;
+
+    // Region slices of the last slicing by their slice_z, before the XY size compensation.
+    // Only kept for objects with a layer height profile and if not too large, so that editing the layer height profile
+    // only slices the Z levels, which were not sliced before, see invalidate_layer_height_profile().
+    std::vector<std::pair<float, std::vector<ExPolygons>>> m_region_slices_cache;
+
 };
 
 struct WipeTowerData
@@ -592,6 +617,11 @@ public:
     // Exports G-code into a file name based on the path_template, returns the file path of the generated G-code file.
     // If preview_data is not null, the preview_data is filled in for the G-code visualization (not used by the command line Slic3r).
     std::string         export_gcode(const std::string& path_template, GCodeProcessorResult* result, ThumbnailsGeneratorCallback thumbnail_cb = nullptr);
+    // Release the data of the layers as soon as the following steps do not need it (command line slicing of large prints):
+    // the buffers only used to generate the extrusions are released once an object is supported, the layers are released
+    // while their G-code is being exported. Changing any step of such an object slices it again, and the G-code may only be exported once.
+    void                set_low_memory(bool low_memory) { m_low_memory = low_memory; }
+    bool                low_memory() const { return m_low_memory; }
 
     // methods for handling state
     bool                is_step_done(PrintStep step) const { return Inherited::is_step_done(step); }
@@ -738,6 +768,8 @@ private:
     PrintStatistics                         m_print_statistics;
     // tiem of last change, to see if the gui need to be updated
     std::time_t                             m_timestamp_last_change;
+    // Release the layers data once not needed, see set_low_memory().
+    bool                                    m_low_memory { false };
 
     // Allow PrintObject to access m_mutex and m_cancel_callback.
     friend class PrintObject;
@@ -1161,8 +1161,17 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
             model_object_status.print_object_regions = print_objects_range.begin()->print_object->m_shared_regions;
             model_object_status.print_object_regions->ref_cnt_inc();
         }
-        if (solid_or_modifier_differ || model_origin_translation_differ || layer_height_ranges_differ ||
-            ! model_object.layer_height_profile.timestamp_matches(model_object_new.layer_height_profile)) {
+        bool layer_height_profile_differ = ! model_object.layer_height_profile.timestamp_matches(model_object_new.layer_height_profile);
+        if (layer_height_profile_differ && ! solid_or_modifier_differ && ! model_origin_translation_differ && ! layer_height_ranges_differ &&
+            model_object_status.print_object_regions != nullptr) {
+            // Just the Z distribution of the layers changed. Keep the PrintObjects and their regions,
+            // so that the slices at the Z levels not touched by the new layer height profile are reused.
+            for (const PrintObjectStatus &print_object_status : print_objects_range)
+                update_apply_status(print_object_status.print_object->invalidate_layer_height_profile());
+            model_object.layer_height_profile.assign(model_object_new.layer_height_profile);
+            layer_height_profile_differ = false;
+        }
+        if (solid_or_modifier_differ || model_origin_translation_differ || layer_height_ranges_differ || layer_height_profile_differ) {
             // The very first step (the slicing step) is invalidated. One may freely remove all associated PrintObjects.
             model_object_status.print_object_regions_status = 
                 model_object_status.print_object_regions == nullptr || model_origin_translation_differ || layer_height_ranges_differ ?
@@ -2861,6 +2861,26 @@ void PrintConfigDef::init_fff_params()
     def->mode = comExpert | comSuSi;
     def->set_default_value(new ConfigOptionBool(false));
 
+    def = this->add("gcode_async_output", coBool);
+    def->label = L("Write the G-code in background threads");
+    def->category = OptionCategory::output;
+    def->tooltip = L("Hand the generated G-code over to a thread that writes it to the disk and to another one that computes the time estimates,"
+        " instead of waiting for them after each layer."
+        " Useful when the output is on a slow or network drive.");
+    def->mode = comExpert | comSuSi;
+    def->set_default_value(new ConfigOptionBool(false));
+
+    def = this->add("gcode_memory_max_size", coInt);
+    def->label = L("G-code kept in memory");
+    def->category = OptionCategory::output;
+    def->tooltip = L("Keep the generated G-code in memory up to this size, then the remaining times are inserted while writing it"
+        " to the disk once. A larger G-code is written to a temporary file and read back to insert the remaining times."
+        " Set zero to always use the temporary file.");
+    def->sidetext = L("MB");
+    def->min = 0;
+    def->mode = comExpert | comSuSi;
+    def->set_default_value(new ConfigOptionInt(256));
+
     def = this->add("gcode_comments", coBool);
     def->label = L("Verbose G-code");
     def->category = OptionCategory::output;
@@ -8148,6 +8168,8 @@ std::unordered_set<std::string> prusa_export_to_remove_keys = {
 "first_layer_min_speed",
 "first_layer_size_compensation_layers",
 "gcode_ascii",
+"gcode_async_output",
+"gcode_memory_max_size",
 "gap_fill_acceleration",
 "gap_fill_extension",
 "gap_fill_fan_speed",
@@ -9696,6 +9718,19 @@ CLIMiscConfigDef::CLIMiscConfigDef()
     def->label = L("Data directory");
     def->tooltip = L("Load and store settings at the given directory. This is useful for maintaining different profiles or including configurations from a network storage.");
 
+    def = this->add("gcode_cache", coString);
+    def->label = L("G-code cache directory");
+    def->tooltip = L("Keep a copy of the exported G-codes in the given directory, keyed by the models, their placement, "
+                     "their color changes and custom G-codes, the configuration and the output file name. Exporting the same models with the same configuration again "
+                     "copies the kept G-code instead of slicing. The placeholders of the output file name keep the values of the first export.");
+
+    def = this->add("low_memory", coBool);
+    def->label = L("Low memory");
+    def->tooltip = L("Release the data of the layers as soon as it is not needed anymore: the data used to generate the extrusions "
+                     "once an object is sliced, and the layers once their G-code is exported. Lowers the peak memory usage of large prints, "
+                     "which is reported at the end.");
+    def->set_default_value(new ConfigOptionBool(false));
+
     def = this->add("loglevel", coInt);
     def->label = L("Logging level");
     def->tooltip = L("Sets logging sensitivity. 0:fatal, 1:error, 2:warning, 3:info, 4:debug, 5:trace\n"
@@ -1067,7 +1067,9 @@ PRINT_CONFIG_CLASS_DEFINE(
     ((ConfigOptionFloats,              filament_cooling_final_speed))
     ((ConfigOptionStrings,             filament_ramming_parameters))
     ((ConfigOptionBool,                gcode_ascii))
+    ((ConfigOptionBool,                gcode_async_output))
     ((ConfigOptionBool,                gcode_comments))
+    ((ConfigOptionInt,                 gcode_memory_max_size))
     ((ConfigOptionString,              gcode_filename_illegal_char))
     ((ConfigOptionEnum<GCodeFlavor>,   gcode_flavor))
     ((ConfigOptionBool,                gcode_label_objects))
@@ -7,6 +7,7 @@
 #include "I18N.hpp"
 #include "Layer.hpp"
 #include "MutablePolygon.hpp"
+#include "PolygonSet.hpp"
 #include "SupportMaterial.hpp"
 #include "Surface.hpp"
 #include "Slicing.hpp"
@@ -19,6 +20,7 @@
 
 #include <atomic>
 #include <float.h>
+#include <numeric>
 #include <string_view>
 #include <utility>
 
@@ -256,6 +258,110 @@ namespace Slic3r {
         }
     }
 
+    static bool surfaces_equal(const Surfaces &lhs, const Surfaces &rhs)
+    {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](const Surface &l, const Surface &r) {
+            return l.surface_type == r.surface_type && l.thickness == r.thickness && l.thickness_layers == r.thickness_layers &&
+                   l.bridge_angle == r.bridge_angle && l.extra_perimeters == r.extra_perimeters &&
+                   l.maxNbSolidLayersOnTop == r.maxNbSolidLayersOnTop && l.priority == r.priority && l.expolygon == r.expolygon;
+        });
+    }
+
+    // Same height, same islands and same typed slices in each region.
+    static bool layers_have_same_slices(const Layer &lhs, const Layer &rhs)
+    {
+        if (lhs.height != rhs.height || lhs.region_count() != rhs.region_count() || lhs.lslices != rhs.lslices)
+            return false;
+        for (size_t region_id = 0; region_id < lhs.region_count(); ++ region_id)
+            if (! surfaces_equal(lhs.get_region(region_id)->slices().surfaces, rhs.get_region(region_id)->slices().surfaces))
+                return false;
+        return true;
+    }
+
+    // Same height, same fill surfaces and same gap fills in each region. Fill surfaces combined over several layers are never reused,
+    // as the fill direction changes with the layer index divided by the number of combined layers.
+    static bool layers_have_same_fill_input(const Layer &lhs, const Layer &rhs)
+    {
+        if (lhs.height != rhs.height || lhs.region_count() != rhs.region_count())
+            return false;
+        for (size_t region_id = 0; region_id < lhs.region_count(); ++ region_id) {
+            const LayerRegion &l = *lhs.get_region(region_id);
+            const LayerRegion &r = *rhs.get_region(region_id);
+            if (! surfaces_equal(l.fill_surfaces.surfaces, r.fill_surfaces.surfaces) || l.fill_expolygons != r.fill_expolygons ||
+                l.fill_no_overlap_expolygons != r.fill_no_overlap_expolygons || l.thin_fills.items_count() != r.thin_fills.items_count() ||
+                l.thin_fills.as_polylines() != r.thin_fills.as_polylines())
+                return false;
+            for (const Surface &surface : l.fill_surfaces.surfaces)
+                if (surface.thickness_layers > 1)
+                    return false;
+        }
+        return true;
+    }
+
+    // For each layer, the index of the layer it may copy its results from, or its own index if the results have to be computed.
+    // A layer copies from the layer period layers below when same_input(below, layer) holds, the source is resolved transitively,
+    // thus the source of a layer is never a copy itself. Zero period disables the reuse.
+    template<typename SameInput>
+    static std::vector<size_t> layer_result_sources(size_t num_layers, size_t period, SameInput same_input)
+    {
+        std::vector<char> same(num_layers, false);
+        if (period > 0 && period < num_layers)
+            tbb::parallel_for(tbb::blocked_range<size_t>(period, num_layers), [period, &same, &same_input](const tbb::blocked_range<size_t> &range) {
+                for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx)
+                    same[layer_idx] = same_input(layer_idx - period, layer_idx);
+            });
+        std::vector<size_t> sources(num_layers);
+        for (size_t layer_idx = 0; layer_idx < num_layers; ++ layer_idx)
+            sources[layer_idx] = same[layer_idx] ? sources[layer_idx - period] : layer_idx;
+        return sources;
+    }
+
+    // Number of layers after which the fills of the same surfaces repeat, zero if the fills change with Z (gyroid, cubic, lightning ...)
+    // or with each layer (fill angle increment).
+    static size_t fill_period(const PrintObject &object)
+    {
+        size_t period = 2;
+        for (size_t region_id = 0; region_id < object.num_printing_regions(); ++ region_id) {
+            const PrintRegionConfig &config = object.printing_region(region_id).config();
+            if (config.fill_angle_increment.value != 0)
+                return 0;
+            if (! config.fill_angle_template.empty())
+                period = std::lcm(period, config.fill_angle_template.values.size());
+            for (InfillPattern pattern : { config.fill_pattern.value, config.top_fill_pattern.value, config.bottom_fill_pattern.value,
+                                           config.solid_fill_pattern.value, config.bridge_fill_pattern.value }) {
+                switch (pattern) {
+                case ipRectilinear: case ipAlignedRectilinear: case ipGrid: case ipTriangles: case ipStars: case ipLine:
+                case ipConcentric: case ipConcentricGapFill: case ipHilbertCurve: case ipArchimedeanChords: case ipOctagramSpiral:
+                case ipSmooth: case ipSmoothHilbert: case ipSmoothTriple: case ipRectiWithPerimeter: case ipSawtooth:
+                case ipRectilinearWGapFill: case ipMonotonic: case ipMonotonicWGapFill:
+                    break;
+                case ipHoneycomb:
+                    // Rotated by 60 degrees every layer.
+                    period = std::lcm(period, size_t(3));
+                    break;
+                default:
+                    return 0;
+                }
+            }
+        }
+        return period;
+    }
+
+    // Copy the results of LayerRegion::make_perimeters() of a layer with the same slices, lower slices and upper slices.
+    static void copy_perimeters(const Layer &src, Layer &dst)
+    {
+        assert(src.region_count() == dst.region_count());
+        for (size_t region_id = 0; region_id < src.region_count(); ++ region_id) {
+            const LayerRegion &src_layerm = *src.get_region(region_id);
+            LayerRegion       &layerm     = *dst.get_region(region_id);
+            layerm.perimeters                 = src_layerm.perimeters;
+            layerm.thin_fills                 = src_layerm.thin_fills;
+            layerm.fill_surfaces              = src_layerm.fill_surfaces;
+            layerm.fill_expolygons            = src_layerm.fill_expolygons;
+            layerm.fill_no_overlap_expolygons = src_layerm.fill_no_overlap_expolygons;
+        }
+    }
+
     // 1) Merges typed region slices into stInternal type.
     // 2) Increases an "extra perimeters" counter at region slices where needed.
     // 3) Generates perimeters, gap fills and fill regions (fill regions of type stInternal).
@@ -353,11 +459,41 @@ namespace Slic3r {
             BOOST_LOG_TRIVIAL(debug) << "Generating extra perimeters for region " << region_id << " in parallel - end";
         }
 
-        BOOST_LOG_TRIVIAL(debug) << "Generating perimeters in parallel - start";
+        // Prismatic objects have long runs of layers with the same slices. Inside such a run, a layer has the same slices, lower slices
+        // and upper slices as the layer two layers below (the perimeter generator alternates some features on odd layers),
+        // so its perimeters are copied from that layer instead of being generated again.
+        std::vector<size_t> perimeters_sources;
+        {
+            bool reuse = ! print()->config().spiral_vase;
+            for (size_t region_id = 0; region_id < this->num_printing_regions(); ++ region_id)
+                // Fuzzy skin is random on each layer.
+                reuse &= this->printing_region(region_id).config().fuzzy_skin.value == FuzzySkinType::None;
+            std::vector<char> same_as_previous(m_layers.size(), false);
+            if (reuse)
+                tbb::parallel_for(tbb::blocked_range<size_t>(1, std::max<size_t>(1, m_layers.size())), [this, &same_as_previous](const tbb::blocked_range<size_t>& range) {
+                    for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx)
+                        same_as_previous[layer_idx] = layers_have_same_slices(*m_layers[layer_idx - 1], *m_layers[layer_idx]);
+                });
+            perimeters_sources = layer_result_sources(m_layers.size(), reuse ? 2 : 0, [this, &same_as_previous](size_t below, size_t layer_idx) {
+                if (below == 0 || layer_idx + 1 == m_layers.size())
+                    return false;
+                for (size_t i = below; i <= layer_idx + 1; ++ i)
+                    if (! same_as_previous[i])
+                        return false;
+                return true;
+            });
+        }
+        size_t num_perimeters_copies = 0;
+        for (size_t layer_idx = 0; layer_idx < perimeters_sources.size(); ++ layer_idx)
+            num_perimeters_copies += perimeters_sources[layer_idx] != layer_idx;
+
+        BOOST_LOG_TRIVIAL(debug) << "Generating perimeters in parallel - start, " << num_perimeters_copies << " layers copy their perimeters";
         tbb::parallel_for(
             tbb::blocked_range<size_t>(0, m_layers.size()),
-            [this, &atomic_count, nb_layers_update](const tbb::blocked_range<size_t>& range) {
+            [this, &perimeters_sources, &atomic_count, nb_layers_update](const tbb::blocked_range<size_t>& range) {
             for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++layer_idx) {
+                if (perimeters_sources[layer_idx] != layer_idx)
+                    continue;
                 std::chrono::time_point<std::chrono::system_clock> start_make_perimeter = std::chrono::system_clock::now();
                 m_print->throw_if_canceled();
                 m_layers[layer_idx]->make_perimeters();
@@ -371,6 +507,16 @@ namespace Slic3r {
             }
         }
         );
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, m_layers.size()),
+            [this, &perimeters_sources](const tbb::blocked_range<size_t>& range) {
+            for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++layer_idx)
+                if (size_t source_idx = perimeters_sources[layer_idx]; source_idx != layer_idx) {
+                    m_print->throw_if_canceled();
+                    copy_perimeters(*m_layers[source_idx], *m_layers[layer_idx]);
+                }
+        }
+        );
         m_print->set_status(100, "", PrintBase::SlicingStatus::SECONDARY_STATE);
         m_print->throw_if_canceled();
         BOOST_LOG_TRIVIAL(debug) << "Generating perimeters in parallel - end";
@@ -592,14 +738,31 @@ namespace Slic3r {
             std::atomic<int> atomic_count{ 0 };
             const int nb_layers_update = std::max(1, (int)m_layers.size() / 20);
 
-            BOOST_LOG_TRIVIAL(debug) << "Filling layers in parallel - start";
+            // The fills of a layer with the same fill surfaces and gap fills as a layer a fill period below (the fill direction alternates
+            // between layers) are copied from that layer. The first layer is never a source, its flow and extrusion width differ.
+            std::vector<size_t> fills_sources = layer_result_sources(m_layers.size(), fill_period(*this), [this](size_t below, size_t layer_idx) {
+                return below != 0 && layers_have_same_fill_input(*m_layers[below], *m_layers[layer_idx]);
+            });
+            size_t num_fills_copies = 0;
+            for (size_t layer_idx = 0; layer_idx < fills_sources.size(); ++ layer_idx)
+                num_fills_copies += fills_sources[layer_idx] != layer_idx;
+
+            // Invalidating posInfill invalidates posIroning, thus iron each layer as soon as it is filled rather than after all the layers
+            // are filled, ironing of a layer only depends on the fills of the same layer. When only posIroning is invalidated,
+            // ironing() irons the layers alone.
+            assert(! this->is_step_done(posIroning));
+            BOOST_LOG_TRIVIAL(debug) << "Filling and ironing layers in parallel - start, " << num_fills_copies << " layers copy their fills";
             tbb::parallel_for(
                 tbb::blocked_range<size_t>(0, m_layers.size()),
-                [this, &adaptive_fill_octree = adaptive_fill_octree, &support_fill_octree = support_fill_octree, &lightning_generator, &atomic_count, nb_layers_update](const tbb::blocked_range<size_t>& range) {
+                [this, &fills_sources, &adaptive_fill_octree = adaptive_fill_octree, &support_fill_octree = support_fill_octree, &lightning_generator, &atomic_count, nb_layers_update](const tbb::blocked_range<size_t>& range) {
                 for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++layer_idx) {
+                    if (fills_sources[layer_idx] != layer_idx)
+                        continue;
                     std::chrono::time_point<std::chrono::system_clock> start_make_fill = std::chrono::system_clock::now();
                     m_print->throw_if_canceled();
                     m_layers[layer_idx]->make_fills(adaptive_fill_octree.get(), support_fill_octree.get(), lightning_generator.get());
+                    m_print->throw_if_canceled();
+                    m_layers[layer_idx]->make_ironing();
 
                     // updating progress
                     int nb_layers_done = (++atomic_count);
@@ -610,16 +773,33 @@ namespace Slic3r {
                 }
             }
             );
+            tbb::parallel_for(
+                tbb::blocked_range<size_t>(0, m_layers.size()),
+                [this, &fills_sources](const tbb::blocked_range<size_t>& range) {
+                for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++layer_idx)
+                    if (size_t source_idx = fills_sources[layer_idx]; source_idx != layer_idx) {
+                        m_print->throw_if_canceled();
+                        Layer &layer = *m_layers[layer_idx];
+                        for (size_t region_id = 0; region_id < layer.region_count(); ++ region_id) {
+                            layer.get_region(region_id)->fills = m_layers[source_idx]->get_region(region_id)->fills;
+                            layer.get_region(region_id)->ironings.clear();
+                        }
+                        // The upper layer of the source may differ.
+                        layer.make_ironing();
+                    }
+            }
+            );
             m_print->set_status(100, "", PrintBase::SlicingStatus::SECONDARY_STATE);
             //for (size_t layer_idx = 0; layer_idx < m_layers.size(); ++ layer_idx) {
             //    m_print->throw_if_canceled();
             //    m_layers[layer_idx]->make_fills();
             //}
             m_print->throw_if_canceled();
-            BOOST_LOG_TRIVIAL(debug) << "Filling layers in parallel - end";
+            BOOST_LOG_TRIVIAL(debug) << "Filling and ironing layers in parallel - end";
             /*  we could free memory now, but this would make this step not idempotent
             ### $_->fill_surfaces->clear for map @{$_->regions}, @{$object->layers};
             */
+            m_ironed_with_fills = true;
             this->set_done(posInfill);
         }
     }
@@ -627,19 +807,26 @@ namespace Slic3r {
     void PrintObject::ironing()
     {
         if (this->set_started(posIroning)) {
-            BOOST_LOG_TRIVIAL(debug) << "Ironing in parallel - start";
-            tbb::parallel_for(
-            // Ironing starting with layer 0 to support ironing all surfaces.
-            tbb::blocked_range<size_t>(0, m_layers.size()),
-                [this](const tbb::blocked_range<size_t>& range) {
-                    for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++layer_idx) {
-                        m_print->throw_if_canceled();
-                        m_layers[layer_idx]->make_ironing();
+            // The layers were ironed by infill() together with their fills, unless only posIroning was invalidated since.
+            if (! m_ironed_with_fills) {
+                BOOST_LOG_TRIVIAL(debug) << "Ironing in parallel - start";
+                tbb::parallel_for(
+                // Ironing starting with layer 0 to support ironing all surfaces.
+                tbb::blocked_range<size_t>(0, m_layers.size()),
+                    [this](const tbb::blocked_range<size_t>& range) {
+                        for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++layer_idx) {
+                            m_print->throw_if_canceled();
+                            Layer &layer = *m_layers[layer_idx];
+                            for (size_t region_id = 0; region_id < layer.region_count(); ++ region_id)
+                                layer.get_region(region_id)->ironings.clear();
+                            layer.make_ironing();
+                        }
                     }
-                }
-            );
-            m_print->throw_if_canceled();
-            BOOST_LOG_TRIVIAL(debug) << "Ironing in parallel - end";
+                );
+                m_print->throw_if_canceled();
+                BOOST_LOG_TRIVIAL(debug) << "Ironing in parallel - end";
+            }
+            m_ironed_with_fills = false;
             this->set_done(posIroning);
         }
     }
@@ -664,6 +851,22 @@ namespace Slic3r {
         }
     }
 
+    void PrintObject::release_intermediate_data()
+    {
+        assert(this->is_step_done(posInfill) && this->is_step_done(posIroning) && this->is_step_done(posSupportMaterial));
+        BOOST_LOG_TRIVIAL(debug) << "Releasing the intermediate data of the layers" << log_memory_info();
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, m_layers.size()),
+            [this](const tbb::blocked_range<size_t>& range) {
+                for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx)
+                    m_layers[layer_idx]->release_intermediate_data();
+            });
+        m_region_slices_cache.clear();
+        m_region_slices_cache.shrink_to_fit();
+        m_layer_data_released = true;
+        BOOST_LOG_TRIVIAL(debug) << "Releasing the intermediate data of the layers - end" << log_memory_info();
+    }
+
     void PrintObject::simplify_extrusion_path()
     {
         if (this->set_started(posSimplifyPath)) {
@@ -819,6 +1022,128 @@ FillLightning::GeneratorPtr PrintObject::prepare_lightning_infill_data()
         return m_support_layers.insert(pos, new SupportLayer(id, interface_id, this, height, print_z, slice_z));
     }
 
+    size_t PrintObject::slicing_fingerprint() const
+    {
+        size_t seed = m_config.hash();
+        boost::hash_range(seed, m_trafo.data(), m_trafo.data() + 16);
+        boost::hash_combine(seed, m_center_offset.x());
+        boost::hash_combine(seed, m_center_offset.y());
+        boost::hash_combine(seed, m_size.z());
+        for (const std::unique_ptr<PrintRegion> &region : m_shared_regions->all_regions)
+            boost::hash_combine(seed, region->config_hash());
+        const ModelObject &model_object = *this->model_object();
+        for (const coordf_t z : model_object.layer_height_profile.get())
+            boost::hash_combine(seed, z);
+        for (const ModelVolume *volume : model_object.volumes) {
+            boost::hash_combine(seed, int(volume->type()));
+            boost::hash_range(seed, volume->get_matrix().data(), volume->get_matrix().data() + 16);
+            // The hash of the mesh is computed once per mesh, not at each Print::process().
+            boost::hash_combine(seed, volume->mesh_hash());
+        }
+        return seed;
+    }
+
+    bool PrintObject::has_same_slicing_input(const PrintObject &other) const
+    {
+        if (this == &other)
+            return true;
+        if (m_trafo.matrix() != other.m_trafo.matrix() || m_center_offset != other.m_center_offset || m_size != other.m_size || ! (m_config == other.m_config))
+            return false;
+        // The regions are created by Print::apply() in the order of the model volumes, thus the regions of two identical objects match one by one.
+        const PrintObjectRegions &regions = *m_shared_regions;
+        const PrintObjectRegions &other_regions = *other.m_shared_regions;
+        if (regions.all_regions.size() != other_regions.all_regions.size() || regions.layer_ranges.size() != other_regions.layer_ranges.size())
+            return false;
+        for (size_t i = 0; i < regions.all_regions.size(); ++ i)
+            if (*regions.all_regions[i] != *other_regions.all_regions[i])
+                return false;
+        for (size_t i = 0; i < regions.layer_ranges.size(); ++ i)
+            if (regions.layer_ranges[i].layer_height_range != other_regions.layer_ranges[i].layer_height_range ||
+                regions.layer_ranges[i].volume_regions.size() != other_regions.layer_ranges[i].volume_regions.size() ||
+                regions.layer_ranges[i].painted_regions.size() != other_regions.layer_ranges[i].painted_regions.size())
+                return false;
+        const ModelObject &model_object = *this->model_object();
+        const ModelObject &other_model_object = *other.model_object();
+        if (model_object.config != other_model_object.config || model_object.layer_config_ranges != other_model_object.layer_config_ranges ||
+            model_object.layer_height_profile.get() != other_model_object.layer_height_profile.get() || model_object.volumes.size() != other_model_object.volumes.size())
+            return false;
+        for (size_t i = 0; i < model_object.volumes.size(); ++ i) {
+            const ModelVolume &volume = *model_object.volumes[i];
+            const ModelVolume &other_volume = *other_model_object.volumes[i];
+            if (volume.type() != other_volume.type() || volume.get_matrix().matrix() != other_volume.get_matrix().matrix() || volume.config != other_volume.config ||
+                volume.supported_facets.get_data() != other_volume.supported_facets.get_data() ||
+                volume.seam_facets.get_data() != other_volume.seam_facets.get_data() ||
+                volume.mmu_segmentation_facets.get_data() != other_volume.mmu_segmentation_facets.get_data())
+                return false;
+            // Copies of a ModelObject share their meshes, separately loaded identical meshes are compared by their content.
+            const indexed_triangle_set &its = volume.mesh().its;
+            const indexed_triangle_set &other_its = other_volume.mesh().its;
+            if (&its != &other_its && (volume.mesh_hash() != other_volume.mesh_hash() || its.vertices != other_its.vertices || its.indices != other_its.indices))
+                return false;
+        }
+        return true;
+    }
+
+    void PrintObject::copy_layers_from(const PrintObject &src)
+    {
+        static constexpr const PrintObjectStep steps[] = { posSlice, posPerimeters, posPrepareInfill, posInfill, posIroning, posSupportMaterial };
+        auto first_step = std::find_if(std::begin(steps), std::end(steps), [this](PrintObjectStep step) { return ! this->is_step_done(step); });
+        if (first_step == std::end(steps))
+            return;
+        assert(this->has_same_slicing_input(src));
+        assert(std::all_of(std::begin(steps), std::end(steps), [&src](PrintObjectStep step) { return src.is_step_done(step); }));
+
+        // Deep copy of a layer, the layer regions are pointed to the regions of this object.
+        auto copy_layer = [this, &src](const Layer &src_layer, Layer &layer) {
+            layer.slicing_errors = src_layer.slicing_errors;
+            layer.lslices        = src_layer.lslices;
+            layer.lslices_bboxes = src_layer.lslices_bboxes;
+            for (const LayerRegion *src_layerm : src_layer.regions()) {
+                auto it = std::find_if(src.m_shared_regions->all_regions.begin(), src.m_shared_regions->all_regions.end(),
+                    [src_layerm](const std::unique_ptr<PrintRegion> &region) { return region.get() == &src_layerm->region(); });
+                assert(it != src.m_shared_regions->all_regions.end());
+                LayerRegion *layerm = layer.add_region(m_shared_regions->all_regions[it - src.m_shared_regions->all_regions.begin()].get());
+                const PrintRegion *region = layerm->m_region;
+                *layerm = *src_layerm;
+                layerm->m_layer  = &layer;
+                layerm->m_region = region;
+            }
+        };
+
+        for (auto step = first_step; step != std::end(steps); ++ step) {
+            if (! this->set_started(*step))
+                continue;
+            if (step == first_step) {
+                if (*step != posSupportMaterial) {
+                    this->clear_layers();
+                    m_layers.reserve(src.m_layers.size());
+                    for (const Layer *src_layer : src.m_layers) {
+                        m_print->throw_if_canceled();
+                        Layer *layer = this->add_layer(int(src_layer->id()), src_layer->height, src_layer->print_z, src_layer->slice_z);
+                        copy_layer(*src_layer, *layer);
+                        if (m_layers.size() > 1) {
+                            layer->lower_layer = m_layers[m_layers.size() - 2];
+                            layer->lower_layer->upper_layer = layer;
+                        }
+                    }
+                    m_typed_slices        = src.m_typed_slices;
+                    m_max_sparse_spacing  = src.m_max_sparse_spacing;
+                    m_layer_data_released = src.m_layer_data_released;
+                }
+                this->clear_support_layers();
+                m_support_layers.reserve(src.m_support_layers.size());
+                for (const SupportLayer *src_layer : src.m_support_layers) {
+                    auto *layer = new SupportLayer(src_layer->id(), src_layer->interface_id(), this, src_layer->height, src_layer->print_z, src_layer->slice_z);
+                    copy_layer(*src_layer, *layer);
+                    layer->support_islands = src_layer->support_islands;
+                    layer->support_fills   = src_layer->support_fills;
+                    m_support_layers.emplace_back(layer);
+                }
+            }
+            this->set_done(*step);
+        }
+    }
+
     // Called by Print::apply().
     // This method only accepts PrintObjectConfig and PrintRegionConfig option keys.
 bool PrintObject::invalidate_state_by_config_options(
@@ -1009,6 +1334,12 @@ bool PrintObject::invalidate_state_by_config_options(
                 || opt_key == "top_infill_extrusion_spacing"
                 || opt_key == "top_infill_extrusion_width" ) {
                 steps.emplace_back(posInfill);
+            } else if (
+                opt_key == "ironing"
+                || opt_key == "ironing_angle"
+                || opt_key == "ironing_flowrate"
+                || opt_key == "ironing_spacing") {
+                steps.emplace_back(posIroning);
         } else if (opt_key == "fill_pattern") {
             steps.emplace_back(posInfill);
 
@@ -1152,6 +1483,14 @@ bool PrintObject::invalidate_state_by_config_options(
 
     bool PrintObject::invalidate_step(PrintObjectStep step)
     {
+        if (m_layer_data_released) {
+            // The layers miss the data the step is computed from, slice again.
+            m_layer_data_released = false;
+            step = posSlice;
+        } else if (step == posIroning) {
+            // Only the ironing changed, ironing() irons the layers again without filling them.
+            m_ironed_with_fills = false;
+        }
         bool invalidated = Inherited::invalidate_step(step);
 
         // propagate to dependent steps
@@ -1167,6 +1506,7 @@ bool PrintObject::invalidate_state_by_config_options(
             invalidated |= this->invalidate_steps({ posPerimeters, posPrepareInfill, posInfill, posIroning, posSupportMaterial, posSimplifyPath });
             invalidated |= m_print->invalidate_steps({ psSkirtBrim });
             m_slicing_params->valid = false;
+            m_region_slices_cache.clear();
         } else if (step == posSupportMaterial) {
             invalidated |= m_print->invalidate_steps({ psSkirtBrim });
             m_slicing_params->valid = false;
@@ -1187,6 +1527,17 @@ bool PrintObject::invalidate_state_by_config_options(
         bool result = Inherited::invalidate_all_steps() | m_print->invalidate_all_steps();
         // Then reset some of the depending values.
         m_slicing_params->valid = false;
+        m_region_slices_cache.clear();
+        m_layer_data_released = false;
+        return result;
+    }
+
+    bool PrintObject::invalidate_layer_height_profile()
+    {
+        // invalidate_step(posSlice) drops the cache, the slices of the mesh are still valid for the Z levels kept.
+        std::vector<std::pair<float, std::vector<ExPolygons>>> region_slices_cache = std::move(m_region_slices_cache);
+        bool result = this->invalidate_step(posSlice);
+        m_region_slices_cache = std::move(region_slices_cache);
         return result;
     }
 
@@ -2063,9 +2414,10 @@ bool PrintObject::invalidate_state_by_config_options(
                     Flow         solid_infill_flow = layerm->flow(frSolidInfill);
                     coord_t      infill_line_spacing = solid_infill_flow.scaled_spacing();
                     // Find a union of perimeters below / above this surface to guarantee a minimum shell thickness.
-                    ExPolygons shell;
-                    ExPolygons fill_shell; // for nb_perimeter_layers_for_solid_fill
-                    ExPolygons max_perimeter_shell; // for nb_perimeter_layers_for_solid_fill
+                    // The shells are accumulated as flat polygon sets, as they are merged with the surfaces of each layer.
+                    PolygonSet shell_set;
+                    PolygonSet fill_shell; // for nb_perimeter_layers_for_solid_fill
+                    PolygonSet max_perimeter_shell; // for nb_perimeter_layers_for_solid_fill
                     ExPolygons holes;
 #ifdef SLIC3R_DEBUG_SLICE_PROCESSING
                     ExPolygons shell_ex;
@@ -2108,19 +2460,19 @@ bool PrintObject::invalidate_state_by_config_options(
                                 if (!holes.empty())
                                     holes = intersection_ex(holes, cache.holes);
                                 if (!cache.top_surfaces.empty()) {
-                                    expolygons_append(shell, cache.top_surfaces);
+                                    shell_set.append(cache.top_surfaces);
                                     // Running the union_ using the Clipper library piece by piece is cheaper 
                                     // than running the union_ all at once.
-                                    shell = union_ex(shell);
+                                    shell_set = union_(shell_set);
                                 }
                                 if (nb_perimeter_layers_for_solid_fill != 0 && (idx_layer > min_layer_no_solid || print_z < min_z_no_solid)) {
                                     if (!cache.top_fill_surfaces.empty()) {
-                                        expolygons_append(fill_shell, cache.top_fill_surfaces);
-                                        fill_shell = union_ex(fill_shell);
+                                        fill_shell.append(cache.top_fill_surfaces);
+                                        fill_shell = union_(fill_shell);
                                     }
                                     if (nb_perimeter_layers_for_solid_fill > 1 && i - idx_layer < nb_perimeter_layers_for_solid_fill) {
-                                        expolygons_append(max_perimeter_shell, cache.top_perimeter_surfaces);
-                                        max_perimeter_shell = union_ex(max_perimeter_shell);
+                                        max_perimeter_shell.append(cache.top_perimeter_surfaces);
+                                        max_perimeter_shell = union_(max_perimeter_shell);
                                     }
                                 }
                             }
@@ -2137,28 +2489,28 @@ bool PrintObject::invalidate_state_by_config_options(
                                 if (!holes.empty())
                                     holes = intersection_ex(holes, cache.holes);
                                 if (!cache.bottom_surfaces.empty()) {
-                                    expolygons_append(shell, cache.bottom_surfaces);
+                                    shell_set.append(cache.bottom_surfaces);
                                     // Running the union_ using the Clipper library piece by piece is cheaper 
                                     // than running the union_ all at once.
-                                    shell = union_ex(shell);
+                                    shell_set = union_(shell_set);
                                 }
                                 if (nb_perimeter_layers_for_solid_fill != 0 && (idx_layer > min_layer_no_solid || layer->print_z < min_z_no_solid)) {
                                     if (!cache.bottom_fill_surfaces.empty()) {
-                                        expolygons_append(fill_shell, cache.bottom_fill_surfaces);
-                                        fill_shell = union_ex(fill_shell);
+                                        fill_shell.append(cache.bottom_fill_surfaces);
+                                        fill_shell = union_(fill_shell);
                                     }
                                     if (nb_perimeter_layers_for_solid_fill > 1 && idx_layer - i < nb_perimeter_layers_for_solid_fill) {
-                                        expolygons_append(max_perimeter_shell, cache.bottom_perimeter_surfaces);
-                                        max_perimeter_shell = union_ex(max_perimeter_shell);
+                                        max_perimeter_shell.append(cache.bottom_perimeter_surfaces);
+                                        max_perimeter_shell = union_(max_perimeter_shell);
                                     }
                                 }
                             }
                         }
 #ifdef SLIC3R_DEBUG_SLICE_PROCESSING
                         {
-                            Slic3r::SVG svg(debug_out_path("discover_vertical_shells-perimeters-before-union-%d.svg", debug_idx), get_extents(shell));
-                            svg.draw(shell);
-                            svg.draw_outline(shell, "black", scale_(0.05));
+                            Slic3r::SVG svg(debug_out_path("discover_vertical_shells-perimeters-before-union-%d.svg", debug_idx), get_extents(shell_set));
+                            svg.draw(to_polygons(shell_set));
+                            svg.draw_outline(to_polygons(shell_set), "black", scale_(0.05));
                             svg.Close();
                         }
 #endif /* SLIC3R_DEBUG_SLICE_PROCESSING */
@@ -2170,7 +2522,7 @@ bool PrintObject::invalidate_state_by_config_options(
                         }
 #endif
 #ifdef SLIC3R_DEBUG_SLICE_PROCESSING
-                        shell_ex = union_safety_offset_ex(shell);
+                        shell_ex = union_ex(shell_set);
 #endif /* SLIC3R_DEBUG_SLICE_PROCESSING */
                     }
 
@@ -2179,7 +2531,7 @@ bool PrintObject::invalidate_state_by_config_options(
 
 #ifdef SLIC3R_DEBUG_SLICE_PROCESSING
                     {
-                        Slic3r::SVG svg(debug_out_path("discover_vertical_shells-perimeters-after-union-%d.svg", debug_idx), get_extents(shell));
+                        Slic3r::SVG svg(debug_out_path("discover_vertical_shells-perimeters-after-union-%d.svg", debug_idx), get_extents(shell_set));
                         svg.draw(shell_ex);
                         svg.draw_outline(shell_ex, "black", "blue", scale_(0.05));
                         svg.Close();
@@ -2188,7 +2540,7 @@ bool PrintObject::invalidate_state_by_config_options(
 
 #ifdef SLIC3R_DEBUG_SLICE_PROCESSING
                     {
-                        Slic3r::SVG svg(debug_out_path("discover_vertical_shells-internal-wshell-%d.svg", debug_idx), get_extents(shell));
+                        Slic3r::SVG svg(debug_out_path("discover_vertical_shells-internal-wshell-%d.svg", debug_idx), get_extents(shell_set));
                         svg.draw(layerm->fill_surfaces.filter_by_type(stInternal), "yellow", 0.5);
                         svg.draw_outline(layerm->fill_surfaces.filter_by_type(stInternal), "black", "blue", scale_(0.05));
                         svg.draw(shell_ex, "blue", 0.5);
@@ -2196,7 +2548,7 @@ bool PrintObject::invalidate_state_by_config_options(
                         svg.Close();
                     }
                     {
-                        Slic3r::SVG svg(debug_out_path("discover_vertical_shells-internalvoid-wshell-%d.svg", debug_idx), get_extents(shell));
+                        Slic3r::SVG svg(debug_out_path("discover_vertical_shells-internalvoid-wshell-%d.svg", debug_idx), get_extents(shell_set));
                         svg.draw(layerm->fill_surfaces.filter_by_type(stInternalVoid), "yellow", 0.5);
                         svg.draw_outline(layerm->fill_surfaces.filter_by_type(stInternalVoid), "black", "blue", scale_(0.05));
                         svg.draw(shell_ex, "blue", 0.5);
@@ -2204,7 +2556,7 @@ bool PrintObject::invalidate_state_by_config_options(
                         svg.Close();
                     }
                     {
-                        Slic3r::SVG svg(debug_out_path("discover_vertical_shells-internalvoid-wshell-%d.svg", debug_idx), get_extents(shell));
+                        Slic3r::SVG svg(debug_out_path("discover_vertical_shells-internalvoid-wshell-%d.svg", debug_idx), get_extents(shell_set));
                         svg.draw(layerm->fill_surfaces.filter_by_type(stInternalVoid), "yellow", 0.5);
                         svg.draw_outline(layerm->fill_surfaces.filter_by_type(stInternalVoid), "black", "blue", scale_(0.05));
                         svg.draw(shell_ex, "blue", 0.5);
@@ -2215,8 +2567,8 @@ bool PrintObject::invalidate_state_by_config_options(
                     // Trim the shells region by the internal & internal void surfaces.
                     const SurfaceType surfaceTypesInternal[] = { stPosInternal | stDensSparse, stPosInternal | stDensVoid, stPosInternal | stDensSolid };
                     const ExPolygons  polygonsInternal = to_expolygons(layerm->fill_surfaces.filter_by_types(surfaceTypesInternal, 3));
+                    ExPolygons shell = intersection_ex(shell_set, polygonsInternal, ApplySafetyOffset::Yes);
                     {
-                        shell = intersection_ex(shell, polygonsInternal, ApplySafetyOffset::Yes);
                         expolygons_append(shell, diff_ex(polygonsInternal, holes));
                         shell = union_ex(shell);
                         //check if a polygon is only over perimeter, in this case evict it (depends from nb_perimeter_layers_for_solid_fill value)
@@ -530,6 +530,7 @@ void PrintObject::slice()
     this->update_layer_height_profile(*this->model_object(), *m_slicing_params, layer_height_profile);
     m_print->throw_if_canceled();
     m_typed_slices = false;
+    m_layer_data_released = false;
     this->clear_layers();
     m_layers = new_layers(this, generate_object_layers(*m_slicing_params, layer_height_profile));
     this->slice_volumes();
@@ -900,25 +901,78 @@ void PrintObject::slice_volumes()
     }
 
     std::vector<float>                   slice_zs      = zs_from_layers(m_layers);
-    std::vector<VolumeSlices> volume_slices = slice_volumes_inner(
-        print->config(),
-        this->config(),
-        this->trafo_centered(),
-        this->model_object()->volumes,
-        m_shared_regions->layer_ranges,
-        slice_zs,
-        throw_on_cancel_callback);
-
-    std::vector<std::vector<ExPolygons>> region_slices = slices_to_regions(
-        print->config(),
-        *this,
-        this->model_object()->volumes, 
-        *m_shared_regions, 
-        slice_zs,
-        std::move(volume_slices),
-        m_config.clip_multipart_objects,
-        throw_on_cancel_callback);
+    std::vector<std::vector<ExPolygons>> region_slices(m_shared_regions->all_regions.size(), std::vector<ExPolygons>(slice_zs.size(), ExPolygons()));
+    // Reuse the region slices of the Z levels sliced before the layer height profile was edited.
+    // Spiral vase slices the bottom layers differently based on their index, thus their slices cannot be reused.
+    std::vector<size_t>                  slice_zs_idx_new;
+    std::vector<float>                   slice_zs_new;
+    {
+        const bool reuse = ! print->config().spiral_vase;
+        auto       it_cache = m_region_slices_cache.begin();
+        for (size_t z_idx = 0; z_idx < slice_zs.size(); ++ z_idx) {
+            for (; it_cache != m_region_slices_cache.end() && it_cache->first < slice_zs[z_idx]; ++ it_cache) ;
+            if (reuse && it_cache != m_region_slices_cache.end() && it_cache->first == slice_zs[z_idx] && it_cache->second.size() == region_slices.size()) {
+                for (size_t region_id = 0; region_id < region_slices.size(); ++ region_id)
+                    region_slices[region_id][z_idx] = std::move(it_cache->second[region_id]);
+            } else {
+                slice_zs_idx_new.emplace_back(z_idx);
+                slice_zs_new.emplace_back(slice_zs[z_idx]);
+            }
+        }
+        m_region_slices_cache.clear();
+        m_region_slices_cache.shrink_to_fit();
+    }
+    BOOST_LOG_TRIVIAL(debug) << "Slicing volumes - slicing " << slice_zs_new.size() << " of " << slice_zs.size() << " layers";
+
+    if (! slice_zs_new.empty()) {
+        std::vector<VolumeSlices> volume_slices = slice_volumes_inner(
+            print->config(),
+            this->config(),
+            this->trafo_centered(),
+            this->model_object()->volumes,
+            m_shared_regions->layer_ranges,
+            slice_zs_new,
+            throw_on_cancel_callback);
+
+        std::vector<std::vector<ExPolygons>> region_slices_new = slices_to_regions(
+            print->config(),
+            *this,
+            this->model_object()->volumes, 
+            *m_shared_regions, 
+            slice_zs_new,
+            std::move(volume_slices),
+            m_config.clip_multipart_objects,
+            throw_on_cancel_callback);
+
+        for (size_t region_id = 0; region_id < region_slices.size(); ++ region_id)
+            for (size_t i = 0; i < slice_zs_new.size(); ++ i)
+                region_slices[region_id][slice_zs_idx_new[i]] = std::move(region_slices_new[region_id][i]);
+    }
 
+    // Keep the region slices of objects with a layer height profile for its next edit. The copy is not kept for large objects,
+    // it would stay in memory as long as the PrintObject.
+    static constexpr const size_t max_region_slices_cache_size = 64 * 1024 * 1024;
+    auto region_slices_size = [&region_slices]() {
+        size_t size = 0;
+        for (const std::vector<ExPolygons> &by_layer : region_slices)
+            for (const ExPolygons &expolygons : by_layer)
+                for (const ExPolygon &expolygon : expolygons) {
+                    size += sizeof(ExPolygon) + expolygon.contour.size() * sizeof(Point);
+                    for (const Polygon &hole : expolygon.holes)
+                        size += sizeof(Polygon) + hole.size() * sizeof(Point);
+                }
+        return size;
+    };
+    if (! print->config().spiral_vase && ! this->model_object()->layer_height_profile.empty() && region_slices_size() <= max_region_slices_cache_size) {
+        m_region_slices_cache.reserve(slice_zs.size());
+        for (size_t z_idx = 0; z_idx < slice_zs.size(); ++ z_idx) {
+            std::vector<ExPolygons> by_region;
+            by_region.reserve(region_slices.size());
+            for (const std::vector<ExPolygons> &by_layer : region_slices)
+                by_region.emplace_back(by_layer[z_idx]);
+            m_region_slices_cache.emplace_back(slice_zs[z_idx], std::move(by_region));
+        }
+    }
 
 
     for (size_t region_id = 0; region_id < region_slices.size(); ++ region_id) {
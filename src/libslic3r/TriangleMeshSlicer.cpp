@@ -14,6 +14,7 @@
 
 #include <boost/log/trivial.hpp>
 
+#include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_for.h>
 
 #ifndef NDEBUG
@@ -312,8 +313,8 @@ void slice_facet_at_zs(
     const Vec3i32                                    &edge_ids,
     // Scaled or unscaled zs. If vertices have their zs scaled or transform_vertex_fn scales them, then zs have to be scaled as well.
     const std::vector<float>                         &zs,
-    std::vector<IntersectionLines>                   &lines,
-    std::array<std::mutex, 64>                       &lines_mutex)
+    // Intersection lines bucketed by slice, owned by the calling thread.
+    std::vector<IntersectionLines>                   &lines)
 {
     stl_vertex vertices[3] { transform_vertex_fn(mesh_vertices[indices(0)]), transform_vertex_fn(mesh_vertices[indices(1)]), transform_vertex_fn(mesh_vertices[indices(2)]) };
 
@@ -331,9 +332,7 @@ void slice_facet_at_zs(
         // Ignore horizontal triangles. Any valid horizontal triangle must have a vertical triangle connected, otherwise the part has zero volume.
         if (min_z != max_z && slice_facet(*it, vertices, indices, edge_ids, idx_vertex_lowest, false, il) == FacetSliceType::Slicing) {
             assert(il.edge_type != IntersectionLine::FacetEdgeType::Horizontal);
-            size_t slice_id = it - zs.begin();
-            boost::lock_guard<std::mutex> l(lines_mutex[slice_id % lines_mutex.size()]);
-            lines[slice_id].emplace_back(il);
+            lines[it - zs.begin()].emplace_back(il);
         }
     }
 }
@@ -347,15 +346,41 @@ static inline std::vector<IntersectionLines> slice_make_lines(
     const std::vector<float>                        &zs,
     const ThrowOnCancel                              throw_on_cancel_fn)
 {
-    std::vector<IntersectionLines>  lines(zs.size(), IntersectionLines());
-    std::array<std::mutex, 64>      lines_mutex;
+    // Each thread collects the intersection lines into its own buckets per slice without locking,
+    // the buckets are concatenated per slice at the end.
+    tbb::enumerable_thread_specific<std::vector<IntersectionLines>> lines_per_thread([&zs]() { return std::vector<IntersectionLines>(zs.size(), IntersectionLines()); });
     tbb::parallel_for(
         tbb::blocked_range<int>(0, int(indices.size())),
-        [&vertices, &transform_vertex_fn, &indices, &face_edge_ids, &zs, &lines, &lines_mutex, throw_on_cancel_fn](const tbb::blocked_range<int> &range) {
+        [&vertices, &transform_vertex_fn, &indices, &face_edge_ids, &zs, &lines_per_thread, throw_on_cancel_fn](const tbb::blocked_range<int> &range) {
+            std::vector<IntersectionLines> &lines = lines_per_thread.local();
             for (int face_idx = range.begin(); face_idx < range.end(); ++ face_idx) {
                 if ((face_idx & 0x0ffff) == 0)
                     throw_on_cancel_fn();
-                slice_facet_at_zs(vertices, transform_vertex_fn, indices[face_idx], face_edge_ids[face_idx], zs, lines, lines_mutex);
+                slice_facet_at_zs(vertices, transform_vertex_fn, indices[face_idx], face_edge_ids[face_idx], zs, lines);
+            }
+        }
+    );
+
+    std::vector<IntersectionLines>  lines(zs.size(), IntersectionLines());
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, zs.size()),
+        [&lines_per_thread, &lines](const tbb::blocked_range<size_t> &range) {
+            for (size_t slice_id = range.begin(); slice_id < range.end(); ++ slice_id) {
+                size_t num_lines = 0;
+                for (const std::vector<IntersectionLines> &thread_lines : lines_per_thread)
+                    num_lines += thread_lines[slice_id].size();
+                IntersectionLines &out = lines[slice_id];
+                out.reserve(num_lines);
+                for (std::vector<IntersectionLines> &thread_lines : lines_per_thread) {
+                    IntersectionLines &src = thread_lines[slice_id];
+                    if (src.size() == num_lines)
+                        // All the lines of this slice were collected by a single thread.
+                        out = std::move(src);
+                    else
+                        out.insert(out.end(), src.begin(), src.end());
+                    // Release the memory as soon as possible.
+                    IntersectionLines().swap(src);
+                }
             }
         }
     );
@@ -2,6 +2,7 @@
 
 #include "test_data.hpp"
 #include "clipper/clipper_z.hpp"
+#include "clipper.hpp"
 
 using namespace Slic3r;
 
@@ -40,4 +41,50 @@ SCENARIO("Clipper Z", "[ClipperZ]")
     REQUIRE(paths.front().size() == 2);
     for (const ClipperLib_Z::IntPoint &pt : paths.front())
         REQUIRE(pt.z() == 1);
-}
\ No newline at end of file
+}
+SCENARIO("Clipper engines free the memory kept for the next operation", "[Clipper]")
+{
+    // Overlapping squares.
+    ClipperLib::Paths squares;
+    for (ClipperLib::cInt i = 0; i < 50; ++ i)
+        for (ClipperLib::cInt j = 0; j < 50; ++ j)
+            squares.push_back({ { i * 100, j * 100 }, { i * 100 + 150, j * 100 }, { i * 100 + 150, j * 100 + 150 }, { i * 100, j * 100 + 150 } });
+
+    GIVEN("A Clipper after a union") {
+        ClipperLib::Clipper clipper;
+        ClipperLib::Paths   result;
+        clipper.AddPaths(squares, ClipperLib::ptSubject, true);
+        clipper.Execute(ClipperLib::ctUnion, result, ClipperLib::pftNonZero);
+        clipper.Clear();
+        THEN("Clear() keeps the memory, ReleaseMemory() frees it and the union is computed the same again") {
+            REQUIRE(clipper.KeptMemory() > 0);
+            clipper.ReleaseMemory();
+            REQUIRE(clipper.KeptMemory() == 0);
+            ClipperLib::Paths result2;
+            clipper.AddPaths(squares, ClipperLib::ptSubject, true);
+            clipper.Execute(ClipperLib::ctUnion, result2, ClipperLib::pftNonZero);
+            REQUIRE(result2 == result);
+        }
+    }
+    GIVEN("A ClipperOffset after an offset") {
+        ClipperLib::ClipperOffset offsetter;
+        ClipperLib::Paths         result;
+        offsetter.AddPaths(squares, ClipperLib::jtRound, ClipperLib::etClosedPolygon);
+        offsetter.Execute(result, 20.);
+        offsetter.Clear();
+        THEN("Clear() keeps the edges of the clean-up union and counts them") {
+            // Each rounded square has at least two points per corner, each point is an edge of the union.
+            REQUIRE(offsetter.KeptMemory() >= squares.size() * 8 * sizeof(ClipperLib::TEdge));
+        }
+        THEN("ReleaseMemory() frees the memory kept and the offset is computed the same again") {
+            REQUIRE(offsetter.KeptMemory() > 0);
+            offsetter.ReleaseMemory();
+            REQUIRE(offsetter.KeptMemory() == 0);
+            ClipperLib::Paths result2;
+            offsetter.AddPaths(squares, ClipperLib::jtRound, ClipperLib::etClosedPolygon);
+            offsetter.Execute(result2, 20.);
+            REQUIRE(! result.empty());
+            REQUIRE(result2 == result);
+        }
+    }
+}
@@ -0,0 +1,109 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+
+#include <boost/filesystem.hpp>
+#include <boost/nowide/fstream.hpp>
+
+#include "libslic3r/libslic3r.h"
+#include "libslic3r/Model.hpp"
+#include "libslic3r/Print.hpp"
+#include "libslic3r/GCode/GCodeCache.hpp"
+
+#include "test_data.hpp"
+
+using namespace Slic3r;
+using namespace Slic3r::Test;
+
+static void write_file(const boost::filesystem::path &path, const std::string &data)
+{
+    boost::nowide::ofstream ofs(path.string(), std::ios::binary);
+    ofs << data;
+}
+
+static std::string read_file(const boost::filesystem::path &path)
+{
+    boost::nowide::ifstream ifs(path.string(), std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+}
+
+// Files of the cache directory with the given extension.
+static std::vector<boost::filesystem::path> cache_files(const boost::filesystem::path &dir, const std::string &extension)
+{
+    std::vector<boost::filesystem::path> out;
+    for (const boost::filesystem::directory_entry &entry : boost::filesystem::directory_iterator(dir))
+        if (entry.path().extension() == extension)
+            out.emplace_back(entry.path());
+    return out;
+}
+
+SCENARIO("G-code cache", "[GCodeCache]") {
+    GIVEN("A cube, its print config and an exported G-code") {
+        const boost::filesystem::path dir       = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+        const boost::filesystem::path cache_dir = dir / "cache";
+        const boost::filesystem::path outfile   = dir / "cube.gcode";
+        boost::filesystem::create_directories(dir);
+        Slic3r::Print print;
+        Slic3r::Model model;
+        Slic3r::Test::init_print({TestMesh::cube_20x20x20}, print, model, Slic3r::DynamicPrintConfig::full_print_config());
+        const DynamicPrintConfig config = print.full_print_config();
+        const std::string key = gcode_cache_key(model, config, outfile.string());
+        write_file(outfile, "G1 X1 Y1\n");
+
+        WHEN("the cache is empty") {
+            THEN("the G-code is not found") {
+                REQUIRE(gcode_cache_load(cache_dir.string(), key).empty());
+            }
+        }
+        WHEN("the G-code is stored and the output file removed") {
+            gcode_cache_store(cache_dir.string(), key, outfile.string());
+            boost::filesystem::remove(outfile);
+            THEN("the cache keeps the G-code and its key, without temporary files") {
+                REQUIRE(cache_files(cache_dir, ".gcode").size() == 1);
+                REQUIRE(cache_files(cache_dir, ".key").size() == 1);
+                REQUIRE(cache_files(cache_dir, ".tmp").empty());
+            }
+            THEN("the same job is a hit and restores the output file") {
+                REQUIRE(gcode_cache_key(model, config, outfile.string()) == key);
+                REQUIRE(gcode_cache_load(cache_dir.string(), key) == outfile.string());
+                REQUIRE(read_file(outfile) == "G1 X1 Y1\n");
+            }
+            THEN("a different print config is a miss") {
+                DynamicPrintConfig config_changed = config;
+                config_changed.set_key_value("layer_height", new ConfigOptionFloat(0.1));
+                const std::string key_changed = gcode_cache_key(model, config_changed, outfile.string());
+                REQUIRE(key_changed != key);
+                REQUIRE(gcode_cache_load(cache_dir.string(), key_changed).empty());
+            }
+            THEN("a color change is a miss") {
+                model.custom_gcode_per_print_z.gcodes.push_back({ 10., CustomGCode::ColorChange, 1, "#FF0000", "" });
+                const std::string key_changed = gcode_cache_key(model, config, outfile.string());
+                REQUIRE(key_changed != key);
+                REQUIRE(gcode_cache_load(cache_dir.string(), key_changed).empty());
+            }
+            THEN("a moved instance is a miss") {
+                model.objects.front()->instances.front()->set_offset(Vec3d(5., 0., 0.));
+                const std::string key_changed = gcode_cache_key(model, config, outfile.string());
+                REQUIRE(key_changed != key);
+                REQUIRE(gcode_cache_load(cache_dir.string(), key_changed).empty());
+            }
+            THEN("an entry stored under the same file name by a different job is a miss") {
+                const std::vector<boost::filesystem::path> key_files = cache_files(cache_dir, ".key");
+                REQUIRE(key_files.size() == 1);
+                write_file(key_files.front(), outfile.string() + "\n" + "another job");
+                REQUIRE(gcode_cache_load(cache_dir.string(), key).empty());
+            }
+        }
+        WHEN("the exported G-code does not exist") {
+            boost::filesystem::remove(outfile);
+            gcode_cache_store(cache_dir.string(), key, outfile.string());
+            THEN("nothing is stored and no temporary file is left") {
+                REQUIRE(cache_files(cache_dir, ".gcode").empty());
+                REQUIRE(cache_files(cache_dir, ".key").empty());
+                REQUIRE(cache_files(cache_dir, ".tmp").empty());
+                REQUIRE(gcode_cache_load(cache_dir.string(), key).empty());
+            }
+        }
+        boost::filesystem::remove_all(dir);
+    }
+}
@@ -290,3 +290,37 @@ SCENARIO("Find/Replace with regexp", "[GCodeFindReplace]") {
         }
     }
 }
+
+SCENARIO("Find/Replace with multiple substitutions", "[GCodeFindReplace]") {
+    GIVEN("G-code") {
+        const std::string gcode =
+            "G1 Z0; home\n"
+            "G1 Z1; move up\n"
+            "G1 X0 Y1 Z1; perimeter\n"
+            "G1 X13 Y32 Z1; infill\n";
+        WHEN("Substitutions of patterns not present in the G-code are skipped") {
+            GCodeFindReplace find_replace({ "wipe", "retract", "", "", "MOVE UP", "move down", "i", "", "M221", "M220", "w", "" });
+            REQUIRE(find_replace.process_layer(gcode) ==
+                "G1 Z0; home\n"
+                "G1 Z1; move down\n"
+                "G1 X0 Y1 Z1; perimeter\n"
+                "G1 X13 Y32 Z1; infill\n");
+        }
+        WHEN("Substitution creates the pattern of a following substitution") {
+            GCodeFindReplace find_replace({ "home", "wipe", "", "", "pe;", "wipe", "", "", "wi", "WI", "", "", "Z1; ", "", "", "", "1in", "1 in", "", "" });
+            REQUIRE(find_replace.process_layer(gcode) ==
+                "G1 Z0; WIpe\n"
+                "G1 move up\n"
+                "G1 X0 Y1 perimeter\n"
+                "G1 X13 Y32 infill\n");
+        }
+        WHEN("Regular expression creates the pattern of a following substitution") {
+            GCodeFindReplace find_replace({ "Z([01])", "Q${1}", "r", "", "Q1", "Z2", "", "" });
+            REQUIRE(find_replace.process_layer(gcode) ==
+                "G1 Q0; home\n"
+                "G1 Z2; move up\n"
+                "G1 X0 Y1 Z2; perimeter\n"
+                "G1 X13 Y32 Z2; infill\n");
+        }
+    }
+}
@@ -60,3 +60,32 @@ SCENARIO("Model construction", "[Model]") {
         }
     }
 }
+
+SCENARIO("ModelVolume mesh hash", "[Model]") {
+    GIVEN("Two objects loaded from the same mesh") {
+        Slic3r::Model model;
+        model.add_object("a", "", Slic3r::make_cube(20, 20, 20));
+        model.add_object("b", "", Slic3r::make_cube(20, 20, 20));
+        const ModelVolume &a = *model.objects.front()->volumes.front();
+        ModelVolume       &b = *model.objects.back()->volumes.front();
+        THEN("their meshes are separate, but have the same hash") {
+            REQUIRE(&a.mesh() != &b.mesh());
+            REQUIRE(a.mesh_hash() == b.mesh_hash());
+        }
+        WHEN("the mesh of the second one is replaced") {
+            size_t hash = b.mesh_hash();
+            b.set_mesh(Slic3r::make_cube(20, 20, 30));
+            THEN("the hash follows the new mesh") {
+                REQUIRE(b.mesh_hash() != hash);
+                REQUIRE(b.mesh_hash() != a.mesh_hash());
+            }
+        }
+        WHEN("the first object is copied") {
+            ModelObject *copy = model.add_object(*model.objects.front());
+            THEN("the copy shares the mesh and its hash") {
+                REQUIRE(&copy->volumes.front()->mesh() == &a.mesh());
+                REQUIRE(copy->volumes.front()->mesh_hash() == a.mesh_hash());
+            }
+        }
+    }
+}
@@ -1,8 +1,14 @@
 #include <catch2/catch.hpp>
 
+#include <tuple>
+
+#include <tbb/global_control.h>
+
 #include "libslic3r/libslic3r.h"
 #include "libslic3r/Print.hpp"
 #include "libslic3r/Layer.hpp"
+#include "libslic3r/ClipperUtils.hpp"
+#include "libslic3r/PerimeterGenerator.hpp"
 
 #include "test_data.hpp"
 
@@ -42,6 +48,140 @@ SCENARIO("PrintObject: Perimeter generation", "[PrintObject]") {
     }
 }
 
+SCENARIO("PrintObject: Overhang perimeters", "[PrintObject]") {
+    struct OverhangCounter : public ExtrusionVisitorRecursiveConst {
+        size_t overhangs = 0;
+        size_t paths     = 0;
+        void use(const ExtrusionPath &path) override { ++ paths; if (path.role() == erOverhangPerimeter) ++ overhangs; }
+    };
+    auto count_overhangs = [](const PrintObject &object) {
+        OverhangCounter counter;
+        for (const Layer *layer : object.layers())
+            for (const LayerRegion *layerm : layer->regions())
+                layerm->perimeters.visit(counter);
+        return counter;
+    };
+    GIVEN("Default overhang detection") {
+        WHEN("a cube is sliced") {
+            Slic3r::Print print;
+            Slic3r::Test::init_and_process_print({TestMesh::cube_20x20x20}, print, { { "perimeters", 3 } });
+            OverhangCounter counter = count_overhangs(*print.objects().front());
+            THEN("its fully supported loops have no overhang") {
+                REQUIRE(counter.paths > 0);
+                REQUIRE(counter.overhangs == 0);
+            }
+        }
+        WHEN("a model with an overhang is sliced") {
+            Slic3r::Print print;
+            Slic3r::Test::init_and_process_print({TestMesh::overhang}, print, { { "perimeters", 3 } });
+            THEN("the loops over the overhang are split into overhang perimeters") {
+                REQUIRE(count_overhangs(*print.objects().front()).overhangs > 0);
+            }
+        }
+    }
+    GIVEN("The layers of a model with an overhang") {
+        Slic3r::Print print;
+        Slic3r::Test::init_and_process_print({TestMesh::overhang}, print, { { "perimeters", 3 } });
+        struct PathCollector : public ExtrusionVisitorRecursiveConst {
+            ExtrusionPaths paths;
+            void use(const ExtrusionPath &path) override { paths.emplace_back(path); }
+        };
+        WHEN("the perimeters are tested against the index of the lower slices grown by two widths") {
+            size_t num_inside          = 0;
+            size_t num_outside         = 0;
+            size_t num_inside_clipped  = 0;
+            for (const Layer *layer : print.objects().front()->layers()) {
+                if (layer->lower_layer == nullptr)
+                    continue;
+                const Polygons small = offset(layer->lower_layer->lslices, float(scale_(0.2)));
+                const Polygons big   = offset(layer->lower_layer->lslices, float(scale_(0.4)));
+                OverhangRegionsIndex index;
+                index.build({ &small, &big });
+                for (const LayerRegion *layerm : layer->regions()) {
+                    PathCollector collector;
+                    layerm->perimeters.visit(collector);
+                    for (const ExtrusionPath &path : collector.paths) {
+                        const Polylines polylines { path.polyline.as_polyline() };
+                        if (index.contains(polylines.front())) {
+                            ++ num_inside;
+                            if (diff_pl(polylines, small).empty() && diff_pl(polylines, big).empty())
+                                ++ num_inside_clipped;
+                        } else
+                            ++ num_outside;
+                    }
+                }
+            }
+            THEN("the paths found inside all the regions are not clipped by the regions") {
+                REQUIRE(num_inside > 0);
+                REQUIRE(num_outside > 0);
+                REQUIRE(num_inside_clipped == num_inside);
+            }
+        }
+    }
+}
+
+SCENARIO("PrintObject: Perimeters of many islands", "[PrintObject]") {
+    // A thin plate of 6x6 separated blocks, all of them in a single object.
+    TriangleMesh plate;
+    for (int ix = 0; ix < 6; ++ ix)
+        for (int iy = 0; iy < 6; ++ iy) {
+            TriangleMesh block = make_cube(4., 4., 1.);
+            block.translate(float(ix * 6), float(iy * 6), 0.f);
+            plate.merge(block);
+        }
+    // Extrusion paths in the order of the collections, with their role and width.
+    struct Paths : public ExtrusionVisitorRecursiveConst {
+        std::vector<std::tuple<ExtrusionRole, float, Points>> paths;
+        void use(const ExtrusionPath &path) override { paths.emplace_back(path.role(), path.width, path.polyline.get_points()); }
+    };
+    // Perimeter loops, gap fills and fill surfaces of all the layer regions of the object.
+    auto perimeter_results = [](const PrintObject &object) {
+        Paths loops, gap_fills;
+        std::vector<ExPolygons> fill_surfaces;
+        for (const Layer *layer : object.layers())
+            for (const LayerRegion *layerm : layer->regions()) {
+                layerm->perimeters.visit(loops);
+                layerm->thin_fills.visit(gap_fills);
+                fill_surfaces.emplace_back(to_expolygons(layerm->fill_surfaces.surfaces));
+            }
+        return std::make_tuple(loops.paths, gap_fills.paths, fill_surfaces);
+    };
+    GIVEN("Default config") {
+        WHEN("the plate is sliced by a single thread and by all the threads") {
+            Slic3r::Print print_serial, print;
+            {
+                tbb::global_control serial(tbb::global_control::max_allowed_parallelism, 1);
+                Slic3r::Test::init_and_process_print({ plate }, print_serial, { { "perimeters", 2 }, { "layer_height", 0.2 } });
+            }
+            Slic3r::Test::init_and_process_print({ plate }, print, { { "perimeters", 2 }, { "layer_height", 0.2 } });
+            const PrintObject &object = *print.objects().front();
+            THEN("each island has its own perimeter collection") {
+                const Layer       *layer  = object.layers().front();
+                const LayerRegion *layerm = layer->regions().front();
+                REQUIRE(layer->lslices.size() == 36);
+                REQUIRE(layerm->perimeters.entities().size() == 36);
+                std::vector<bool> island_used(layer->lslices.size(), false);
+                for (const ExtrusionEntity *island_perimeters : layerm->perimeters.entities()) {
+                    auto it = std::find_if(layer->lslices.begin(), layer->lslices.end(),
+                        [island_perimeters](const ExPolygon &island) { return island.contains(island_perimeters->first_point()); });
+                    REQUIRE(it != layer->lslices.end());
+                    REQUIRE(! island_used[it - layer->lslices.begin()]);
+                    island_used[it - layer->lslices.begin()] = true;
+                }
+            }
+            THEN("the perimeters don't depend on the scheduling of the islands") {
+                auto [loops, gap_fills, fill_surfaces] = perimeter_results(object);
+                auto [loops_serial, gap_fills_serial, fill_surfaces_serial] = perimeter_results(*print_serial.objects().front());
+                REQUIRE(! loops.empty());
+                REQUIRE(loops == loops_serial);
+                REQUIRE(gap_fills == gap_fills_serial);
+                REQUIRE(! fill_surfaces.front().empty());
+                REQUIRE(fill_surfaces == fill_surfaces_serial);
+            }
+        }
+    }
+}
+
 SCENARIO("Print: Skirt generation", "[Print]") {
     GIVEN("20mm cube and default config") {
         WHEN("Skirts is set to 2 loops")  {
@@ -102,6 +242,372 @@ SCENARIO("Print: Changing number of solid surfaces does not cause all surfaces t
     }
 }
 
+SCENARIO("Print: Identical objects share their layers", "[Print]") {
+    GIVEN("20mm cube, a copy of it and default config") {
+        Slic3r::DynamicPrintConfig config = Slic3r::DynamicPrintConfig::full_print_config();
+        config.set_deserialize_strict({
+            { "layer_height", 0.2 },
+            { "first_layer_height", 0.2 }
+        });
+        Slic3r::Print print;
+        Slic3r::Model model;
+        Slic3r::Test::init_print({TestMesh::cube_20x20x20}, print, model, config);
+        ModelObject *copy = model.add_object(*model.objects.front());
+        copy->instances.front()->set_offset(model.objects.front()->instances.front()->get_offset() + Vec3d(30., 0., 0.));
+        print.apply(model, config);
+        auto perimeters = [](const PrintObject &object) {
+            std::vector<PolylinesOrArcs> out;
+            for (const Layer *layer : object.layers())
+                out.emplace_back(layer->regions().front()->perimeters.as_polylines());
+            return out;
+        };
+        auto fills = [](const PrintObject &object) {
+            std::vector<PolylinesOrArcs> out;
+            for (const Layer *layer : object.layers())
+                out.emplace_back(layer->regions().front()->fills.as_polylines());
+            return out;
+        };
+        WHEN("the objects are processed") {
+            print.process();
+            REQUIRE(print.objects().size() == 2);
+            const PrintObject &leader   = *print.objects().front();
+            const PrintObject &follower = *print.objects().back();
+            THEN("both objects have the same slicing input") {
+                REQUIRE(leader.model_object() != follower.model_object());
+                REQUIRE(leader.slicing_fingerprint() == follower.slicing_fingerprint());
+                REQUIRE(leader.has_same_slicing_input(follower));
+                REQUIRE(follower.has_same_slicing_input(leader));
+            }
+            THEN("both objects have the same layers") {
+                REQUIRE(! leader.layers().empty());
+                REQUIRE(follower.layers().size() == leader.layers().size());
+                for (size_t i = 0; i < leader.layers().size(); ++ i) {
+                    REQUIRE(follower.layers()[i]->print_z == leader.layers()[i]->print_z);
+                    REQUIRE(follower.layers()[i]->regions().size() == leader.layers()[i]->regions().size());
+                }
+                REQUIRE(perimeters(follower) == perimeters(leader));
+                REQUIRE(fills(follower) == fills(leader));
+            }
+            THEN("the layers of the copy belong to the copy") {
+                for (const Layer *layer : follower.layers()) {
+                    REQUIRE(layer->object() == &follower);
+                    REQUIRE(&layer->regions().front()->region() == &follower.printing_region(0));
+                }
+            }
+        }
+        WHEN("the same mesh is loaded twice as separate objects") {
+            Slic3r::Print print_separate;
+            Slic3r::Model model_separate;
+            Slic3r::Test::init_print({TestMesh::cube_20x20x20, TestMesh::cube_20x20x20}, print_separate, model_separate, config);
+            print_separate.process();
+            REQUIRE(print_separate.objects().size() == 2);
+            const PrintObject &leader   = *print_separate.objects().front();
+            const PrintObject &follower = *print_separate.objects().back();
+            THEN("the objects don't share their meshes, but have the same slicing input") {
+                REQUIRE(&leader.model_object()->volumes.front()->mesh() != &follower.model_object()->volumes.front()->mesh());
+                REQUIRE(leader.slicing_fingerprint() == follower.slicing_fingerprint());
+                REQUIRE(leader.has_same_slicing_input(follower));
+                REQUIRE(follower.has_same_slicing_input(leader));
+            }
+            THEN("both objects have the same layers") {
+                REQUIRE(! leader.layers().empty());
+                REQUIRE(perimeters(follower) == perimeters(leader));
+                REQUIRE(fills(follower) == fills(leader));
+                for (const Layer *layer : follower.layers())
+                    REQUIRE(layer->object() == &follower);
+            }
+        }
+        WHEN("the copy has its own layer height") {
+            copy->config.set("layer_height", 0.1);
+            print.apply(model, config);
+            print.process();
+            THEN("the objects are processed separately") {
+                REQUIRE(! print.objects().front()->has_same_slicing_input(*print.objects().back()));
+                REQUIRE(print.objects().back()->layers().size() > print.objects().front()->layers().size());
+            }
+        }
+        WHEN("the copy has a modifier") {
+            ModelVolume *modifier = copy->add_volume(Slic3r::Test::mesh(TestMesh::cube_20x20x20), ModelVolumeType::PARAMETER_MODIFIER);
+            modifier->config.set("perimeters", 5);
+            print.apply(model, config);
+            print.process();
+            THEN("the objects are processed separately") {
+                REQUIRE(! print.objects().front()->has_same_slicing_input(*print.objects().back()));
+                REQUIRE(print.objects().back()->layers()[10]->regions().front()->perimeters.items_count() >
+                        print.objects().front()->layers()[10]->regions().front()->perimeters.items_count());
+            }
+        }
+    }
+}
+
+SCENARIO("Print: Different objects processed in parallel", "[Print]") {
+    GIVEN("four different objects and default config") {
+        Slic3r::DynamicPrintConfig config = Slic3r::DynamicPrintConfig::full_print_config();
+        config.set_deserialize_strict({
+            { "layer_height", 0.2 },
+            { "first_layer_height", 0.2 },
+            { "fill_density", "20%" }
+        });
+        const std::vector<TestMesh> meshes { TestMesh::cube_20x20x20, TestMesh::two_hollow_squares, TestMesh::pyramid, TestMesh::overhang };
+        auto perimeters = [](const PrintObject &object) {
+            std::vector<PolylinesOrArcs> out;
+            for (const Layer *layer : object.layers())
+                for (const LayerRegion *layerm : layer->regions())
+                    out.emplace_back(layerm->perimeters.as_polylines());
+            return out;
+        };
+        auto fills = [](const PrintObject &object) {
+            std::vector<PolylinesOrArcs> out;
+            for (const Layer *layer : object.layers())
+                for (const LayerRegion *layerm : layer->regions())
+                    out.emplace_back(layerm->fills.as_polylines());
+            return out;
+        };
+        // Each object printed alone.
+        std::vector<std::unique_ptr<Slic3r::Print>> prints_alone;
+        for (TestMesh mesh : meshes) {
+            prints_alone.emplace_back(std::make_unique<Slic3r::Print>());
+            Slic3r::Test::init_and_process_print({ mesh }, *prints_alone.back(), config);
+        }
+        Slic3r::Print print;
+        Slic3r::Model model;
+        Slic3r::Test::init_print({ meshes[0], meshes[1], meshes[2], meshes[3] }, print, model, config);
+        REQUIRE(print.objects().size() == meshes.size());
+        WHEN("the objects are processed together") {
+            print.process();
+            THEN("each object has the layers of the object printed alone") {
+                for (size_t i = 0; i < meshes.size(); ++ i) {
+                    const PrintObject &object = *print.objects()[i];
+                    const PrintObject &alone  = *prints_alone[i]->objects().front();
+                    REQUIRE(! object.has_same_slicing_input(*print.objects()[(i + 1) % meshes.size()]));
+                    REQUIRE(object.layers().size() == alone.layers().size());
+                    for (size_t j = 0; j < alone.layers().size(); ++ j) {
+                        REQUIRE(object.layers()[j]->print_z == alone.layers()[j]->print_z);
+                        REQUIRE(object.layers()[j]->lslices == alone.layers()[j]->lslices);
+                    }
+                    REQUIRE(perimeters(object) == perimeters(alone));
+                    REQUIRE(fills(object) == fills(alone));
+                }
+            }
+        }
+        WHEN("the processing is canceled while the objects are filled") {
+            print.set_status_callback([&print](const PrintBase::SlicingStatus &status) {
+                if ((status.flags & PrintBase::SlicingStatus::MAIN_STATE) != 0 && status.percent == 35)
+                    print.cancel();
+            });
+            REQUIRE_THROWS_AS(print.process(), CanceledException);
+            THEN("no step is done with missing or partial data") {
+                static constexpr const PrintObjectStep steps[] = { posSlice, posPerimeters, posPrepareInfill, posInfill, posIroning };
+                size_t num_not_done = 0;
+                for (size_t i = 0; i < meshes.size(); ++ i) {
+                    const PrintObject &object = *print.objects()[i];
+                    const PrintObject &alone  = *prints_alone[i]->objects().front();
+                    // The steps are executed in order, a done step follows done steps.
+                    for (size_t k = 1; k < std::size(steps); ++ k)
+                        if (object.is_step_done(steps[k]))
+                            REQUIRE(object.is_step_done(steps[k - 1]));
+                    if (object.is_step_done(posPerimeters))
+                        REQUIRE(perimeters(object) == perimeters(alone));
+                    if (object.is_step_done(posInfill))
+                        REQUIRE(fills(object) == fills(alone));
+                    for (PrintObjectStep step : steps)
+                        num_not_done += ! object.is_step_done(step);
+                }
+                REQUIRE(num_not_done > 0);
+            }
+            THEN("processing again completes the steps left started") {
+                print.set_status_silent();
+                print.restart();
+                print.process();
+                for (size_t i = 0; i < meshes.size(); ++ i) {
+                    const PrintObject &object = *print.objects()[i];
+                    const PrintObject &alone  = *prints_alone[i]->objects().front();
+                    REQUIRE(object.is_step_done(posInfill));
+                    REQUIRE(object.is_step_done(posIroning));
+                    REQUIRE(perimeters(object) == perimeters(alone));
+                    REQUIRE(fills(object) == fills(alone));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Print: Editing the layer height profile", "[Print]") {
+    GIVEN("20mm cube with a variable layer height") {
+        Slic3r::DynamicPrintConfig config = Slic3r::DynamicPrintConfig::full_print_config();
+        config.set_deserialize_strict({
+            { "layer_height",       0.2 },
+            { "first_layer_height", 0.2 }
+        });
+        Slic3r::Print print;
+        Slic3r::Model model;
+        Slic3r::Test::init_print({TestMesh::cube_20x20x20}, print, model, config);
+        model.objects.front()->layer_height_profile.set({ 0., 0.2, 20., 0.2 });
+        print.apply(model, config);
+        print.process();
+        const PrintObject *object = print.objects().front();
+        std::vector<ExPolygons> lower_half;
+        for (const Layer *layer : object->layers())
+            if (layer->print_z < 10. - EPSILON)
+                lower_half.emplace_back(layer->lslices);
+        WHEN("the layer height of the upper half is changed") {
+            model.objects.front()->layer_height_profile.set({ 0., 0.2, 10., 0.2, 10., 0.1, 20., 0.1 });
+            print.apply(model, config);
+            print.process();
+            THEN("the PrintObject is kept") {
+                REQUIRE(print.objects().front() == object);
+            }
+            THEN("the slices of the lower half are kept") {
+                REQUIRE(lower_half.size() >= 45);
+                REQUIRE(object->layers().size() > lower_half.size());
+                for (size_t i = 0; i < lower_half.size(); ++ i)
+                    REQUIRE(object->layers()[i]->lslices == lower_half[i]);
+            }
+            THEN("the layers match the layers of a fresh slicing") {
+                Slic3r::Print print_fresh;
+                Slic3r::Model model_fresh;
+                Slic3r::Test::init_print({TestMesh::cube_20x20x20}, print_fresh, model_fresh, config);
+                model_fresh.objects.front()->layer_height_profile.set({ 0., 0.2, 10., 0.2, 10., 0.1, 20., 0.1 });
+                print_fresh.apply(model_fresh, config);
+                print_fresh.process();
+                const PrintObject &fresh = *print_fresh.objects().front();
+                REQUIRE(object->layers().size() == fresh.layers().size());
+                for (size_t i = 0; i < fresh.layers().size(); ++ i) {
+                    REQUIRE(object->layers()[i]->print_z == Approx(fresh.layers()[i]->print_z));
+                    REQUIRE(area(object->layers()[i]->lslices) == Approx(area(fresh.layers()[i]->lslices)));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("PrintObject: Layers with the same slices", "[PrintObject]") {
+    GIVEN("20mm cube") {
+        auto fill_polylines = [](const Layer &layer) { return layer.regions().front()->fills.as_polylines(); };
+        auto fill_flows = [](const Layer &layer) {
+            std::vector<std::tuple<ExtrusionRole, float, float, double>> flows;
+            ExtrusionEntityCollection fills = layer.regions().front()->fills.flatten();
+            for (const ExtrusionEntity *entity : fills.entities())
+                if (const ExtrusionPath *path = dynamic_cast<const ExtrusionPath*>(entity))
+                    flows.emplace_back(path->role(), path->width, path->height, path->mm3_per_mm);
+            return flows;
+        };
+        WHEN("the sparse infill is rectilinear") {
+            Slic3r::Print print;
+            Slic3r::Test::init_and_process_print({TestMesh::cube_20x20x20}, print, {
+                { "fill_pattern", "rectilinear" },
+                { "fill_density", "20%" },
+                { "layer_height", 0.2 },
+                { "first_layer_height", 0.2 }
+            });
+            const PrintObject &object = *print.objects().front();
+            THEN("the perimeters of the layers with the same slices are the same") {
+                for (size_t i = 10; i + 10 < object.layers().size(); ++ i)
+                    REQUIRE(object.layers()[i]->regions().front()->perimeters.as_polylines() == object.layers()[i - 2]->regions().front()->perimeters.as_polylines());
+            }
+            THEN("the perimeters of the layers in the middle are the same") {
+                REQUIRE(object.layers()[50]->regions().front()->perimeters.as_polylines() == object.layers()[52]->regions().front()->perimeters.as_polylines());
+                REQUIRE(object.layers()[50]->regions().front()->perimeters.items_count() == object.layers()[51]->regions().front()->perimeters.items_count());
+            }
+            THEN("the infill direction still alternates") {
+                REQUIRE(fill_polylines(*object.layers()[50]) == fill_polylines(*object.layers()[52]));
+                REQUIRE(fill_polylines(*object.layers()[50]) != fill_polylines(*object.layers()[51]));
+            }
+            THEN("the fills of the layers in the middle are reused a fill period above") {
+                REQUIRE(! fill_flows(*object.layers()[50]).empty());
+                REQUIRE(fill_flows(*object.layers()[50]) == fill_flows(*object.layers()[52]));
+                REQUIRE(object.layers()[50]->regions().front()->fills.items_count() == object.layers()[52]->regions().front()->fills.items_count());
+            }
+        }
+        WHEN("the first layer is extruded wider and has no solid infill") {
+            Slic3r::Print print;
+            Slic3r::Test::init_and_process_print({TestMesh::cube_20x20x20}, print, {
+                { "fill_pattern", "rectilinear" },
+                { "fill_density", "20%" },
+                { "bottom_solid_layers", 0 },
+                { "layer_height", 0.2 },
+                { "first_layer_height", 0.2 },
+                { "first_layer_extrusion_width", 0.8 }
+            });
+            const PrintObject &object = *print.objects().front();
+            THEN("the fills of the first layer are not reused") {
+                REQUIRE(! fill_flows(*object.layers()[2]).empty());
+                REQUIRE(fill_flows(*object.layers()[2]) != fill_flows(*object.layers()[0]));
+                REQUIRE(fill_flows(*object.layers()[2]) == fill_flows(*object.layers()[4]));
+            }
+        }
+        WHEN("the sparse infill is gyroid") {
+            Slic3r::Print print;
+            Slic3r::Test::init_and_process_print({TestMesh::cube_20x20x20}, print, {
+                { "fill_pattern", "gyroid" },
+                { "fill_density", "20%" },
+                { "layer_height", 0.2 },
+                { "first_layer_height", 0.2 }
+            });
+            const PrintObject &object = *print.objects().front();
+            THEN("the infill changes with Z") {
+                REQUIRE(fill_polylines(*object.layers()[50]) != fill_polylines(*object.layers()[52]));
+            }
+        }
+        WHEN("the external perimeters have a fuzzy skin") {
+            Slic3r::Print print;
+            Slic3r::Test::init_and_process_print({TestMesh::cube_20x20x20}, print, {
+                { "fuzzy_skin", "external" },
+                { "layer_height", 0.2 },
+                { "first_layer_height", 0.2 }
+            });
+            THEN("the perimeters are generated for each layer") {
+                const PrintObject &object = *print.objects().front();
+                REQUIRE(object.layers()[50]->regions().front()->perimeters.as_polylines() != object.layers()[52]->regions().front()->perimeters.as_polylines());
+            }
+        }
+    }
+}
+
+SCENARIO("PrintObject: Changing an ironing setting", "[PrintObject]") {
+    GIVEN("20mm cube with ironed top surfaces") {
+        Slic3r::DynamicPrintConfig config = Slic3r::DynamicPrintConfig::full_print_config();
+        config.set_deserialize_strict({
+            { "ironing",            true },
+            { "ironing_type",       "top" },
+            { "ironing_spacing",    0.1 },
+            { "layer_height",       0.2 },
+            { "first_layer_height", 0.2 }
+        });
+        Slic3r::Print print;
+        Slic3r::Model model;
+        Slic3r::Test::init_print({TestMesh::cube_20x20x20}, print, model, config);
+        print.process();
+        const PrintObject &object = *print.objects().front();
+        auto top_ironing = [](const PrintObject &object) { return object.layers().back()->regions().front()->ironings.as_polylines(); };
+        auto top_fills   = [](const PrintObject &object) { return object.layers().back()->regions().front()->fills.as_polylines(); };
+        const PolylinesOrArcs           ironing_before  = top_ironing(object);
+        const PolylinesOrArcs           fills_before    = top_fills(object);
+        const PrintStateBase::TimeStamp fills_timestamp = object.step_state_with_timestamp(posInfill).timestamp;
+        WHEN("the ironing spacing is changed") {
+            config.set_deserialize_strict({ { "ironing_spacing", 0.2 } });
+            print.apply(model, config);
+            print.process();
+            THEN("the fills are kept") {
+                REQUIRE(object.step_state_with_timestamp(posInfill).timestamp == fills_timestamp);
+                REQUIRE(top_fills(object) == fills_before);
+            }
+            THEN("the top surfaces are ironed again") {
+                REQUIRE(! ironing_before.empty());
+                REQUIRE(object.is_step_done(posIroning));
+                REQUIRE(top_ironing(object) != ironing_before);
+            }
+            THEN("the ironing matches the ironing of a fresh print") {
+                Slic3r::Print print_fresh;
+                Slic3r::Model model_fresh;
+                Slic3r::Test::init_print({TestMesh::cube_20x20x20}, print_fresh, model_fresh, config);
+                print_fresh.process();
+                REQUIRE(top_ironing(object) == top_ironing(*print_fresh.objects().front()));
+            }
+        }
+    }
+}
+
 SCENARIO("Print: Brim generation", "[Print]") {
     GIVEN("20mm cube and default config, 1mm first layer width") {
         WHEN("Brim is set to 3mm")  {
@@ -2,11 +2,23 @@
 
 #include "libslic3r/libslic3r.h"
 #include "libslic3r/GCodeReader.hpp"
+#include "libslic3r/GCode/GCodeProcessor.hpp"
+#include "libslic3r/GCode/SpiralVase.hpp"
+#include "libslic3r/LocalesUtils.hpp"
+#include "libslic3r/Layer.hpp"
 
 #include "test_data.hpp"
 
 #include <algorithm>
+#include <cctype>
+#include <functional>
+#include <sstream>
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/regex.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/nowide/cstdio.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <tbb/global_control.h>
 
 using namespace Slic3r;
 using namespace Slic3r::Test;
@@ -15,6 +27,16 @@ boost::regex perimeters_regex("G1 X[-0-9.]* Y[-0-9.]* E[-0-9.]* ; perimeter");
 boost::regex infill_regex("G1 X[-0-9.]* Y[-0-9.]* E[-0-9.]* ; infill");
 boost::regex skirt_regex("G1 X[-0-9.]* Y[-0-9.]* E[-0-9.]* ; skirt");
 
+// Drops the first line containing each of the texts, by default the header line with the timestamp,
+// so that the G-code of two runs may be compared.
+static std::string strip_header(std::string gcode, std::initializer_list<const char*> lines = { "generated by" })
+{
+    for (const char *line : lines)
+        if (size_t pos = gcode.find(line); pos != std::string::npos)
+            gcode.erase(pos, gcode.find('\n', pos) - pos);
+    return gcode;
+}
+
 SCENARIO( "PrintGCode basic functionality", "[PrintGCode]") {
     GIVEN("A default configuration and a print test object") {
         WHEN("the output is executed with no support material") {
@@ -269,3 +291,477 @@ SCENARIO( "PrintGCode basic functionality", "[PrintGCode]") {
         }
     }
 }
+
+SCENARIO( "PrintGCode layers prepared in parallel", "[PrintGCode]") {
+    auto slice_serial = [](std::initializer_list<TestMesh> meshes, const DynamicPrintConfig &config) {
+        tbb::global_control serial(tbb::global_control::max_allowed_parallelism, 1);
+        return strip_header(Slic3r::Test::slice(meshes, config, true));
+    };
+    GIVEN("The test models") {
+        for (TestMesh mesh : { TestMesh::cube_20x20x20, TestMesh::overhang, TestMesh::bridge, TestMesh::ipadstand, TestMesh::two_hollow_squares }) {
+            DynamicPrintConfig config = Slic3r::DynamicPrintConfig::full_print_config();
+            config.set_deserialize_strict({ { "support_material", mesh == TestMesh::overhang }, { "skirts", 1 } });
+            WHEN(std::string("slicing ") + mesh_names.at(mesh)) {
+                THEN("the G-code is byte identical to the one produced by a single thread") {
+                    REQUIRE(strip_header(Slic3r::Test::slice({ mesh }, config, true)) == slice_serial({ mesh }, config));
+                }
+            }
+        }
+        WHEN("printing the perimeters and the infill of two objects with two extruders") {
+            DynamicPrintConfig config = Slic3r::DynamicPrintConfig::full_print_config();
+            config.set_num_extruders(2);
+            config.set_deserialize_strict({ { "perimeter_extruder", 1 }, { "infill_extruder", 2 }, { "solid_infill_extruder", 2 }, { "skirts", 0 } });
+            const std::string gcode = strip_header(Slic3r::Test::slice({ TestMesh::A, TestMesh::V }, config, true));
+            const std::string layer_change = ";" + GCodeProcessor::reserved_tag(GCodeProcessor::ETags::Layer_Change);
+            // Active extruder, extruders activated in the current layer and number of layers.
+            int              extruder = 0;
+            std::vector<int> layer_extruders;
+            size_t           num_layers         = 0;
+            size_t           num_toolchanges    = 0;
+            size_t           num_wrong_extruder = 0;
+            size_t           num_reactivated    = 0;
+            std::istringstream is(gcode);
+            for (std::string line; std::getline(is, line);) {
+                if (line == layer_change) {
+                    ++ num_layers;
+                    layer_extruders.assign(1, extruder);
+                } else if (line.size() > 1 && line.front() == 'T' && std::isdigit(line[1])) {
+                    extruder = std::atoi(line.c_str() + 1);
+                    if (num_layers > 0) {
+                        ++ num_toolchanges;
+                        if (std::find(layer_extruders.begin(), layer_extruders.end(), extruder) != layer_extruders.end())
+                            ++ num_reactivated;
+                        layer_extruders.emplace_back(extruder);
+                    }
+                } else if (boost::starts_with(line, ";TYPE:")) {
+                    if (boost::icontains(line, "perimeter") && extruder != 0)
+                        ++ num_wrong_extruder;
+                    else if (boost::icontains(line, "infill") && extruder != 1)
+                        ++ num_wrong_extruder;
+                }
+            }
+            THEN("the G-code is byte identical to the one produced by a single thread") {
+                REQUIRE(gcode == slice_serial({ TestMesh::A, TestMesh::V }, config));
+            }
+            THEN("the perimeters and the infill are printed with their extruders") {
+                REQUIRE(num_layers > 10);
+                REQUIRE(num_wrong_extruder == 0);
+            }
+            THEN("each layer switches extruders once, starting with the extruder of the layer below") {
+                REQUIRE(num_toolchanges > 0);
+                REQUIRE(num_toolchanges <= num_layers);
+                REQUIRE(num_reactivated == 0);
+            }
+        }
+        WHEN("printing two objects, one by one or layer by layer") {
+            // Z of each layer and the ids of the objects printed at that layer, in the order of the G-code.
+            auto layers_of = [](const std::string &gcode) {
+                std::vector<std::pair<double, std::vector<int>>> layers;
+                std::istringstream is(gcode);
+                for (std::string line; std::getline(is, line);)
+                    if (boost::starts_with(line, ";LAYER_Z:"))
+                        layers.push_back({ std::stod(line.substr(9)), {} });
+                    else if (boost::starts_with(line, "; printing object ") && ! layers.empty())
+                        layers.back().second.push_back(std::atoi(line.c_str() + line.rfind(" id:") + 4));
+                return layers;
+            };
+            for (bool complete_objects : { false, true }) {
+                DynamicPrintConfig config = Slic3r::DynamicPrintConfig::full_print_config();
+                config.set_deserialize_strict({ { "complete_objects", complete_objects }, { "extruder_clearance_radius", 1 },
+                    { "gcode_label_objects", true }, { "layer_gcode", ";LAYER_Z:[layer_z]" } });
+                const std::string gcode = strip_header(Slic3r::Test::slice({ TestMesh::A, TestMesh::V }, config, true));
+                REQUIRE(gcode == slice_serial({ TestMesh::A, TestMesh::V }, config));
+
+                const std::vector<std::pair<double, std::vector<int>>> layers = layers_of(gcode);
+                REQUIRE(layers.size() > 10);
+                // Number of times the Z goes down, which happens only when starting the next object.
+                size_t num_z_resets = 0;
+                for (size_t i = 1; i < layers.size(); ++ i)
+                    if (layers[i].first < layers[i - 1].first + EPSILON)
+                        ++ num_z_resets;
+                if (complete_objects) {
+                    // One object after the other: each layer prints a single object, the object changes with the Z reset.
+                    REQUIRE(num_z_resets == 1);
+                    std::vector<int> objects;
+                    for (const auto &layer : layers) {
+                        REQUIRE(layer.second.size() == 1);
+                        if (objects.empty() || objects.back() != layer.second.front())
+                            objects.emplace_back(layer.second.front());
+                    }
+                    REQUIRE(objects.size() == 2);
+                } else {
+                    // Layer by layer: Z increases and each layer prints the objects once, in the order of the first layer.
+                    REQUIRE(num_z_resets == 0);
+                    const std::vector<int> &order = layers.front().second;
+                    REQUIRE(order.size() == 2);
+                    REQUIRE(order.front() != order.back());
+                    for (const auto &layer : layers) {
+                        REQUIRE(! layer.second.empty());
+                        std::vector<size_t> positions;
+                        for (int object_id : layer.second)
+                            positions.emplace_back(std::find(order.begin(), order.end(), object_id) - order.begin());
+                        REQUIRE(std::adjacent_find(positions.begin(), positions.end(), std::greater_equal<size_t>()) == positions.end());
+                        REQUIRE(positions.back() < order.size());
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO( "GCodeReader parsed lines", "[PrintGCode]") {
+    GIVEN("The G-code of a spiral vase") {
+        Slic3r::Print print;
+        Slic3r::Model model;
+        Slic3r::Test::init_print({TestMesh::cube_20x20x20}, print, model, {
+            { "spiral_vase",        true },
+            { "perimeters",         1 },
+            { "top_solid_layers",   0 },
+            { "fill_density",       0 },
+            { "layer_height",       0.4 },
+            { "first_layer_height", 0.4 }
+            });
+        std::string gcode = Slic3r::Test::gcode(print);
+        auto record = [](std::vector<std::pair<std::string, std::array<float, 4>>> &out) {
+            return [&out](GCodeReader &self, const GCodeReader::GCodeLine &line) { out.push_back({ std::string(line.raw_view()), std::array<float, 4>{ self.x(), self.y(), self.z(), self.e() } }); };
+        };
+        WHEN("the lines are parsed once and visited") {
+            std::vector<std::pair<std::string, std::array<float, 4>>> parsed, visited;
+            GCodeReader reader_parse;
+            reader_parse.apply_config(print.config());
+            reader_parse.parse_buffer(gcode, record(parsed));
+            GCodeReader reader_visit;
+            reader_visit.apply_config(print.config());
+            GCodeReader::ParsedLines lines;
+            reader_visit.parse_buffer(gcode, lines);
+            reader_visit.visit_lines(lines, record(visited));
+            THEN("the callback sees the same lines and positions as when parsing the text") {
+                REQUIRE(parsed == visited);
+                REQUIRE(reader_visit.z() == Approx(reader_parse.z()));
+            }
+            THEN("the parsed lines reference the text of the buffer") {
+                REQUIRE(! lines.empty());
+                for (const GCodeReader::ParsedLine &line : lines)
+                    REQUIRE((line.gline.raw_view().data() >= gcode.data() && line.gline.raw_view().data() < gcode.data() + gcode.size()));
+            }
+        }
+    }
+}
+
+SCENARIO( "PrintGCode remaining times", "[PrintGCode]") {
+    GIVEN("A cube with the remaining times enabled") {
+        DynamicPrintConfig config = Slic3r::DynamicPrintConfig::full_print_config();
+        config.set_deserialize_strict({ { "gcode_flavor", "marlin2" }, { "remaining_times", true }, { "remaining_times_type", "m73" } });
+        WHEN("the G-code is exported") {
+            const std::string gcode = Slic3r::Test::slice({ TestMesh::cube_20x20x20 }, config);
+            THEN("the placeholders are replaced by the remaining times") {
+                REQUIRE(gcode.find("_GP_") == std::string::npos);
+                REQUIRE(gcode.find("M73 P0 R") != std::string::npos);
+                REQUIRE(gcode.find("M73 P100 R0") != std::string::npos);
+                REQUIRE(gcode.find("; estimated printing time (normal mode) = ") != std::string::npos);
+            }
+        }
+    }
+    GIVEN("A cube of thin layers with the remaining times enabled") {
+        DynamicPrintConfig config = Slic3r::DynamicPrintConfig::full_print_config();
+        config.set_deserialize_strict({ { "gcode_flavor", "marlin2" }, { "remaining_times", true }, { "remaining_times_type", "m73" },
+            { "layer_height", 0.05 }, { "first_layer_height", 0.2 }, { "gcode_comments", true } });
+        // Drop the header line with the timestamp and the line of the config block with the option being tested.
+        auto strip = [](const std::string &gcode) { return strip_header(gcode, { "generated by", "; gcode_memory_max_size = " }); };
+        const std::string gcode_in_memory = strip(Slic3r::Test::slice({ TestMesh::cube_20x20x20 }, config, true));
+        WHEN("the G-code is written to the temp file from the start") {
+            config.set_deserialize_strict({ { "gcode_memory_max_size", 0 } });
+            THEN("the G-code is byte identical to the one kept in memory") {
+                REQUIRE(strip(Slic3r::Test::slice({ TestMesh::cube_20x20x20 }, config, true)) == gcode_in_memory);
+            }
+        }
+        WHEN("the G-code grows above the memory limit and is spilled to the temp file") {
+            config.set_deserialize_strict({ { "gcode_memory_max_size", 1 } });
+            THEN("the G-code is byte identical to the one kept in memory") {
+                REQUIRE(gcode_in_memory.size() > (size_t(1) << 20));
+                REQUIRE(strip(Slic3r::Test::slice({ TestMesh::cube_20x20x20 }, config, true)) == gcode_in_memory);
+            }
+        }
+    }
+}
+
+SCENARIO( "PrintGCode background output", "[PrintGCode]") {
+    // Drop the header line with the timestamp and the line of the config block with the option being tested.
+    auto strip = [](const std::string &gcode) { return strip_header(gcode, { "generated by", "; gcode_async_output = " }); };
+    GIVEN("Two objects with the remaining times enabled") {
+        DynamicPrintConfig config = Slic3r::DynamicPrintConfig::full_print_config();
+        config.set_deserialize_strict({ { "gcode_flavor", "marlin2" }, { "remaining_times", true }, { "skirts", 1 } });
+        const std::string gcode_sync = strip(Slic3r::Test::slice({ TestMesh::A, TestMesh::V }, config, true));
+        WHEN("the G-code is written and processed by background threads") {
+            config.set_deserialize_strict({ { "gcode_async_output", true } });
+            THEN("the G-code is byte identical") {
+                REQUIRE(strip(Slic3r::Test::slice({ TestMesh::A, TestMesh::V }, config, true)) == gcode_sync);
+            }
+        }
+    }
+}
+
+SCENARIO( "PrintGCode low memory mode", "[PrintGCode]") {
+    GIVEN("Two objects with supports") {
+        DynamicPrintConfig config = Slic3r::DynamicPrintConfig::full_print_config();
+        config.set_deserialize_strict({ { "support_material", true }, { "skirts", 1 } });
+        Slic3r::Print print;
+        Slic3r::Model model;
+        Slic3r::Test::init_print({ TestMesh::overhang, TestMesh::cube_20x20x20 }, print, model, config);
+        const std::string gcode = strip_header(Slic3r::Test::gcode(print));
+        WHEN("the layers are released while exporting") {
+            Slic3r::Print print_low_memory;
+            Slic3r::Model model_low_memory;
+            Slic3r::Test::init_print({ TestMesh::overhang, TestMesh::cube_20x20x20 }, print_low_memory, model_low_memory, config);
+            print_low_memory.set_low_memory(true);
+            const std::string gcode_low_memory = strip_header(Slic3r::Test::gcode(print_low_memory));
+            THEN("the G-code is byte identical") {
+                REQUIRE(gcode_low_memory == gcode);
+            }
+            THEN("the layers below the top layers are released") {
+                const PrintObject &object = *print_low_memory.objects().back();
+                REQUIRE(object.layers().front()->lslices.empty());
+                REQUIRE(object.layers().front()->regions().front()->perimeters.empty());
+                REQUIRE(! object.layers().back()->lslices.empty());
+            }
+            THEN("changing a step of the objects slices them again") {
+                config.set_deserialize_strict({ { "perimeters", 2 } });
+                print_low_memory.apply(model_low_memory, config);
+                REQUIRE(! print_low_memory.objects().back()->is_step_done(posSlice));
+            }
+        }
+    }
+}
+
+SCENARIO( "GCodeReader memory mapped file", "[GCodeReader]") {
+    GIVEN("G-code with empty lines, carriage returns and without a trailing newline") {
+        const std::string gcode = "G1 X1 Y2 E0.5 ; move\r\n\nG92 E0\r\r\n;TYPE:Perimeter\nG1 Z0.3 F600\nM107";
+        boost::filesystem::path temp = boost::filesystem::unique_path();
+        {
+            boost::nowide::ofstream file(temp.string(), std::ios::binary);
+            file << gcode;
+        }
+        WHEN("the file is parsed") {
+            std::vector<std::string> lines_buffer, lines_file;
+            std::vector<float>       positions_buffer, positions_file;
+            std::vector<size_t>      lines_ends;
+            GCodeReader reader;
+            reader.parse_buffer(gcode, [&](GCodeReader &reader, const GCodeReader::GCodeLine &line) {
+                lines_buffer.emplace_back(line.raw());
+                positions_buffer.emplace_back(reader.x() + reader.z() + reader.f());
+            });
+            reader.reset();
+            bool ok = reader.parse_file(temp.string(), [&](GCodeReader &reader, const GCodeReader::GCodeLine &line) {
+                lines_file.emplace_back(line.raw_view());
+                positions_file.emplace_back(reader.x() + reader.z() + reader.f());
+            }, lines_ends);
+            boost::nowide::remove(temp.string().c_str());
+            THEN("the lines and the positions match the parsed buffer") {
+                REQUIRE(ok);
+                REQUIRE(lines_file == lines_buffer);
+                REQUIRE(positions_file == positions_buffer);
+                REQUIRE(lines_ends == std::vector<size_t>{ 22, 23, 32, 48, 61 });
+            }
+        }
+    }
+    GIVEN("G-code with carriage return line endings only, followed by a newline") {
+        std::string gcode;
+        for (int i = 0; i < 10000; ++ i)
+            gcode += "G1 X" + std::to_string(i) + " Y2 E0.5\r";
+        gcode += "M107\n";
+        boost::filesystem::path temp = boost::filesystem::unique_path();
+        {
+            boost::nowide::ofstream file(temp.string(), std::ios::binary);
+            file << gcode;
+        }
+        WHEN("the file is parsed") {
+            std::vector<std::string> lines_file;
+            std::vector<size_t>      lines_ends;
+            GCodeReader reader;
+            bool ok = reader.parse_file(temp.string(), [&](GCodeReader &reader, const GCodeReader::GCodeLine &line) {
+                lines_file.emplace_back(line.raw_view());
+            }, lines_ends);
+            boost::nowide::remove(temp.string().c_str());
+            THEN("each carriage return ends a line") {
+                REQUIRE(ok);
+                REQUIRE(lines_file.size() == 10001);
+                REQUIRE(lines_file[9999] == "G1 X9999 Y2 E0.5");
+                REQUIRE(lines_file.back() == "M107");
+                REQUIRE(lines_ends == std::vector<size_t>{ gcode.size() });
+            }
+        }
+    }
+}
+
+SCENARIO( "GCodeReader values and raw lines", "[GCodeReader]") {
+    GIVEN("Hand written G-code with signed values and lines of the same length") {
+        const std::string gcode = "G1 X+1.5 Y-2 ; move\nM104 S+200\nG1 X1\nG1 Y2\n";
+        std::vector<std::string> raw;
+        std::vector<float>       values;
+        GCodeReader reader;
+        reader.parse_buffer(gcode, [&raw, &values](GCodeReader &, const GCodeReader::GCodeLine &line) {
+            raw.emplace_back(line.raw());
+            float value;
+            for (char axis : { 'X', 'Y', 'S' })
+                if (line.has_value(axis, value))
+                    values.emplace_back(value);
+        });
+        THEN("the values with a leading plus sign are parsed") {
+            REQUIRE(values == std::vector<float>{ 1.5f, -2.f, 200.f, 1.f, 2.f });
+        }
+        THEN("each raw line is the text of its own line") {
+            REQUIRE(raw == std::vector<std::string>{ "G1 X+1.5 Y-2 ; move", "M104 S+200", "G1 X1", "G1 Y2" });
+        }
+    }
+}
+
+SCENARIO( "GCodeReader parallel file parsing", "[GCodeReader]") {
+    GIVEN("G-code split into several chunks, without a trailing newline") {
+        std::string gcode;
+        for (int i = 0; i < 100000; ++ i) {
+            gcode += "G1 X" + std::to_string(i % 300) + " Y2 E0.5 ; move\r\n";
+            if (i % 7 == 0)
+                gcode += "\n";
+            if (i % 11 == 0)
+                gcode += "G92 E0\r\r\n";
+        }
+        gcode += "M107";
+        boost::filesystem::path temp = boost::filesystem::unique_path();
+        {
+            boost::nowide::ofstream file(temp.string(), std::ios::binary);
+            file << gcode;
+        }
+        WHEN("the file is parsed serially and in parallel") {
+            std::vector<std::string> lines_serial, lines_parallel;
+            std::vector<float>       positions_serial, positions_parallel;
+            std::vector<size_t>      lines_ends_serial, lines_ends_parallel;
+            GCodeReader reader;
+            reader.parse_file(temp.string(), [&](GCodeReader &reader, const GCodeReader::GCodeLine &line) {
+                lines_serial.emplace_back(line.raw_view());
+                positions_serial.emplace_back(reader.x() + line.x());
+            }, lines_ends_serial);
+            reader.reset();
+            bool ok = reader.parse_file_parallel(temp.string(), [&](GCodeReader &reader, const GCodeReader::GCodeLine &line) {
+                lines_parallel.emplace_back(line.raw_view());
+                positions_parallel.emplace_back(reader.x() + line.x());
+            }, lines_ends_parallel);
+            boost::nowide::remove(temp.string().c_str());
+            THEN("the lines, the positions and the line ends are the same") {
+                REQUIRE(ok);
+                REQUIRE(lines_parallel == lines_serial);
+                REQUIRE(positions_parallel == positions_serial);
+                REQUIRE(lines_ends_parallel == lines_ends_serial);
+            }
+        }
+    }
+}
+
+SCENARIO( "SpiralVase output", "[PrintGCode]") {
+    GIVEN("The layers of a single perimeter cube without top layers") {
+        Slic3r::Print print;
+        Slic3r::Model model;
+        Slic3r::Test::init_print({TestMesh::cube_20x20x20}, print, model, {
+            { "perimeters",         1 },
+            { "top_solid_layers",   0 },
+            { "bottom_solid_layers", 3 },
+            { "fill_density",       0 },
+            { "layer_height",       0.4 },
+            { "first_layer_height", 0.4 },
+            { "use_relative_e_distances", true },
+            { "gcode_comments",     true }
+            });
+        const std::string gcode = Slic3r::Test::gcode(print);
+        // Split the G-code before each Z move, so that each layer starts with its Z move as produced by process_layer().
+        std::vector<std::string> layers(1);
+        std::istringstream       stream(gcode);
+        // Index of the last layer with infill, the spiral starts above it.
+        size_t                   last_infill_layer = 0;
+        for (std::string line; std::getline(stream, line);) {
+            if (boost::starts_with(line, "G1 Z") && ! layers.back().empty())
+                layers.emplace_back();
+            layers.back() += line + '\n';
+            if (boost::starts_with(line, ";TYPE:") && boost::icontains(line, "infill"))
+                last_infill_layer = layers.size() - 1;
+        }
+        const size_t first_spiral_layer = last_infill_layer + 1;
+        // Relative extrusions of the G1 moves extruding in XY.
+        auto extrusions = [&print](const std::string &gcode) {
+            std::vector<float> out;
+            GCodeReader reader;
+            reader.apply_config(print.config());
+            reader.parse_buffer(gcode, [&out](GCodeReader &reader, const GCodeReader::GCodeLine &line) {
+                if (line.extruding(reader) && line.dist_XY(reader) > 0)
+                    out.emplace_back(line.e());
+            });
+            return out;
+        };
+        WHEN("the layers above the bottom layers are processed by SpiralVase") {
+            SpiralVase spiral_vase(print.config());
+            std::vector<std::string> out;
+            for (size_t i = 0; i < layers.size(); ++ i) {
+                // The start G-code and the bottom layers are passed through.
+                spiral_vase.enable(i >= first_spiral_layer);
+                out.emplace_back(spiral_vase.process_layer(layers[i]));
+            }
+            std::string spiral;
+            for (size_t i = first_spiral_layer; i < out.size(); ++ i)
+                spiral += out[i];
+            THEN("the layers below the spiral are not modified") {
+                REQUIRE(first_spiral_layer > 1);
+                REQUIRE(layers.size() > first_spiral_layer + 40);
+                for (size_t i = 0; i < first_spiral_layer; ++ i)
+                    REQUIRE(out[i] == layers[i]);
+                REQUIRE(out[first_spiral_layer].find("; Began spiral") != std::string::npos);
+            }
+            THEN("Z only rises while extruding, by less than a layer at a time, up to the top of the object") {
+                GCodeReader reader;
+                reader.apply_config(print.config());
+                // Start at the top of the last layer before the spiral.
+                for (size_t i = 0; i < first_spiral_layer; ++ i)
+                    reader.parse_buffer(layers[i]);
+                // The Z values are rounded to the G-code precision.
+                const float tolerance = 1e-3f;
+                float  z_start             = reader.z();
+                float  max_step            = 0.f;
+                size_t num_z_only_moves_up = 0;
+                size_t num_z_down          = 0;
+                reader.parse_buffer(spiral, [&](GCodeReader &reader, const GCodeReader::GCodeLine &line) {
+                    if (! line.cmd_is("G1") || ! line.has(Z))
+                        return;
+                    float dz = line.dist_Z(reader);
+                    if (dz < - tolerance)
+                        ++ num_z_down;
+                    else if (line.extruding(reader) && line.dist_XY(reader) > 0)
+                        max_step = std::max(max_step, dz);
+                    else if (dz > tolerance)
+                        ++ num_z_only_moves_up;
+                });
+                REQUIRE(num_z_down == 0);
+                REQUIRE(num_z_only_moves_up == 0);
+                REQUIRE(max_step > 0.f);
+                REQUIRE(max_step < 0.4f - tolerance);
+                REQUIRE(reader.z() > z_start + 10.f);
+                REQUIRE(reader.z() == Approx(20.));
+            }
+            THEN("the extrusions of the first spiral layer ramp up to the extrusions of the layer") {
+                const std::vector<float> e_in  = extrusions(layers[first_spiral_layer]);
+                const std::vector<float> e_out = extrusions(out[first_spiral_layer]);
+                REQUIRE(e_in.size() > 1);
+                REQUIRE(e_out.size() == e_in.size());
+                float last_ratio = 0.f;
+                for (size_t i = 0; i < e_in.size(); ++ i) {
+                    float ratio = e_out[i] / e_in[i];
+                    REQUIRE(ratio > 0.f);
+                    REQUIRE(ratio >= last_ratio - 1e-3f);
+                    last_ratio = ratio;
+                }
+                REQUIRE(e_out.front() / e_in.front() < 0.5f);
+                REQUIRE(last_ratio == Approx(1.f).epsilon(1e-3));
+            }
+            THEN("the extrusions of the layers above the first spiral layer are kept") {
+                for (size_t i = first_spiral_layer + 1; i + 1 < out.size(); ++ i)
+                    REQUIRE(extrusions(out[i]) == extrusions(layers[i]));
+            }
+        }
+    }
+}
@@ -351,6 +351,45 @@ SCENARIO( "TriangleMeshSlicer: Cut behavior.") {
         }
     }
 }
+SCENARIO( "TriangleMeshSlicer: Slicing many planes in parallel.") {
+    GIVEN( "A finely tessellated sphere of 10mm radius next to a cylinder") {
+        TriangleMesh mesh = make_sphere(10., PI / 128.);
+        mesh.translate(0.f, 0.f, 10.f);
+        TriangleMesh cylinder = make_cylinder(3., 20.);
+        cylinder.translate(30.f, 0.f, 0.f);
+        mesh.merge(cylinder);
+        std::vector<float> zs;
+        for (float z = 0.1f; z < 20.f; z += 0.2f)
+            zs.emplace_back(z);
+        WHEN( "The mesh is sliced at all the planes at once") {
+            std::vector<Polygons> layers = slice_mesh(mesh.its, zs, MeshSlicingParams{});
+            REQUIRE(layers.size() == zs.size());
+            THEN( "Each layer has a circle of the sphere and a circle of the cylinder") {
+                for (size_t i = 0; i < zs.size(); ++ i) {
+                    REQUIRE(layers[i].size() == 2);
+                    double r2 = sqr(10.) - sqr(double(zs[i]) - 10.);
+                    REQUIRE(unscaled<double>(unscaled<double>(area(layers[i]))) == Approx(PI * (r2 + sqr(3.))).epsilon(0.02));
+                }
+            }
+            THEN( "Each layer matches the slice at the same plane sliced alone on a single thread") {
+                for (size_t i = 0; i < zs.size(); ++ i) {
+                    Polygons reference = slice_mesh(mesh.its, zs[i], MeshSlicingParams{});
+                    REQUIRE(layers[i].size() == reference.size());
+                    REQUIRE(area(layers[i]) == Approx(area(reference)));
+                    auto num_points = [](const Polygons &polygons) {
+                        std::vector<size_t> out;
+                        for (const Polygon &polygon : polygons)
+                            out.emplace_back(polygon.size());
+                        std::sort(out.begin(), out.end());
+                        return out;
+                    };
+                    REQUIRE(num_points(layers[i]) == num_points(reference));
+                }
+            }
+        }
+    }
+}
+
 #ifdef TEST_PERFORMANCE
 TEST_CASE("Regression test for issue #4486 - files take forever to slice") {
     TriangleMesh mesh;
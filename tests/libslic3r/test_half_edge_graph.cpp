@@ -0,0 +1,46 @@
+#include <catch2/catch.hpp>
+
+#include "libslic3r/Arachne/utils/HalfEdgeGraph.hpp"
+
+#include <algorithm>
+#include <list>
+#include <type_traits>
+#include <vector>
+
+using namespace Slic3r;
+using namespace Slic3r::Arachne;
+
+TEST_CASE("HalfEdgeGraphStorage keeps the order and the addresses of std::list", "[HalfEdgeGraph]") {
+    HalfEdgeGraphStorage<int> storage;
+    std::list<int>            list;
+    std::vector<const int*>   addresses;
+    for (int i = 0; i < 1000; ++ i) {
+        if (i % 3 == 0) {
+            addresses.emplace_back(&storage.emplace_front(i));
+            list.emplace_front(i);
+        } else {
+            addresses.emplace_back(&storage.emplace_back(i));
+            list.emplace_back(i);
+        }
+    }
+    // Erase every other element, then refill: the freed slots are reused.
+    for (auto it = storage.begin(); it != storage.end(); it = storage.erase(it))
+        if (++ it == storage.end())
+            break;
+    for (auto it = list.begin(); it != list.end(); it = list.erase(it))
+        if (++ it == list.end())
+            break;
+    for (int i = 1000; i < 1200; ++ i) {
+        storage.emplace_back(i);
+        list.emplace_back(i);
+    }
+    REQUIRE(storage.size() == list.size());
+    REQUIRE(std::equal(list.begin(), list.end(), storage.begin()));
+    // The remaining elements did not move.
+    for (const int &value : storage)
+        if (value < 1000)
+            REQUIRE(addresses[value] == &value);
+    // An iterator converts to a const_iterator, a const_iterator does not convert to an iterator.
+    static_assert(std::is_convertible_v<HalfEdgeGraphStorage<int>::iterator, HalfEdgeGraphStorage<int>::const_iterator>);
+    static_assert(! std::is_convertible_v<HalfEdgeGraphStorage<int>::const_iterator, HalfEdgeGraphStorage<int>::iterator>);
+}
@@ -110,7 +110,7 @@ static float triangle_area(const Vec3f &v0, const Vec3f &v1, const Vec3f &v2)
     return ab.cross(ac).norm() / 2.f;
 }
 
-static float triangle_area(const Vec3crd &triangle_inices, const std::vector<Vec3f> &vertices)
+static float triangle_area(const Vec3i32 &triangle_inices, const std::vector<Vec3f> &vertices)
 {
     return triangle_area(vertices[triangle_inices[0]],
                          vertices[triangle_inices[1]],
@@ -199,7 +199,7 @@ bool is_similar(const indexed_triangle_set &from,
         collect_distances(vertex);
     }
 
-    for (const Vec3i &t : to.indices) {
+    for (const Vec3i32 &t : to.indices) {
         Vec3f center(0,0,0);
         for (size_t i = 0; i < 3; ++i) { 
             center += to.vertices[t[i]] / 3;
@@ -222,8 +222,8 @@ TEST_CASE("Reduce one edge by Quadric Edge Collapse", "[its]")
                     Vec3f(1.f, 0.f, 0.f), Vec3f(0.f, 0.f, 1.f),
                     // vertex to be removed
                     Vec3f(0.9f, .1f, -.1f)};
-    its.indices  = {Vec3i(1, 0, 3), Vec3i(2, 1, 3), Vec3i(0, 2, 3),
-                   Vec3i(0, 1, 4), Vec3i(1, 2, 4), Vec3i(2, 0, 4)};
+    its.indices  = {Vec3i32(1, 0, 3), Vec3i32(2, 1, 3), Vec3i32(0, 2, 3),
+                   Vec3i32(0, 1, 4), Vec3i32(1, 2, 4), Vec3i32(2, 0, 4)};
     // edge to remove is between vertices 2 and 4 on trinagles 4 and 5
 
     indexed_triangle_set its_ = its; // copy
@@ -41,6 +41,35 @@ SCENARIO("Placeholder parser scripting", "[PlaceholderParser]") {
     SECTION("nested config options (legacy syntax)") { REQUIRE(parser.process("[temperature_[foo]]") == "357"); }
     SECTION("array reference") { REQUIRE(parser.process("{temperature[foo]}") == "357"); }
     SECTION("whitespaces and newlines are maintained") { REQUIRE(parser.process("test [ temperature_ [foo] ] \n hu") == "test 357 \n hu"); }
+    SECTION("template split into text, legacy variables and macros") {
+        for (const auto &[templ, expected] : std::initializer_list<std::pair<std::string, std::string>> {
+                { "  M104 S[temperature] ; \\[escaped\\] \\{escaped} \\ backslash\n", "M104 S357 ; [escaped\\] {escaped} \\ backslash\n" },
+                { "{if foo == 0}G1 Z{2*bar}{elsif bar}[temperature]{else}\\{x{endif} ; [nozzle_diameter_1] {temperature[1]}\n", "G1 Z4 ; 0.6 359\n" },
+                { "{if bar > 1}{if foo}a{else}b [temperature]{endif}{endif}{digits(bar, 4)}", "b 357   2" },
+                // Not split: nested legacy variable, string literal and regular expression.
+                { "[temperature_[foo]] {\"string\"} {\"abc\" =~ /a.*/}", "357 string true" } }) {
+            REQUIRE(parser.process(templ) == expected);
+            // Compiled once, filled in twice.
+            REQUIRE(parser.process(*PlaceholderParser::compile(templ)) == expected);
+        }
+    }
+    SECTION("variable references evaluated without the parser") {
+        REQUIRE(parser.process("{ bar }") == "2");
+        REQUIRE(parser.process("{nozzle_diameter[1]}") == "0.6");
+        REQUIRE(parser.process("{temperature[2]}") == "363");
+        REQUIRE(parser.process("{temperature[ bar ]}") == "363");
+        REQUIRE(parser.process("G1 Z{bar} E{temperature[foo]}\n{true}") == "G1 Z2 E357\ntrue");
+        REQUIRE_THROWS(parser.process("{unknown_variable}"));
+        REQUIRE_THROWS(parser.process("{temperature[unknown_variable]}"));
+        REQUIRE_THROWS(parser.process("{bar[0]}"));
+    }
+    SECTION("compiled template reports errors") { REQUIRE_THROWS(parser.process(*PlaceholderParser::compile("G1 [temperature] {2*unknown_variable}"))); }
+    SECTION("compiled template parsed again as a whole draws the random numbers once") {
+        PlaceholderParser::ContextData context_once, context_failed;
+        parser.process("{random(0, 1000000)}", 0, nullptr, &context_once);
+        REQUIRE_THROWS(parser.process("{random(0, 1000000)} {2*unknown_variable}", 0, nullptr, &context_failed));
+        REQUIRE(context_failed.rng == context_once.rng);
+    }
 
     // Test the math expressions.
     SECTION("math: 2*3") { REQUIRE(parser.process("{2*3}") == "6"); }
@@ -1,7 +1,9 @@
 #include <catch2/catch.hpp>
 
+#include "libslic3r/ClipperUtils.hpp"
 #include "libslic3r/Point.hpp"
 #include "libslic3r/Polygon.hpp"
+#include "libslic3r/PolygonSet.hpp"
 
 using namespace Slic3r;
 
@@ -148,3 +150,53 @@ SCENARIO("Remove collinear points from Polygon", "[Polygon]") {
         }
     }
 }
+
+SCENARIO("PolygonSet", "[Polygon]") {
+    GIVEN("Square with a hole and an overlapping square") {
+        ExPolygon square_with_hole({ { 0, 0 }, { 4000, 0 }, { 4000, 4000 }, { 0, 4000 } },
+                                   { { 1000, 1000 }, { 1000, 3000 }, { 3000, 3000 }, { 3000, 1000 } });
+        Polygon   square2{ { 2000, 2000 }, { 6000, 2000 }, { 6000, 6000 }, { 2000, 6000 } };
+        PolygonSet set(ExPolygons{ square_with_hole });
+        WHEN("stored flat") {
+            THEN("polygons and points are kept in order") {
+                REQUIRE(set.size() == 2);
+                REQUIRE(set.num_points() == 8);
+                REQUIRE(set.polygon(0) == square_with_hole.contour);
+                REQUIRE(set.polygon(1) == square_with_hole.holes.front());
+                REQUIRE(set.to_polygons() == to_polygons(square_with_hole));
+                REQUIRE(set.area() == Approx(square_with_hole.area()));
+                REQUIRE(get_extents(set).min == get_extents(square_with_hole).min);
+                REQUIRE(get_extents(set).max == get_extents(square_with_hole).max);
+            }
+            THEN("appending a set to itself duplicates it") {
+                PolygonSet twice(set);
+                twice.append(twice);
+                REQUIRE(twice.size() == 4);
+                REQUIRE(twice.polygon(2) == square_with_hole.contour);
+                REQUIRE(twice.polygon(3) == square_with_hole.holes.front());
+            }
+        }
+        WHEN("clipped") {
+            PolygonSet clip;
+            clip.append(square2);
+            Polygons   polygons = to_polygons(square_with_hole);
+            THEN("the results match the ones of Polygons") {
+                REQUIRE(union_(set, clip).area() == Approx(area(union_(polygons, Polygons{ square2 }))));
+                REQUIRE(diff(set, clip).area() == Approx(area(diff(polygons, Polygons{ square2 }))));
+                REQUIRE(intersection(set, clip).area() == Approx(area(intersection(polygons, Polygons{ square2 }))));
+                REQUIRE(offset(set, 100.).area() == Approx(area(offset(polygons, 100.))));
+                REQUIRE(offset(set, -100.).area() == Approx(area(offset(polygons, -100.))));
+                REQUIRE(intersection_ex(set, ExPolygons{ ExPolygon(square2) }).size() == 1);
+                REQUIRE(union_ex(set).size() == 1);
+                REQUIRE(union_ex(set).front().holes.size() == 1);
+                REQUIRE(diff_ex(set, clip) == diff_ex(polygons, Polygons{ square2 }));
+                REQUIRE(diff_ex(ExPolygons{ square_with_hole }, clip) == diff_ex(ExPolygons{ square_with_hole }, Polygons{ square2 }));
+            }
+            THEN("the flat results hold the same polygons as Polygons") {
+                REQUIRE(union_(set, clip).to_polygons() == union_(polygons, Polygons{ square2 }));
+                REQUIRE(offset(set, 100.).to_polygons() == offset(polygons, 100.));
+                REQUIRE(offset(set, -100.).to_polygons() == offset(polygons, -100.));
+            }
+        }
+    }
+}
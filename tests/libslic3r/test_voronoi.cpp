@@ -5,6 +5,7 @@
 #include <libslic3r/Polyline.hpp>
 #include <libslic3r/EdgeGrid.hpp>
 #include <libslic3r/Geometry.hpp>
+#include "libslic3r/Geometry/VoronoiCache.hpp"
 #include "libslic3r/Geometry/VoronoiUtilsCgal.hpp"
 
 #include <libslic3r/Geometry/VoronoiOffset.hpp>
@@ -23,7 +24,7 @@ using boost::polygon::voronoi_diagram;
 
 using namespace Slic3r;
 
-using VD = Slic3r::VoronoiDiagram;
+using VD = Geometry::VoronoiDiagram;
 
 // https://svn.boost.org/trac10/ticket/12067
 // This bug seems to be confirmed.
@@ -2190,3 +2191,36 @@ TEST_CASE("Non-planar voronoi diagram", "[VoronoiNonPlanar]")
 
 //    REQUIRE(Geometry::VoronoiUtilsCgal::is_voronoi_diagram_planar_intersection(vd));
 }
+
+TEST_CASE("Voronoi diagrams are shared by the cache", "[VoronoiCache]")
+{
+    Geometry::VoronoiCache::clear();
+    Polygon circle;
+    for (size_t i = 0; i < 100; ++ i) {
+        double angle = 2. * M_PI * double(i) / 100.;
+        circle.points.emplace_back(scaled<coord_t>(10. * cos(angle)), scaled<coord_t>(10. * sin(angle)));
+    }
+    Lines lines = circle.lines();
+
+    std::shared_ptr<const Geometry::VoronoiDiagram> vd = Geometry::VoronoiCache::get(lines);
+    Geometry::VoronoiDiagram reference;
+    boost::polygon::construct_voronoi(lines.begin(), lines.end(), &reference);
+    REQUIRE(vd->edges().size() == reference.edges().size());
+    REQUIRE(vd->vertices().size() == reference.vertices().size());
+
+    SECTION("the same lines share the diagram") {
+        REQUIRE(Geometry::VoronoiCache::get(circle.lines()) == vd);
+        REQUIRE(Geometry::VoronoiCache::stats().hits == 1);
+        REQUIRE(Geometry::VoronoiCache::stats().misses == 1);
+    }
+    SECTION("other lines get their own diagram") {
+        circle.translate(1000, 0);
+        REQUIRE(Geometry::VoronoiCache::get(circle.lines()) != vd);
+        REQUIRE(Geometry::VoronoiCache::stats().hits == 0);
+    }
+    SECTION("a diagram stays valid after the cache is cleared") {
+        Geometry::VoronoiCache::clear();
+        REQUIRE(vd->edges().size() == reference.edges().size());
+        REQUIRE(Geometry::VoronoiCache::get(lines) != vd);
+    }
+}